@@ -0,0 +1,505 @@
+//GPU and CPU benchmarks of the app, run in a hidden window with --bench <name>. they live here
+//rather than next to the code they measure so the library headers stay free of benchmark code
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+
+#include "Benchmark.h"
+#include "VectorMath.h"
+#include "VertexPulling.h"
+#include "Scene.h"
+#include "Culling.h"
+#include "Depth.h"
+#include "RenderGraph.h"
+#include "FrameCapture.h"
+#include "MeshPool.h"
+#include "Texture.h"
+
+
+//draws meshCount distinct meshes with one VAO/VBO pair and a transform uniform each against
+//the pulled path, both placing every mesh at the same offset, and prints frame times (CPU
+//submission plus glFinish) for both
+static void benchmarkVertexPulling(int meshCount) {
+	if (!VertexPullingBatch::available()) {
+		std::cout << "BENCHMARK vertex pulling needs GL 4.3" << std::endl;
+		return;
+	}
+	Shader classicShader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+	Shader pullingShader("Shaders/vertexPulling.vs", "Shaders/fragmentShader.fs");
+
+	srand(1);
+	std::vector<unsigned int> vaos(meshCount), vbos(meshCount);
+	std::vector<int> counts(meshCount);
+	//the classic path gets the same per object offset as a per draw transform
+	std::vector<Mat4> transforms(meshCount);
+	VertexPullingBatch batch;
+	glGenVertexArrays(meshCount, vaos.data());
+	glGenBuffers(meshCount, vbos.data());
+	for (int i = 0; i < meshCount; i++) {
+		std::vector<float> mesh = makeRandomMesh();
+		counts[i] = (int)mesh.size() / 6;
+		glBindVertexArray(vaos[i]);
+		glBindBuffer(GL_ARRAY_BUFFER, vbos[i]);
+		glBufferData(GL_ARRAY_BUFFER, mesh.size() * sizeof(float), mesh.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+
+		uint32_t pulledMesh = batch.addMesh(mesh.data(), counts[i]);
+		float x = (rand() % 100) / 50.0f - 1.0f;
+		float y = (rand() % 100) / 50.0f - 1.0f;
+		batch.addObject(pulledMesh, x, y, 0.0f);
+		transforms[i] = Mat4::translation(Vec3(x, y, 0.0f));
+	}
+	glBindVertexArray(0);
+
+	std::string suffix = " (" + std::to_string(meshCount) + " meshes)";
+	runBenchmark("classic attributes" + suffix, 5, 30, [&]() {
+		glClear(GL_COLOR_BUFFER_BIT);
+		classicShader.use();
+		for (int i = 0; i < meshCount; i++) {
+			classicShader.setMat4("transform", transforms[i]);
+			glBindVertexArray(vaos[i]);
+			glDrawArrays(GL_TRIANGLES, 0, counts[i]);
+		}
+		glFinish();
+	}, meshCount).report();
+	runBenchmark("vertex pulling" + suffix, 5, 30, [&]() {
+		glClear(GL_COLOR_BUFFER_BIT);
+		batch.draw(pullingShader);
+		glFinish();
+	}, meshCount).report();
+
+	glDeleteVertexArrays(meshCount, vaos.data());
+	glDeleteBuffers(meshCount, vbos.data());
+}
+
+//the same random meshes drawn from a VAO/VBO pair each against one MeshPool, then a churn of
+//removals and re-adds that splinters the pool, measured before and after defragment
+static void benchmarkMeshPool(int meshCount) {
+	Shader shader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+	VertexFormat format(6 * sizeof(float));
+	format.add(0, 3, GL_FLOAT, 0);
+	format.add(1, 3, GL_FLOAT, 3 * sizeof(float));
+
+	srand(3);
+	std::vector<std::vector<float>> meshes(meshCount);
+	std::vector<unsigned int> vaos(meshCount), vbos(meshCount);
+	MeshPool pool(format, 1 << 16, 0);
+	std::vector<MeshHandle> handles(meshCount);
+	glGenVertexArrays(meshCount, vaos.data());
+	glGenBuffers(meshCount, vbos.data());
+	for (int i = 0; i < meshCount; i++) {
+		meshes[i] = makeRandomMesh();
+		uint32_t vertexCount = (uint32_t)meshes[i].size() / 6;
+		glBindVertexArray(vaos[i]);
+		glBindBuffer(GL_ARRAY_BUFFER, vbos[i]);
+		glBufferData(GL_ARRAY_BUFFER, meshes[i].size() * sizeof(float), meshes[i].data(), GL_STATIC_DRAW);
+		for (const VertexFormat::Attribute& a : format.attributes) {
+			glVertexAttribPointer(a.index, a.size, a.type, a.normalized, format.stride, (void*)(size_t)a.offset);
+			glEnableVertexAttribArray(a.index);
+		}
+		handles[i] = pool.add(meshes[i].data(), vertexCount);
+	}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	std::string suffix = " (" + std::to_string(meshCount) + " meshes)";
+	Mat4 transform;
+	runBenchmark("mesh per VAO" + suffix, 5, 30, [&]() {
+		glClear(GL_COLOR_BUFFER_BIT);
+		shader.use();
+		shader.setMat4("transform", transform);
+		for (int i = 0; i < meshCount; i++) {
+			glBindVertexArray(vaos[i]);
+			glDrawArrays(GL_TRIANGLES, 0, (GLsizei)meshes[i].size() / 6);
+		}
+		glFinish();
+	}, meshCount).report();
+	auto drawPool = [&]() {
+		glClear(GL_COLOR_BUFFER_BIT);
+		shader.use();
+		shader.setMat4("transform", transform);
+		pool.resetStats();
+		pool.bind();
+		for (int i = 0; i < meshCount; i++) {
+			if (handles[i].valid()) pool.draw(handles[i]);
+		}
+		glFinish();
+	};
+	runBenchmark("mesh pool" + suffix, 5, 30, drawPool, meshCount).report();
+	pool.report();
+
+	//every third mesh leaves and comes back a different size, so holes no longer fit exactly
+	for (int i = 0; i < meshCount; i += 3) pool.remove(handles[i]);
+	for (int i = 0; i < meshCount; i += 3) {
+		meshes[i] = makeRandomMesh();
+		handles[i] = pool.add(meshes[i].data(), (uint32_t)meshes[i].size() / 6);
+	}
+	runBenchmark("mesh pool churned" + suffix, 5, 30, drawPool, meshCount).report();
+	pool.report();
+	auto start = std::chrono::high_resolution_clock::now();
+	pool.defragment();
+	glFinish();
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	std::cout << "BENCHMARK mesh pool defragment" << suffix << ": " << ms << " ms" << std::endl;
+	runBenchmark("mesh pool defragmented" + suffix, 5, 30, drawPool, meshCount).report();
+	pool.report();
+
+	glDeleteVertexArrays(meshCount, vaos.data());
+	glDeleteBuffers(meshCount, vbos.data());
+}
+
+//SIMD kernels against the scalar reference on the same data
+static void benchmarkVectorMath(size_t count) {
+	std::vector<float> xs(count), ys(count), zs(count), ox(count), oy(count), oz(count);
+	for (size_t i = 0; i < count; i++) {
+		xs[i] = (float)(rand() % 1000);
+		ys[i] = (float)(rand() % 1000);
+		zs[i] = (float)(rand() % 1000);
+	}
+	Mat4 mat = Mat4::trs(Vec3(1, 2, 3), Quat::fromAxisAngle(Vec3(0, 1, 0), 0.5f), Vec3(2, 2, 2));
+	std::string n = " (" + std::to_string(count) + ")";
+
+	runBenchmark("transformMany scalar" + n, 3, 20, [&]() {
+		transformManyScalar(mat, xs.data(), ys.data(), zs.data(), ox.data(), oy.data(), oz.data(), count);
+		doNotOptimize(ox[count - 1]);
+	}, (double)count).report();
+	runBenchmark("transformMany SIMD" + n, 3, 20, [&]() {
+		transformMany(mat, xs.data(), ys.data(), zs.data(), ox.data(), oy.data(), oz.data(), count);
+		doNotOptimize(ox[count - 1]);
+	}, (double)count).report();
+
+	std::vector<Mat4> models(count / 4, mat), out(count / 4);
+	Mat4 viewProjection = Mat4::perspective(0.8f, 4.0f / 3.0f, 0.1f, 100.0f) * Mat4::lookAt(Vec3(0, 0, 5), Vec3(), Vec3(0, 1, 0));
+	runBenchmark("Mat4 multiply scalar" + n, 3, 20, [&]() {
+		for (size_t i = 0; i < models.size(); i++) out[i] = multiplyScalar(viewProjection, models[i]);
+		doNotOptimize(out.back());
+	}, (double)models.size()).report();
+	runBenchmark("Mat4 multiply SIMD" + n, 3, 20, [&]() {
+		multiplyMany(viewProjection, models.data(), out.data(), models.size());
+		doNotOptimize(out.back());
+	}, (double)models.size()).report();
+}
+
+
+//full and partial world updates of deep (long chains) and wide (one parent, many children) trees
+static void benchmarkScene(int nodeCount) {
+	std::string n = " (" + std::to_string(nodeCount) + " nodes)";
+	Quat spin = Quat::fromAxisAngle(Vec3(0, 1, 0), 0.01f);
+
+	for (int shape = 0; shape < 2; shape++) {
+		bool deep = shape == 0;
+		Scene scene;
+		scene.reserve(nodeCount);
+		scene.addNode(Scene::NO_PARENT);
+		for (int i = 1; i < nodeCount; i++) {
+			//deep: chains of 1000 nodes hanging off the root, wide: everything under the root
+			int32_t parent = deep && i % 1000 != 1 ? i - 1 : 0;
+			scene.addNode(parent, Vec3(0.01f, 0.0f, 0.0f), spin);
+		}
+		scene.updateWorld();
+
+		const char* name = deep ? "scene deep" : "scene wide";
+		runBenchmark(std::string(name) + " full update" + n, 2, 10, [&]() {
+			scene.setLocal(0, Vec3(), spin, Vec3(1, 1, 1));
+			scene.updateWorld();
+		}, nodeCount).report();
+
+		//one percent of leaves move, their subtrees are all that gets recomputed
+		srand(7);
+		std::vector<int32_t> moving;
+		for (int i = 0; i < nodeCount / 100; i++) moving.push_back(1 + rand() % (nodeCount - 1));
+		runBenchmark(std::string(name) + " 1% dirty" + n, 2, 10, [&]() {
+			for (int32_t node : moving) scene.setPosition(node, Vec3(0.02f, 0.0f, 0.0f));
+			scene.updateWorld();
+		}, nodeCount).report();
+	}
+}
+
+//random spheres in a 200 unit cube seen by a 60 degree camera at the origin
+static void benchmarkCulling(size_t count) {
+	std::vector<float> xs(count), ys(count), zs(count), radii(count);
+	srand(3);
+	for (size_t i = 0; i < count; i++) {
+		xs[i] = (rand() % 20000) / 100.0f - 100.0f;
+		ys[i] = (rand() % 20000) / 100.0f - 100.0f;
+		zs[i] = (rand() % 20000) / 100.0f - 100.0f;
+		radii[i] = 0.5f + (rand() % 100) / 100.0f;
+	}
+	Mat4 viewProjection = Mat4::perspective(1.047f, 16.0f / 9.0f, 0.1f, 150.0f)
+		* Mat4::lookAt(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0));
+	Frustum frustum = Frustum::fromMatrix(viewProjection);
+	std::string n = " (" + std::to_string(count) + " spheres)";
+
+	std::vector<uint32_t> visible;
+	visible.reserve(count);
+	runBenchmark("cull scalar" + n, 2, 10, [&]() {
+		visible.clear();
+		cullSpheresScalar(frustum, xs.data(), ys.data(), zs.data(), radii.data(), 0, count, visible);
+	}, (double)count).report();
+	runBenchmark("cull SIMD" + n, 2, 10, [&]() {
+		visible.clear();
+		cullSpheres(frustum, xs.data(), ys.data(), zs.data(), radii.data(), 0, count, visible);
+	}, (double)count).report();
+
+	FrustumCuller culler;
+	runBenchmark("cull SIMD " + std::to_string(culler.threadCount()) + " threads" + n, 2, 10, [&]() {
+		culler.cull(frustum, xs.data(), ys.data(), zs.data(), radii.data(), count);
+	}, (double)count).report();
+	culler.stats.report("last run");
+}
+
+//a stack of overlapping quads drawn back to front, front to back, and front to back after a
+//depth pre-pass, with standard and reversed-Z depth. prints frame time and overdraw for each
+static void benchmarkDepth(int quadCount) {
+	const int width = 1280, height = 720;
+	Shader colorShader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+	Shader overdrawShader("Shaders/vertexShader.vs", "Shaders/overdraw.fs");
+	Framebuffer target(width, height);
+
+	float quad[] = {
+		-1.0f, -1.0f, 0.0f,  1.0f, 0.5f, 0.2f,
+		 1.0f, -1.0f, 0.0f,  0.2f, 1.0f, 0.5f,
+		 1.0f,  1.0f, 0.0f,  0.5f, 0.2f, 1.0f,
+		-1.0f, -1.0f, 0.0f,  1.0f, 0.5f, 0.2f,
+		 1.0f,  1.0f, 0.0f,  0.5f, 0.2f, 1.0f,
+		-1.0f,  1.0f, 0.0f,  0.2f, 0.5f, 1.0f
+	};
+	unsigned int VAO, VBO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+
+	//back to front is the worst case for early-Z, every quad passes the depth test
+	srand(5);
+	OpaqueQueue backToFront;
+	for (int i = 0; i < quadCount; i++) {
+		float z = -40.0f + 35.0f * i / quadCount;
+		Vec3 position((rand() % 1200) / 100.0f - 6.0f, (rand() % 800) / 100.0f - 4.0f, z);
+		float size = 2.0f + (rand() % 400) / 100.0f;
+		backToFront.add(VAO, 0, 6, Mat4::translation(position) * Mat4::scale(Vec3(size, size, 1.0f)));
+	}
+	Mat4 view = Mat4::lookAt(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0));
+
+	std::string n = " (" + std::to_string(quadCount) + " quads)";
+	for (int reversed = 0; reversed < 2; reversed++) {
+		if (reversed && !DepthSettings::reversedZAvailable()) {
+			std::cout << "BENCHMARK reversed-Z needs glClipControl, skipped" << std::endl;
+			break;
+		}
+		for (int mode = 0; mode < 3; mode++) {
+			DepthSettings settings;
+			settings.reversedZ = reversed != 0;
+			settings.sortFrontToBack = mode > 0;
+			settings.prePass = mode == 2;
+			Mat4 projection = settings.projection(1.047f, (float)width / height, 0.1f, 100.0f);
+			std::string name = std::string(reversed ? "reversed-Z " : "standard-Z ")
+				+ (mode == 0 ? "back to front" : mode == 1 ? "front to back" : "pre-pass");
+
+			OpaqueQueue queue = backToFront;
+			runBenchmark(name + n, 3, 20, [&]() {
+				target.bind();
+				renderOpaque(queue, colorShader, view, projection, settings);
+				glFinish();
+			}, quadCount).report();
+			captureOverdraw(target, queue, overdrawShader, view, projection, settings).report(name.c_str());
+		}
+	}
+	//leave the default state for whoever renders next
+	DepthSettings().apply();
+	Framebuffer::unbind();
+
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+}
+
+//a bloom style post chain with a fixed size shadow map and an unused debug pass. passes
+//only clear their targets, what is measured is the graph: culling, memory with and without
+//aliasing, per frame overhead and which resources a resize touches
+static void benchmarkRenderGraph() {
+	RenderGraph graph(1920, 1080);
+	auto clearTo = [](float r, float g, float b) {
+		return [=](const RenderGraph::PassContext&) {
+			glClearColor(r, g, b, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		};
+	};
+	typedef RenderTextureDesc Desc;
+	RenderGraph::Resource shadowMap = graph.createTexture("shadowMap", Desc::fixed(GL_DEPTH_COMPONENT32F, 2048, 2048));
+	RenderGraph::Resource sceneColor = graph.createTexture("sceneColor", Desc::windowRelative(GL_RGBA16F));
+	RenderGraph::Resource sceneDepth = graph.createTexture("sceneDepth", Desc::windowRelative(GL_DEPTH_COMPONENT32F));
+	RenderGraph::Resource bright = graph.createTexture("bright", Desc::windowRelative(GL_RGBA16F, 0.5f));
+	RenderGraph::Resource blurX = graph.createTexture("blurX", Desc::windowRelative(GL_RGBA16F, 0.5f));
+	RenderGraph::Resource blurY = graph.createTexture("blurY", Desc::windowRelative(GL_RGBA16F, 0.5f));
+	RenderGraph::Resource composite = graph.createTexture("composite", Desc::windowRelative(GL_RGBA8));
+	RenderGraph::Resource depthView = graph.createTexture("depthView", Desc::windowRelative(GL_RGBA8));
+	RenderGraph::Resource window = graph.importTexture("window");
+
+	graph.addPass("shadows", {}, { shadowMap }, clearTo(0, 0, 0));
+	graph.addPass("scene", { shadowMap }, { sceneColor, sceneDepth }, clearTo(0.2f, 0.3f, 0.3f));
+	//nothing reads depthView, so this pass is culled
+	graph.addPass("depth debug", { sceneDepth }, { depthView }, clearTo(1, 1, 1));
+	graph.addPass("bright", { sceneColor }, { bright }, clearTo(0.5f, 0.5f, 0.5f));
+	graph.addPass("blur x", { bright }, { blurX }, clearTo(0.4f, 0.4f, 0.4f));
+	graph.addPass("blur y", { blurX }, { blurY }, clearTo(0.3f, 0.3f, 0.3f));
+	graph.addPass("composite", { sceneColor, blurY }, { composite }, clearTo(0.6f, 0.2f, 0.2f));
+	graph.addPass("present", { composite }, { window }, [](const RenderGraph::PassContext& context) {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, context.width, context.height);
+		glClear(GL_COLOR_BUFFER_BIT);
+	});
+
+	graph.compile();
+	graph.report();
+	GpuMemory::report();
+	runBenchmark("render graph execute (7 passes, 1 culled)", 5, 50, [&]() {
+		graph.execute();
+		glFinish();
+	}).report();
+
+	//the shadow map is fixed size and survives, everything window relative is rebuilt
+	graph.resize(1280, 720);
+	graph.report();
+	graph.execute();
+	glFinish();
+}
+
+//frames per second of rendering alone, and of rendering plus capture with each format, at
+//1080p and 4K. encoded frames are discarded so disk speed does not decide the result
+static void benchmarkCapture(int frames) {
+	const int sizes[2][2] = { { 1920, 1080 }, { 3840, 2160 } };
+	for (const int* size : sizes) {
+		Framebuffer target(size[0], size[1]);
+		std::string label = std::to_string(size[0]) + "x" + std::to_string(size[1]);
+		auto renderFrame = [&](int i) {
+			target.bind();
+			glClearColor((i % 60) / 60.0f, 0.3f, 0.6f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+		};
+
+		//no loop waits per frame, each ends with one glFinish so all of them time the same
+		//pipelined work plus a final drain
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < frames; i++) {
+			renderFrame(i);
+		}
+		glFinish();
+		double baseMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		std::cout << "CAPTURE " << label << " no capture: " << frames * 1000.0 / baseMs << " fps" << std::endl;
+
+		for (int f = 0; f < 2; f++) {
+			CaptureFormat format = f == 0 ? CaptureFormat::PNG_SEQUENCE : CaptureFormat::Y4M;
+			std::string name = label + (f == 0 ? " png" : " y4m");
+			//buffer allocation and the writer thread start are setup, not per frame cost
+			FrameCapture capture(size[0], size[1], format, "");
+			start = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < frames; i++) {
+				renderFrame(i);
+				capture.capture(target.ID);
+			}
+			capture.finish();
+			glFinish();
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			capture.report(name);
+			std::cout << "CAPTURE " << name << ": " << frames * 1000.0 / ms << " fps captured, "
+				<< (double)size[0] * size[1] * 4 * frames / (ms * 1000.0) << " MB/s" << std::endl;
+		}
+	}
+	Framebuffer::unbind();
+}
+
+//one size x size RGBA8 image: the scalar and SSE2 downsample of one level, the whole CPU mip
+//chain, uploads straight through the driver against through the PBO ring (the submission
+//alone, the GPU is idle before every call), and a full chain built on the CPU against
+//glGenerateMipmap, both through the ring and waited for
+static void benchmarkTexture(int size) {
+	srand(5);
+	std::vector<uint8_t> image((size_t)size * size * 4);
+	for (uint8_t& p : image) p = (uint8_t)(rand() & 0xff);
+	int half = std::max(1, size / 2);
+	std::vector<uint8_t> level((size_t)half * half * 4);
+	double pixels = (double)half * half;
+
+	std::string suffix = " (" + std::to_string(size) + "x" + std::to_string(size) + ")";
+	runBenchmark("downsample scalar" + suffix, 3, 20, [&]() {
+		downsampleRGBA8Scalar(image.data(), size, size, level.data(), half, half);
+	}, pixels).report();
+	runBenchmark("downsample sse2" + suffix, 3, 20, [&]() {
+		downsampleRGBA8(image.data(), size, size, level.data(), half, half);
+	}, pixels).report();
+	runBenchmark("mip chain cpu" + suffix, 3, 20, [&]() {
+		generateMipChainRGBA8(image.data(), size, size);
+	}).report();
+
+	Texture2D texture(size, size, 0, GL_RGBA8, "benchmark");
+	TextureUploader uploader(image.size(), 3);
+	auto idle = []() { glFinish(); };
+	runBenchmarkWithSetup("upload direct" + suffix, 3, 20, idle, [&]() {
+		texture.upload(0, image.data());
+	}).report();
+	runBenchmarkWithSetup("upload pbo" + suffix, 3, 20, idle, [&]() {
+		uploader.upload(texture, 0, image.data());
+	}).report();
+	runBenchmark("upload with cpu mips" + suffix, 3, 20, [&]() {
+		uploader.uploadWithMips(texture, image.data(), true);
+		glFinish();
+	}).report();
+	runBenchmark("upload with glGenerateMipmap" + suffix, 3, 20, [&]() {
+		uploader.uploadWithMips(texture, image.data(), false);
+		glFinish();
+	}).report();
+	uploader.report();
+}
+
+
+//benchmarks selectable with --bench
+void runNamedBenchmark(const char* name) {
+	if (strcmp(name, "vertex-pulling") == 0) {
+		benchmarkVertexPulling(1000);
+		benchmarkVertexPulling(10000);
+		benchmarkVertexPulling(100000);
+	}
+	else if (strcmp(name, "mesh-pool") == 0) {
+		benchmarkMeshPool(1000);
+		benchmarkMeshPool(10000);
+	}
+	else if (strcmp(name, "texture") == 0) {
+		benchmarkTexture(512);
+		benchmarkTexture(2048);
+	}
+	else if (strcmp(name, "math") == 0) {
+		benchmarkVectorMath(1 << 20);
+	}
+	else if (strcmp(name, "scene") == 0) {
+		benchmarkScene(1000000);
+	}
+	else if (strcmp(name, "culling") == 0) {
+		benchmarkCulling(1 << 20);
+	}
+	else if (strcmp(name, "depth") == 0) {
+		benchmarkDepth(2000);
+	}
+	else if (strcmp(name, "render-graph") == 0) {
+		benchmarkRenderGraph();
+	}
+	else if (strcmp(name, "capture") == 0) {
+		benchmarkCapture(60);
+	}
+	else {
+		std::cout << "Unknown benchmark " << name << std::endl;
+	}
+}
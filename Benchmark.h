@@ -0,0 +1,159 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <map>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <iostream>
+
+
+//timing summary of one benchmark, all times in milliseconds per repetition
+struct BenchmarkResult {
+	std::string name;
+	int repetitions = 0;
+	double minMs = 0.0;
+	double medianMs = 0.0;
+	double meanMs = 0.0;
+	double maxMs = 0.0;
+	double stddevMs = 0.0;
+	//work items per repetition, lets report() print a throughput
+	double itemsPerRep = 0.0;
+	//extra per repetition figures such as GL calls, printed and written with the timings
+	std::vector<std::pair<std::string, double>> counters;
+
+	void report() const {
+		std::cout << "BENCHMARK " << name << ": median " << medianMs << " ms, min " << minMs
+			<< " ms, mean " << meanMs << " ms, max " << maxMs << " ms, stddev " << stddevMs << " ms ("
+			<< repetitions << " reps)";
+		if (itemsPerRep > 0.0 && medianMs > 0.0) {
+			std::cout << ", " << itemsPerRep / medianMs << " items/ms";
+		}
+		for (const auto& counter : counters) {
+			std::cout << ", " << counter.second << " " << counter.first;
+		}
+		std::cout << std::endl;
+	}
+};
+
+//runs fn warmup times untimed, then times each of repetitions calls separately. setup runs
+//untimed before every call, for state each call has to start from such as a cold file cache
+template<typename S, typename F>
+BenchmarkResult runBenchmarkWithSetup(const std::string& name, int warmup, int repetitions, S&& setup, F&& fn,
+	double itemsPerRep = 0.0) {
+	for (int i = 0; i < warmup; i++) {
+		setup();
+		fn();
+	}
+
+	std::vector<double> times;
+	times.reserve(repetitions);
+	for (int i = 0; i < repetitions; i++) {
+		setup();
+		auto start = std::chrono::high_resolution_clock::now();
+		fn();
+		auto end = std::chrono::high_resolution_clock::now();
+		times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+	}
+
+	BenchmarkResult result;
+	result.name = name;
+	result.repetitions = repetitions;
+	result.itemsPerRep = itemsPerRep;
+	if (times.empty()) return result;
+	std::sort(times.begin(), times.end());
+	result.minMs = times.front();
+	result.maxMs = times.back();
+	result.medianMs = times[times.size() / 2];
+	double sum = 0.0;
+	for (double t : times) sum += t;
+	result.meanMs = sum / times.size();
+	double squares = 0.0;
+	for (double t : times) squares += (t - result.meanMs) * (t - result.meanMs);
+	result.stddevMs = std::sqrt(squares / times.size());
+	return result;
+}
+
+template<typename F>
+BenchmarkResult runBenchmark(const std::string& name, int warmup, int repetitions, F&& fn, double itemsPerRep = 0.0) {
+	return runBenchmarkWithSetup(name, warmup, repetitions, []() {}, fn, itemsPerRep);
+}
+
+//one result per line so a baseline can be read back without a JSON library and two runs diff
+//line by line. names must not contain quotes
+inline bool writeBenchmarkJson(const std::string& path, const std::vector<BenchmarkResult>& results) {
+	std::ofstream out(path);
+	if (!out) {
+		std::cout << "ERROR::BENCHMARK::CANNOT_WRITE " << path << std::endl;
+		return false;
+	}
+	out.precision(9);
+	out << "{\n\"benchmarks\": [\n";
+	for (size_t i = 0; i < results.size(); i++) {
+		const BenchmarkResult& r = results[i];
+		out << "{\"name\": \"" << r.name << "\", \"repetitions\": " << r.repetitions << ", \"minMs\": " << r.minMs
+			<< ", \"medianMs\": " << r.medianMs << ", \"meanMs\": " << r.meanMs << ", \"maxMs\": " << r.maxMs
+			<< ", \"stddevMs\": " << r.stddevMs << ", \"itemsPerRep\": " << r.itemsPerRep;
+		for (const auto& counter : r.counters) out << ", \"" << counter.first << "\": " << counter.second;
+		out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "]\n}\n";
+	return true;
+}
+
+//median per benchmark name from a file writeBenchmarkJson produced
+inline std::map<std::string, double> readBenchmarkBaseline(const std::string& path) {
+	std::map<std::string, double> medians;
+	std::ifstream in(path);
+	if (!in) {
+		std::cout << "ERROR::BENCHMARK::CANNOT_READ " << path << std::endl;
+		return medians;
+	}
+	std::string line;
+	while (std::getline(in, line)) {
+		size_t name = line.find("\"name\": \"");
+		size_t median = line.find("\"medianMs\": ");
+		if (name == std::string::npos || median == std::string::npos) continue;
+		name += 9;
+		size_t nameEnd = line.find('"', name);
+		if (nameEnd == std::string::npos) continue;
+		std::istringstream value(line.substr(median + 12));
+		double ms = 0.0;
+		if (value >> ms) medians[line.substr(name, nameEnd - name)] = ms;
+	}
+	return medians;
+}
+
+//prints each result against its baseline median and returns how many got slower by more than
+//tolerance (0.1 is 10 percent). medians of runs on the same machine are what compare reliably
+inline int compareWithBaseline(const std::vector<BenchmarkResult>& results, const std::map<std::string, double>& baseline,
+	double tolerance) {
+	int regressions = 0;
+	for (const BenchmarkResult& r : results) {
+		auto found = baseline.find(r.name);
+		if (found == baseline.end() || found->second <= 0.0) {
+			std::cout << "BASELINE " << r.name << ": new" << std::endl;
+			continue;
+		}
+		double change = r.medianMs / found->second - 1.0;
+		bool regressed = change > tolerance;
+		if (regressed) regressions++;
+		std::cout << "BASELINE " << r.name << ": " << found->second << " ms -> " << r.medianMs << " ms ("
+			<< (change >= 0.0 ? "+" : "") << change * 100.0 << "%)" << (regressed ? " REGRESSION" : "") << std::endl;
+	}
+	return regressions;
+}
+
+//keeps the optimiser from deleting work whose result is otherwise unused
+template<typename T>
+inline void doNotOptimize(const T& value) {
+	static volatile const void* sink;
+	sink = &value;
+	(void)sink;
+}
+
+#endif
@@ -0,0 +1,282 @@
+//CPU microbenchmarks for the engine's hot paths. GL is the null backend from NullGL.h, so the
+//numbers are our own cost per call without a driver behind it, and they only change when our
+//code does. run from the project directory so the shader file reads find Shaders/, then compare with
+//	FirstGLFWBenchmarks --json new.json --baseline old.json
+//this translation unit provides the counting operator new, see FrameAllocator.h
+#define FRAME_ALLOCATOR_COUNT_HEAP
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "NullGL.h"
+#include "Benchmark.h"
+#include "Shader.h"
+#include "VectorMath.h"
+#include "VertexPulling.h"
+#include "Depth.h"
+#include "Scene.h"
+#include "Culling.h"
+#include "FrameAllocator.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+struct BenchmarkOptions {
+	int warmup = 5;
+	int repetitions = 50;
+	std::string filter;
+	std::string jsonPath;
+	std::string baselinePath;
+	double tolerance = 0.10;
+};
+
+//runs one benchmark unless the filter skips it, and records the GL calls and heap allocations it
+//made per repetition
+class BenchmarkRunner {
+public:
+	std::vector<BenchmarkResult> results;
+
+	explicit BenchmarkRunner(const BenchmarkOptions& options) : options(options) {}
+
+	template<typename F>
+	void run(const std::string& name, F&& fn, double itemsPerRep = 0.0) {
+		runWithSetup(name, []() {}, fn, itemsPerRep);
+	}
+
+	//setup is neither timed nor counted
+	template<typename S, typename F>
+	void runWithSetup(const std::string& name, S&& setup, F&& fn, double itemsPerRep = 0.0) {
+		if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+		NullGL::resetCounts();
+		uint64_t heapBefore = HeapCounter::allocations.load();
+		BenchmarkResult result = runBenchmarkWithSetup(name, options.warmup, options.repetitions, setup, fn, itemsPerRep);
+		int reps = options.warmup + options.repetitions;
+		result.counters.push_back({ "glCalls", (double)NullGL::totalCalls() / reps });
+		result.counters.push_back({ "heapAllocs", (double)(HeapCounter::allocations.load() - heapBefore) / reps });
+		result.report();
+		results.push_back(result);
+	}
+
+private:
+	BenchmarkOptions options;
+};
+
+
+//drops a file's pages from the OS file cache so the next read goes to the disk, false where
+//that is not possible without privileges
+static bool evictFromFileCache(const char* path) {
+#ifdef _WIN32
+	//opening without buffering discards the cached pages of a file nobody else has open
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	CloseHandle(file);
+	return true;
+#elif defined(__linux__)
+	int file = open(path, O_RDONLY);
+	if (file < 0) return false;
+	bool evicted = posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+	close(file);
+	return evicted;
+#else
+	(void)path;
+	return false;
+#endif
+}
+
+//startup cost of getting the window's two shader sources, read from disk against compiled in
+static void benchmarkShaderSources(BenchmarkRunner& runner) {
+	const char* paths[] = { "Shaders/vertexShader.vs", "Shaders/fragmentShader.fs" };
+	auto readFiles = [&]() {
+		for (const char* path : paths) doNotOptimize(ShaderSources::readFile(path).size());
+	};
+	if (evictFromFileCache(paths[0])) {
+		runner.runWithSetup("shader sources file cold cache", [&]() {
+			for (const char* path : paths) evictFromFileCache(path);
+		}, readFiles);
+	}
+	else {
+		std::cout << "BENCHMARK cold file cache not available here, skipped" << std::endl;
+	}
+	runner.run("shader sources file warm cache", readFiles);
+	runner.run("shader sources embedded", [&]() {
+		for (const char* path : paths) {
+			std::string code = ShaderSources::embedded(path);
+			doNotOptimize(code.size());
+		}
+	});
+}
+
+static void benchmarkShaders(BenchmarkRunner& runner) {
+	//sources come from the embedded copies, so this is the compile and link calls alone. reading
+	//the files is measured by benchmarkShaderSources
+	runner.run("shader build vertex+fragment", []() {
+		Shader shader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+		doNotOptimize(shader.ID);
+	});
+	runner.run("shader build compute", []() {
+		Shader shader("Shaders/cullInstances.cs");
+		doNotOptimize(shader.ID);
+	});
+
+	//each setter looks the location up by name every call
+	const int uniforms = 10000;
+	Shader shader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+	Mat4 transform = Mat4::translation(Vec3(1.0f, 2.0f, 3.0f));
+	runner.run("uniform setMat4", [&]() {
+		for (int i = 0; i < uniforms; i++) shader.setMat4("transform", transform);
+	}, uniforms);
+	runner.run("uniform setVec3", [&]() {
+		for (int i = 0; i < uniforms; i++) shader.setVec3("offset", 1.0f, 2.0f, 3.0f);
+	}, uniforms);
+	runner.run("uniform setFloat", [&]() {
+		for (int i = 0; i < uniforms; i++) shader.setFloat("time", (float)i);
+	}, uniforms);
+}
+
+static void benchmarkVertexPacking(BenchmarkRunner& runner) {
+	const int meshCount = 1000;
+	const int objectCount = 10000;
+	srand(11);
+	std::vector<std::vector<float>> meshes;
+	for (int i = 0; i < meshCount; i++) meshes.push_back(makeRandomMesh());
+
+	//converts the interleaved position/color layout into PulledVertex
+	runner.run("vertex pack meshes", [&]() {
+		VertexPullingBatch batch;
+		for (const std::vector<float>& mesh : meshes) batch.addMesh(mesh.data(), (uint32_t)(mesh.size() / 6));
+		doNotOptimize(batch);
+	}, meshCount);
+
+	//expands objects into the triangle stream and uploads it on the next draw
+	VertexPullingBatch batch;
+	for (const std::vector<float>& mesh : meshes) batch.addMesh(mesh.data(), (uint32_t)(mesh.size() / 6));
+	Shader shader("Shaders/vertexPulling.vs", "Shaders/fragmentShader.fs");
+	runner.run("vertex pull batch objects", [&]() {
+		batch.clearObjects();
+		for (int i = 0; i < objectCount; i++) batch.addObject(i % meshCount, (float)(i % 100), (float)(i / 100), 0.0f);
+		batch.draw(shader);
+	}, objectCount);
+}
+
+static void benchmarkOpaqueQueue(BenchmarkRunner& runner) {
+	const int drawCount = 10000;
+	const unsigned int vaoCount = 16;
+	srand(13);
+	OpaqueQueue unsorted;
+	for (int i = 0; i < drawCount; i++) {
+		Vec3 position((rand() % 2000) / 10.0f - 100.0f, (rand() % 2000) / 10.0f - 100.0f, -(rand() % 2000) / 10.0f);
+		unsorted.add(1 + rand() % vaoCount, 0, 6, Mat4::translation(position));
+	}
+	Mat4 view = Mat4::lookAt(Vec3(0, 0, 10), Vec3(0, 0, 0), Vec3(0, 1, 0));
+	Mat4 viewProjection = Mat4::perspective(1.047f, 16.0f / 9.0f, 0.1f, 500.0f) * view;
+
+	OpaqueQueue queue;
+	runner.run("opaque sort front to back", [&]() {
+		queue = unsorted;
+		queue.sortFrontToBack(view);
+	}, drawCount);
+
+	//sorted by distance the VAO changes almost every draw, unsorted by VAO it rarely does
+	Shader shader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+	runner.run("opaque submit distance sorted", [&]() {
+		queue.submit(shader, viewProjection);
+	}, drawCount);
+	OpaqueQueue grouped = unsorted;
+	std::sort(grouped.draws.begin(), grouped.draws.end(),
+		[](const OpaqueDraw& a, const OpaqueDraw& b) { return a.VAO < b.VAO; });
+	runner.run("opaque submit grouped by VAO", [&]() {
+		grouped.submit(shader, viewProjection);
+	}, drawCount);
+}
+
+static void benchmarkCullingAndScene(BenchmarkRunner& runner) {
+	const size_t count = 100000;
+	std::vector<float> xs(count), ys(count), zs(count), radii(count);
+	srand(3);
+	for (size_t i = 0; i < count; i++) {
+		xs[i] = (rand() % 20000) / 100.0f - 100.0f;
+		ys[i] = (rand() % 20000) / 100.0f - 100.0f;
+		zs[i] = (rand() % 20000) / 100.0f - 100.0f;
+		radii[i] = 0.5f + (rand() % 100) / 100.0f;
+	}
+	Frustum frustum = Frustum::fromMatrix(Mat4::perspective(1.047f, 16.0f / 9.0f, 0.1f, 150.0f)
+		* Mat4::lookAt(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0)));
+
+	std::vector<uint32_t> visible;
+	visible.reserve(count);
+	runner.run("cull spheres scalar", [&]() {
+		visible.clear();
+		cullSpheresScalar(frustum, xs.data(), ys.data(), zs.data(), radii.data(), 0, count, visible);
+	}, (double)count);
+	runner.run("cull spheres SIMD", [&]() {
+		visible.clear();
+		cullSpheres(frustum, xs.data(), ys.data(), zs.data(), radii.data(), 0, count, visible);
+	}, (double)count);
+	//thread count depends on the machine, so the name does not carry it
+	FrustumCuller culler;
+	runner.run("cull spheres threaded", [&]() {
+		culler.cull(frustum, xs.data(), ys.data(), zs.data(), radii.data(), count);
+	}, (double)count);
+
+	const int nodeCount = 100000;
+	Quat spin = Quat::fromAxisAngle(Vec3(0, 1, 0), 0.01f);
+	Scene scene;
+	scene.reserve(nodeCount);
+	scene.addNode(Scene::NO_PARENT);
+	for (int i = 1; i < nodeCount; i++) scene.addNode(i % 1000 != 1 ? i - 1 : 0, Vec3(0.01f, 0.0f, 0.0f), spin);
+	scene.updateWorld();
+	runner.run("scene full update", [&]() {
+		scene.setLocal(0, Vec3(), spin, Vec3(1, 1, 1));
+		scene.updateWorld();
+	}, nodeCount);
+}
+
+
+int main(int argc, char** argv) {
+	BenchmarkOptions options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+		else if (arg == "--baseline" && hasValue) options.baselinePath = argv[++i];
+		else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+		else if (arg == "--reps" && hasValue) options.repetitions = std::max(1, atoi(argv[++i]));
+		else if (arg == "--warmup" && hasValue) options.warmup = std::max(0, atoi(argv[++i]));
+		else if (arg == "--tolerance" && hasValue) options.tolerance = atof(argv[++i]) / 100.0;
+		else {
+			std::cout << "usage: FirstGLFWBenchmarks [--filter text] [--reps n] [--warmup n] [--json out.json]"
+				" [--baseline old.json] [--tolerance percent]" << std::endl;
+			return 1;
+		}
+	}
+
+	NullGL::install();
+	BenchmarkRunner runner(options);
+	benchmarkShaderSources(runner);
+	benchmarkShaders(runner);
+	benchmarkVertexPacking(runner);
+	benchmarkOpaqueQueue(runner);
+	benchmarkCullingAndScene(runner);
+
+	if (!options.jsonPath.empty() && !writeBenchmarkJson(options.jsonPath, runner.results)) return 1;
+	if (!options.baselinePath.empty()) {
+		std::map<std::string, double> baseline = readBenchmarkBaseline(options.baselinePath);
+		if (baseline.empty()) return 1;
+		int regressions = compareWithBaseline(runner.results, baseline, options.tolerance);
+		std::cout << "BASELINE " << regressions << " regressions over " << options.tolerance * 100.0 << "%" << std::endl;
+		//non zero so a script can fail the comparison
+		return regressions > 0 ? 2 : 0;
+	}
+	return 0;
+}
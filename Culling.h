@@ -0,0 +1,307 @@
+#ifndef CULLING_H
+#define CULLING_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include "VectorMath.h"
+#include "Trace.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+//six planes a*x + b*y + c*z + d >= 0 inside, normalised so d is a distance
+struct Frustum {
+	Vec4 planes[6];
+
+	//Gribb/Hartmann extraction from a column major view projection matrix
+	static Frustum fromMatrix(const Mat4& viewProjection) {
+		const float* m = viewProjection.m;
+		//rows of the matrix
+		Vec4 r0(m[0], m[4], m[8], m[12]);
+		Vec4 r1(m[1], m[5], m[9], m[13]);
+		Vec4 r2(m[2], m[6], m[10], m[14]);
+		Vec4 r3(m[3], m[7], m[11], m[15]);
+		Frustum f;
+		f.planes[0] = r3 + r0; //left
+		f.planes[1] = r3 - r0; //right
+		f.planes[2] = r3 + r1; //bottom
+		f.planes[3] = r3 - r1; //top
+		f.planes[4] = r3 + r2; //near
+		f.planes[5] = r3 - r2; //far
+		for (Vec4& p : f.planes) {
+			float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+			p = p * (1.0f / len);
+		}
+		return f;
+	}
+};
+
+//lowest set lane of a movemask result, mask must be non zero
+inline int countTrailingZerosMask(int mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, (unsigned long)mask);
+	return (int)index;
+#else
+	return __builtin_ctz((unsigned int)mask);
+#endif
+}
+
+//per call statistics of a cull
+struct CullStats {
+	size_t tested = 0;
+	size_t visible = 0;
+	double milliseconds = 0.0;
+
+	double objectsPerMs() const { return milliseconds > 0.0 ? tested / milliseconds : 0.0; }
+	double percentCulled() const { return tested > 0 ? 100.0 * (tested - visible) / tested : 0.0; }
+	void report(const char* label) const {
+		std::cout << "CULLING " << label << ": " << tested << " tested, " << visible << " visible, "
+			<< percentCulled() << "% culled, " << objectsPerMs() << " objects/ms" << std::endl;
+	}
+};
+
+
+//scalar reference, appends the index of every sphere touching the frustum
+inline void cullSpheresScalar(const Frustum& frustum, const float* xs, const float* ys, const float* zs, const float* radii,
+	size_t begin, size_t end, std::vector<uint32_t>& visible) {
+	for (size_t i = begin; i < end; i++) {
+		bool inside = true;
+		for (const Vec4& p : frustum.planes) {
+			if (p.x * xs[i] + p.y * ys[i] + p.z * zs[i] + p.w < -radii[i]) {
+				inside = false;
+				break;
+			}
+		}
+		if (inside) visible.push_back((uint32_t)i);
+	}
+}
+
+//tests 8 spheres per instruction with AVX or 4 with SSE, the remainder goes through the scalar loop
+inline void cullSpheres(const Frustum& frustum, const float* xs, const float* ys, const float* zs, const float* radii,
+	size_t begin, size_t end, std::vector<uint32_t>& visible) {
+	size_t i = begin;
+#if defined(VECTOR_MATH_AVX)
+	__m256 px[6], py[6], pz[6], pw[6];
+	for (int p = 0; p < 6; p++) {
+		px[p] = _mm256_set1_ps(frustum.planes[p].x);
+		py[p] = _mm256_set1_ps(frustum.planes[p].y);
+		pz[p] = _mm256_set1_ps(frustum.planes[p].z);
+		pw[p] = _mm256_set1_ps(frustum.planes[p].w);
+	}
+	for (; i + 8 <= end; i += 8) {
+		__m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i), z = _mm256_loadu_ps(zs + i);
+		__m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radii + i));
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int p = 0; p < 6; p++) {
+			__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], x), _mm256_mul_ps(py[p], y)),
+				_mm256_add_ps(_mm256_mul_ps(pz[p], z), pw[p]));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negR, _CMP_GE_OQ));
+		}
+		int mask = _mm256_movemask_ps(inside);
+		while (mask) {
+			int lane = countTrailingZerosMask(mask);
+			visible.push_back((uint32_t)(i + lane));
+			mask &= mask - 1;
+		}
+	}
+#elif defined(VECTOR_MATH_SSE)
+	__m128 px[6], py[6], pz[6], pw[6];
+	for (int p = 0; p < 6; p++) {
+		px[p] = _mm_set1_ps(frustum.planes[p].x);
+		py[p] = _mm_set1_ps(frustum.planes[p].y);
+		pz[p] = _mm_set1_ps(frustum.planes[p].z);
+		pw[p] = _mm_set1_ps(frustum.planes[p].w);
+	}
+	for (; i + 4 <= end; i += 4) {
+		__m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i), z = _mm_loadu_ps(zs + i);
+		__m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+		__m128 inside = _mm_cmpeq_ps(negR, negR);
+		for (int p = 0; p < 6; p++) {
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], x), _mm_mul_ps(py[p], y)),
+				_mm_add_ps(_mm_mul_ps(pz[p], z), pw[p]));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+		}
+		int mask = _mm_movemask_ps(inside);
+		while (mask) {
+			int lane = countTrailingZerosMask(mask);
+			visible.push_back((uint32_t)(i + lane));
+			mask &= mask - 1;
+		}
+	}
+#endif
+	cullSpheresScalar(frustum, xs, ys, zs, radii, i, end, visible);
+}
+
+//axis aligned boxes as centers and half extents: a box is outside when even its corner
+//furthest along a plane's normal is behind that plane
+inline void cullAABBs(const Frustum& frustum, const float* cx, const float* cy, const float* cz,
+	const float* ex, const float* ey, const float* ez, size_t begin, size_t end, std::vector<uint32_t>& visible) {
+	size_t i = begin;
+#if defined(VECTOR_MATH_SSE)
+	for (; i + 4 <= end; i += 4) {
+		__m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+		__m128 hx = _mm_loadu_ps(ex + i), hy = _mm_loadu_ps(ey + i), hz = _mm_loadu_ps(ez + i);
+		__m128 inside = _mm_cmpeq_ps(x, x);
+		for (const Vec4& p : frustum.planes) {
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), x), _mm_mul_ps(_mm_set1_ps(p.y), y)),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.z), z), _mm_set1_ps(p.w)));
+			__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(p.x)), hx), _mm_mul_ps(_mm_set1_ps(std::fabs(p.y)), hy)),
+				_mm_mul_ps(_mm_set1_ps(std::fabs(p.z)), hz));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+		}
+		int mask = _mm_movemask_ps(inside);
+		while (mask) {
+			visible.push_back((uint32_t)(i + countTrailingZerosMask(mask)));
+			mask &= mask - 1;
+		}
+	}
+#endif
+	for (; i < end; i++) {
+		bool inside = true;
+		for (const Vec4& p : frustum.planes) {
+			float d = p.x * cx[i] + p.y * cy[i] + p.z * cz[i] + p.w;
+			float r = std::fabs(p.x) * ex[i] + std::fabs(p.y) * ey[i] + std::fabs(p.z) * ez[i];
+			if (d + r < 0.0f) {
+				inside = false;
+				break;
+			}
+		}
+		if (inside) visible.push_back((uint32_t)i);
+	}
+}
+
+
+//culls sphere bounds into a compact list of visible indices in ascending order. above
+//parallelThreshold objects the range is split across a pool of worker threads, started on
+//the first parallel cull and kept until the culler is destroyed, and the per thread lists
+//are concatenated, so the output is the same as a single threaded run
+class FrustumCuller {
+public:
+	std::vector<uint32_t> visible;
+	CullStats stats;
+	size_t parallelThreshold = 64 * 1024;
+
+	//threads taking part in a parallel cull, the calling one included. 0 means one per hardware
+	//thread. fixed for the culler's lifetime, the workers and their result lists are sized by it
+	explicit FrustumCuller(unsigned int requestedThreads = 0)
+		: threads(requestedThreads > 0 ? requestedThreads : std::max(1u, std::thread::hardware_concurrency())) {}
+	~FrustumCuller() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& worker : workers) worker.join();
+	}
+	FrustumCuller(const FrustumCuller&) = delete;
+	FrustumCuller& operator=(const FrustumCuller&) = delete;
+
+	unsigned int threadCount() const { return threads; }
+
+	const std::vector<uint32_t>& cull(const Frustum& frustum, const float* xs, const float* ys, const float* zs,
+		const float* radii, size_t count) {
+		TRACE_SCOPE("frustum cull");
+		auto start = std::chrono::high_resolution_clock::now();
+		visible.clear();
+		if (count < parallelThreshold || threads == 1) {
+			cullSpheres(frustum, xs, ys, zs, radii, 0, count, visible);
+		}
+		else {
+			if (workers.empty()) startWorkers();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				job = { &frustum, xs, ys, zs, radii, count, (count + threads - 1) / threads };
+				pending = threads - 1;
+				generation++;
+			}
+			wake.notify_all();
+			//the calling thread takes the first range instead of waiting idle
+			runRange(0);
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				finished.wait(lock, [&]() { return pending == 0; });
+			}
+			for (const std::vector<uint32_t>& part : partial) {
+				visible.insert(visible.end(), part.begin(), part.end());
+			}
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		stats.tested = count;
+		stats.visible = visible.size();
+		stats.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+		return visible;
+	}
+
+private:
+	//the cull being run, only written while every worker is waiting
+	struct Job {
+		const Frustum* frustum;
+		const float* xs;
+		const float* ys;
+		const float* zs;
+		const float* radii;
+		size_t count;
+		size_t chunk;
+	};
+
+	const unsigned int threads;
+	std::vector<std::vector<uint32_t>> partial;
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable finished;
+	Job job = {};
+	uint64_t generation = 0;
+	unsigned int pending = 0;
+	bool stopping = false;
+
+	void startWorkers() {
+		partial.resize(threads);
+		workers.reserve(threads - 1);
+		for (unsigned int t = 1; t < threads; t++) {
+			workers.emplace_back(&FrustumCuller::workerLoop, this, t);
+		}
+	}
+
+	void runRange(unsigned int t) {
+		TRACE_SCOPE("frustum cull range");
+		size_t begin = std::min(job.count, t * job.chunk);
+		size_t end = std::min(job.count, begin + job.chunk);
+		partial[t].clear();
+		cullSpheres(*job.frustum, job.xs, job.ys, job.zs, job.radii, begin, end, partial[t]);
+	}
+
+	//each worker owns range t of every job, it sleeps until the generation moves on
+	void workerLoop(unsigned int t) {
+		uint64_t seen = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&]() { return stopping || generation != seen; });
+				if (stopping) return;
+				seen = generation;
+			}
+			runRange(t);
+			bool last;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				last = --pending == 0;
+			}
+			if (last) finished.notify_one();
+		}
+	}
+};
+
+#endif
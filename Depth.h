@@ -0,0 +1,344 @@
+#ifndef DEPTH_H
+#define DEPTH_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include "Shader.h"
+#include "Framebuffer.h"
+#include "VectorMath.h"
+#include "VertexFormat.h"
+#include "GpuMemory.h"
+#include "GpuCulling.h"
+
+
+//how depth is configured for a pass. reversed-Z maps near to 1 and far to 0 in a float depth
+//buffer, so precision is spent evenly over distance instead of piling up at the near plane
+struct DepthSettings {
+	bool reversedZ = false;
+	//lay down depth with color writes off first, then shade only the nearest surface
+	bool prePass = false;
+	bool sortFrontToBack = true;
+
+	//needs glClipControl (GL 4.5 or ARB_clip_control); without it reversedZ is ignored
+	static bool reversedZAvailable() {
+		return glClipControl != NULL;
+	}
+	bool reversed() const {
+		return reversedZ && reversedZAvailable();
+	}
+
+	//clip range, compare function and clear value for this configuration
+	void apply() const {
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+		if (reversed()) {
+			glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
+			glDepthFunc(GL_GREATER);
+			glClearDepth(0.0);
+		}
+		else {
+			if (reversedZAvailable()) glClipControl(GL_LOWER_LEFT, GL_NEGATIVE_ONE_TO_ONE);
+			glDepthFunc(GL_LESS);
+			glClearDepth(1.0);
+		}
+	}
+
+	//the reversed projection has an infinite far plane, zFar only applies to the standard one
+	Mat4 projection(float fovyRadians, float aspect, float zNear, float zFar) const {
+		if (reversed()) return Mat4::perspectiveReversedZ(fovyRadians, aspect, zNear);
+		return Mat4::perspective(fovyRadians, aspect, zNear, zFar);
+	}
+};
+
+
+//one opaque draw: a range of a VAO placed by a model matrix
+struct OpaqueDraw {
+	Mat4 model;
+	uint64_t key;
+	unsigned int VAO;
+	int first;
+	int count;
+};
+
+//opaque draws collected for a frame. sorting front to back lets early-Z reject hidden
+//fragments before they are shaded; draws at the same distance stay grouped by VAO
+class OpaqueQueue {
+public:
+	std::vector<OpaqueDraw> draws;
+
+	void clear() {
+		draws.clear();
+	}
+	void add(unsigned int VAO, int first, int count, const Mat4& model) {
+		OpaqueDraw draw;
+		draw.model = model;
+		draw.key = VAO;
+		draw.VAO = VAO;
+		draw.first = first;
+		draw.count = count;
+		draws.push_back(draw);
+	}
+
+	//key is the view distance of each draw's origin in the high 32 bits, VAO in the low 32.
+	//a non negative float's bit pattern orders the same as its value, so no conversion is needed
+	void sortFrontToBack(const Mat4& view) {
+		for (OpaqueDraw& draw : draws) {
+			Vec3 origin = view.transformPoint(Vec3(draw.model.m[12], draw.model.m[13], draw.model.m[14]));
+			float distance = std::max(0.0f, -origin.z);
+			uint32_t bits;
+			std::memcpy(&bits, &distance, sizeof(bits));
+			draw.key = ((uint64_t)bits << 32) | draw.VAO;
+		}
+		std::sort(draws.begin(), draws.end(), [](const OpaqueDraw& a, const OpaqueDraw& b) { return a.key < b.key; });
+	}
+
+	//shader takes the combined matrix in its transform uniform, like Shaders/vertexShader.vs
+	void submit(Shader& shader, const Mat4& viewProjection) const {
+		shader.use();
+		unsigned int bound = 0;
+		for (const OpaqueDraw& draw : draws) {
+			shader.setMat4("transform", viewProjection * draw.model);
+			if (draw.VAO != bound) {
+				glBindVertexArray(draw.VAO);
+				bound = draw.VAO;
+			}
+			glDrawArrays(GL_TRIANGLES, draw.first, draw.count);
+		}
+	}
+};
+
+//the multi-draw indirect path for an OpaqueQueue whose draws all come from one vertex buffer:
+//the whole queue is one glMultiDrawArraysIndirect and no uniform changes between draws. each
+//command's baseInstance picks its model matrix through an instanced index attribute, the way
+//GpuCuller picks its bounds. commands and matrices are written to a ring of regions fenced per
+//submit, straight through a persistent mapping when asked for and the context has one,
+//otherwise with glBufferSubData
+class IndirectOpaqueRenderer {
+public:
+	//regions in flight, a pre-pass takes two a frame
+	static const int RING = 4;
+	uint32_t maxDraws;
+	bool persistent;
+	//submits that had to wait for the GPU to finish with their region
+	uint64_t stalls = 0;
+
+	static bool available() {
+		return GLAD_GL_VERSION_4_3 != 0 && glMultiDrawArraysIndirect != NULL;
+	}
+
+	//vertexBuffer holds every mesh the queued draws refer to, laid out as format
+	IndirectOpaqueRenderer(uint32_t maxDraws, const VertexFormat& format, unsigned int vertexBuffer, bool persistent)
+		: maxDraws(maxDraws), persistent(persistent && glBufferStorage != NULL)
+	{
+		size_t entries = (size_t)RING * maxDraws;
+		commands = allocate(GL_DRAW_INDIRECT_BUFFER, entries * sizeof(DrawArraysIndirectCommand), (void**)&mappedCommands, "indirect commands");
+		models = allocate(GL_SHADER_STORAGE_BUFFER, entries * sizeof(Mat4), (void**)&mappedModels, "indirect models");
+		if (!this->persistent) {
+			stagingCommands.resize(maxDraws);
+			stagingModels.resize(maxDraws);
+		}
+
+		//0, 1, 2... read once per instance, so a command's baseInstance becomes its draw index
+		std::vector<uint32_t> indices(entries);
+		for (size_t i = 0; i < entries; i++) indices[i] = (uint32_t)i;
+		glGenBuffers(1, &drawIndices);
+		glBindBuffer(GL_ARRAY_BUFFER, drawIndices);
+		glBufferData(GL_ARRAY_BUFFER, entries * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+		GpuMemory::track(GpuMemory::BUFFER, drawIndices, entries * sizeof(uint32_t), "indirect draw indices");
+
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+		for (const VertexFormat::Attribute& a : format.attributes) {
+			glVertexAttribPointer(a.index, a.size, a.type, a.normalized, format.stride, (void*)(size_t)a.offset);
+			glEnableVertexAttribArray(a.index);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, drawIndices);
+		glVertexAttribIPointer(DRAW_INDEX_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+		glVertexAttribDivisor(DRAW_INDEX_ATTRIBUTE, 1);
+		glEnableVertexAttribArray(DRAW_INDEX_ATTRIBUTE);
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GpuMemory::track(GpuMemory::VERTEX_ARRAY, VAO, 0, "indirect opaque");
+	}
+	~IndirectOpaqueRenderer() {
+		for (GLsync fence : fences) if (fence) glDeleteSync(fence);
+		//deleting a mapped buffer unmaps it
+		GpuMemory::destroy(GpuMemory::BUFFER, commands);
+		GpuMemory::destroy(GpuMemory::BUFFER, models);
+		GpuMemory::destroy(GpuMemory::BUFFER, drawIndices);
+		GpuMemory::destroy(GpuMemory::VERTEX_ARRAY, VAO);
+	}
+	IndirectOpaqueRenderer(const IndirectOpaqueRenderer&) = delete;
+	IndirectOpaqueRenderer& operator=(const IndirectOpaqueRenderer&) = delete;
+
+	//draws the queue in its current order, the VAO of each draw is ignored and first and count
+	//index into vertexBuffer. shader reads the models from SSBO binding 0 and takes the
+	//viewProjection uniform, like Shaders/opaqueIndirect.vs. draws past maxDraws are dropped
+	void submit(const OpaqueQueue& queue, Shader& shader, const Mat4& viewProjection) {
+		uint32_t count = (uint32_t)std::min(queue.draws.size(), (size_t)maxDraws);
+		if (count == 0) return;
+		int region = next;
+		next = (next + 1) % RING;
+		waitForRegion(region);
+
+		size_t base = (size_t)region * maxDraws;
+		DrawArraysIndirectCommand* command = persistent ? mappedCommands + base : stagingCommands.data();
+		Mat4* model = persistent ? mappedModels + base : stagingModels.data();
+		for (uint32_t i = 0; i < count; i++) {
+			const OpaqueDraw& draw = queue.draws[i];
+			command[i] = { (uint32_t)draw.count, 1, (uint32_t)draw.first, (uint32_t)(base + i) };
+			model[i] = draw.model;
+		}
+		if (!persistent) {
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+			glBufferSubData(GL_DRAW_INDIRECT_BUFFER, base * sizeof(DrawArraysIndirectCommand), count * sizeof(DrawArraysIndirectCommand), command);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, models);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, base * sizeof(Mat4), count * sizeof(Mat4), model);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		}
+
+		shader.use();
+		shader.setMat4("viewProjection", viewProjection);
+		glBindVertexArray(VAO);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, models);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+		glMultiDrawArraysIndirect(GL_TRIANGLES, (void*)(base * sizeof(DrawArraysIndirectCommand)), count, 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		glBindVertexArray(0);
+		fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+private:
+	static const unsigned int DRAW_INDEX_ATTRIBUTE = 2;
+	unsigned int commands = 0;
+	unsigned int models = 0;
+	unsigned int drawIndices = 0;
+	unsigned int VAO = 0;
+	DrawArraysIndirectCommand* mappedCommands = NULL;
+	Mat4* mappedModels = NULL;
+	std::vector<DrawArraysIndirectCommand> stagingCommands;
+	std::vector<Mat4> stagingModels;
+	GLsync fences[RING] = {};
+	int next = 0;
+
+	unsigned int allocate(GLenum target, size_t size, void** mapped, const char* tag) {
+		unsigned int buffer;
+		glGenBuffers(1, &buffer);
+		glBindBuffer(target, buffer);
+		if (persistent) {
+			//coherent, so writes need no flush before the draw that reads them
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(target, size, NULL, flags);
+			*mapped = glMapBufferRange(target, 0, size, flags);
+			if (*mapped == NULL) {
+				std::cout << "ERROR::INDIRECT_OPAQUE::MAP_FAILED " << tag << std::endl;
+				persistent = false;
+			}
+		}
+		else {
+			glBufferData(target, size, NULL, GL_DYNAMIC_DRAW);
+		}
+		glBindBuffer(target, 0);
+		GpuMemory::track(GpuMemory::BUFFER, buffer, size, tag);
+		return buffer;
+	}
+
+	void waitForRegion(int region) {
+		GLsync& fence = fences[region];
+		if (!fence) return;
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED) {
+			stalls++;
+			do {
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+		if (result == GL_WAIT_FAILED) std::cout << "ERROR::INDIRECT_OPAQUE::FENCE_WAIT_FAILED" << std::endl;
+		glDeleteSync(fence);
+		fence = NULL;
+	}
+};
+
+//clears and draws the queue into the bound framebuffer. with a pre-pass the second pass
+//compares with LEQUAL (GEQUAL reversed) against its own depth and leaves depth writes off.
+//given an indirect renderer the queue goes through it and shader must be one it can use
+inline void renderOpaque(OpaqueQueue& queue, Shader& shader, const Mat4& view, const Mat4& projection,
+	const DepthSettings& settings, IndirectOpaqueRenderer* indirect = NULL) {
+	settings.apply();
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	if (settings.sortFrontToBack) queue.sortFrontToBack(view);
+	Mat4 viewProjection = projection * view;
+	auto submit = [&]() {
+		if (indirect) indirect->submit(queue, shader, viewProjection);
+		else queue.submit(shader, viewProjection);
+	};
+	if (settings.prePass) {
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		submit();
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glDepthMask(GL_FALSE);
+		glDepthFunc(settings.reversed() ? GL_GEQUAL : GL_LEQUAL);
+	}
+	submit();
+	settings.apply();
+}
+
+
+//how often each pixel was shaded in an overdraw capture
+struct OverdrawStats {
+	size_t pixels = 0;
+	size_t coveredPixels = 0;
+	size_t shadedFragments = 0;
+	int maxLayers = 0;
+
+	//fragments shaded per pixel that shows any geometry, 1.0 means no overdraw at all
+	double averagePerCovered() const { return coveredPixels > 0 ? (double)shadedFragments / coveredPixels : 0.0; }
+	void report(const char* label) const {
+		std::cout << "OVERDRAW " << label << ": " << averagePerCovered() << " fragments per covered pixel, max "
+			<< maxLayers << ", " << coveredPixels << " of " << pixels << " pixels covered" << std::endl;
+	}
+};
+
+//debug visualisation: renders the queue with Shaders/overdraw.fs into target's color, additive
+//blending makes the red channel a per pixel shade count (saturating at 255), then reads it back.
+//overdrawShader must be built from a vertex shader with a transform uniform and overdraw.fs
+inline OverdrawStats captureOverdraw(Framebuffer& target, OpaqueQueue& queue, Shader& overdrawShader,
+	const Mat4& view, const Mat4& projection, const DepthSettings& settings) {
+	target.bind();
+	GLfloat clearColor[4];
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE);
+	overdrawShader.use();
+	overdrawShader.setFloat("layerStep", 1.0f / 255.0f);
+	renderOpaque(queue, overdrawShader, view, projection, settings);
+	glDisable(GL_BLEND);
+	glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+
+	std::vector<unsigned char> counts((size_t)target.width * target.height);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, target.width, target.height, GL_RED, GL_UNSIGNED_BYTE, counts.data());
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	Framebuffer::unbind();
+
+	OverdrawStats stats;
+	stats.pixels = counts.size();
+	for (unsigned char c : counts) {
+		if (c == 0) continue;
+		stats.coveredPixels++;
+		stats.shadedFragments += c;
+		stats.maxLayers = std::max(stats.maxLayers, (int)c);
+	}
+	return stats;
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include "Framebuffer.h"
+
+
+//GL_TIME_ELAPSED queries in a small ring so a result is only read once the GPU has it ready,
+//reading the query just issued would stall until the frame finishes
+class GpuTimer {
+public:
+	static const int RING = 4;
+
+	GpuTimer() {
+		glGenQueries(RING, queries);
+		for (int i = 0; i < RING; i++) pending[i] = false;
+	}
+	~GpuTimer() {
+		glDeleteQueries(RING, queries);
+	}
+	GpuTimer(const GpuTimer&) = delete;
+	GpuTimer& operator=(const GpuTimer&) = delete;
+
+	void begin() {
+		//every slot still in flight, drop this frame's measurement rather than wait
+		skipped = pending[current];
+		if (!skipped) glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+	}
+	void end() {
+		if (skipped) return;
+		glEndQuery(GL_TIME_ELAPSED);
+		pending[current] = true;
+		current = (current + 1) % RING;
+	}
+
+	//oldest finished measurement in milliseconds, or a negative value when none is ready
+	double poll() {
+		for (int i = 0; i < RING; i++) {
+			int slot = (current + i) % RING;
+			if (!pending[slot]) continue;
+			GLint available = 0;
+			glGetQueryObjectiv(queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available) return -1.0;
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &nanoseconds);
+			pending[slot] = false;
+			return nanoseconds / 1000000.0;
+		}
+		return -1.0;
+	}
+
+private:
+	unsigned int queries[RING];
+	bool pending[RING];
+	int current = 0;
+	bool skipped = false;
+};
+
+
+//one entry of the scale log
+struct ScaleSample {
+	uint64_t frame;
+	double gpuMs;
+	double smoothedMs;
+	float scale;
+};
+
+//feedback controller from GPU frame time to render scale. the time is smoothed, and the
+//scale only moves after the smoothed time has stayed outside a band around the target for
+//several frames, then holds for a cooldown, so noise around the target does not oscillate
+class ResolutionController {
+public:
+	double targetMs;
+	float minScale = 0.5f;
+	float maxScale = 1.0f;
+	float scale = 1.0f;
+	//over target by more than this fraction scales down, under by more than lowerBand scales up
+	double upperBand = 0.05;
+	double lowerBand = 0.20;
+	int framesOutsideBand = 10;
+	int cooldownFrames = 30;
+	//largest single change, scaling up is slower than down to stay under budget
+	float maxStepDown = 0.15f;
+	float maxStepUp = 0.05f;
+	//ring of the last historyLimit samples, the oldest is at historyNext once it is full.
+	//report() keeps running totals so it covers the whole run
+	std::vector<ScaleSample> history;
+	size_t historyLimit = 4096;
+	size_t historyNext = 0;
+
+	//reserved up front so recording history never reallocates mid run
+	explicit ResolutionController(double targetMs) : targetMs(targetMs) {
+		history.reserve(historyLimit);
+	}
+
+	//sample i in frame order, 0 is the oldest kept
+	const ScaleSample& sample(size_t i) const {
+		return history[(historyNext + i) % history.size()];
+	}
+
+	//feeds one GPU measurement, returns true when the scale changed
+	bool update(double gpuMs) {
+		frame++;
+		smoothedMs = smoothedMs < 0.0 ? gpuMs : smoothedMs * 0.9 + gpuMs * 0.1;
+		ScaleSample entry = { frame, gpuMs, smoothedMs, scale };
+		if (history.size() < historyLimit) {
+			history.push_back(entry);
+		}
+		else {
+			history[historyNext] = entry;
+			historyNext = (historyNext + 1) % historyLimit;
+		}
+		lowestScale = std::min(lowestScale, scale);
+		highestScale = std::max(highestScale, scale);
+		totalGpuMs += gpuMs;
+		if (frame > 1 && scale != lastScale) scaleChanges++;
+		lastScale = scale;
+
+		if (cooldown > 0) {
+			cooldown--;
+			return false;
+		}
+		if (smoothedMs > targetMs * (1.0 + upperBand)) {
+			over++;
+			under = 0;
+		}
+		else if (smoothedMs < targetMs * (1.0 - lowerBand)) {
+			under++;
+			over = 0;
+		}
+		else {
+			over = under = 0;
+		}
+		if (over < framesOutsideBand && under < framesOutsideBand) return false;
+
+		//pixel cost grows with the square of the scale
+		float wanted = scale * (float)std::sqrt(targetMs / smoothedMs);
+		float next = std::min(std::max(wanted, scale - maxStepDown), scale + maxStepUp);
+		next = std::min(maxScale, std::max(minScale, next));
+		over = under = 0;
+		if (std::fabs(next - scale) < 0.01f) return false;
+
+		std::cout << "DYNAMIC_RESOLUTION frame " << frame << ": scale " << scale << " -> " << next
+			<< " (gpu " << smoothedMs << " ms, target " << targetMs << " ms)" << std::endl;
+		scale = next;
+		cooldown = cooldownFrames;
+		//the smoothed time was measured at the old scale, restart it
+		smoothedMs = -1.0;
+		return true;
+	}
+
+	void report() const {
+		if (frame == 0) return;
+		std::cout << "DYNAMIC_RESOLUTION " << frame << " frames, scale " << lowestScale << " to " << highestScale
+			<< ", " << scaleChanges << " changes, mean gpu " << totalGpuMs / frame << " ms, target "
+			<< targetMs << " ms" << std::endl;
+	}
+
+private:
+	uint64_t frame = 0;
+	double smoothedMs = -1.0;
+	int over = 0;
+	int under = 0;
+	int cooldown = 0;
+	float lowestScale = 1e30f;
+	float highestScale = 0.0f;
+	float lastScale = 0.0f;
+	double totalGpuMs = 0.0;
+	size_t scaleChanges = 0;
+};
+
+
+//scene target sized to the window whose used area follows the controller's scale. the
+//texture is never reallocated when the scale changes, only the viewport and the blit source
+//shrink, so a scale step costs nothing; endFrame upscales the used area to the window
+class DynamicResolution {
+public:
+	ResolutionController controller;
+	Framebuffer target;
+	int windowWidth;
+	int windowHeight;
+
+	DynamicResolution(int windowWidth, int windowHeight, double targetMs)
+		: controller(targetMs), target(windowWidth, windowHeight), windowWidth(windowWidth), windowHeight(windowHeight) {}
+
+	int renderWidth() const { return std::max(1, (int)(windowWidth * controller.scale)); }
+	int renderHeight() const { return std::max(1, (int)(windowHeight * controller.scale)); }
+
+	//call from the framebuffer size callback
+	void resize(int width, int height) {
+		if (width <= 0 || height <= 0) return;
+		windowWidth = width;
+		windowHeight = height;
+		target.resize(width, height);
+	}
+
+	//binds the scene target with the scaled viewport and starts timing the scene
+	void beginFrame() {
+		timer.begin();
+		target.bind();
+		glViewport(0, 0, renderWidth(), renderHeight());
+	}
+
+	//stops timing, upscales into the window and feeds the oldest unread GPU time to the controller
+	void endFrame() {
+		timer.end();
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, target.ID);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, renderWidth(), renderHeight(), 0, 0, windowWidth, windowHeight,
+			GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, windowWidth, windowHeight);
+
+		double gpuMs = timer.poll();
+		if (gpuMs >= 0.0) controller.update(gpuMs);
+	}
+
+private:
+	GpuTimer timer;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#writes EmbeddedShaders.h with the source of every file in Shaders/, run as a pre-build step so
+#the executable carries its shaders and starts from any directory. one string literal per line
+#keeps each literal far below MSVC's length limit. the header is only rewritten when a shader
+#changed, so an unchanged tree does not recompile
+param([string]$ProjectDir = $PSScriptRoot)
+
+$shaderDir = Join-Path $ProjectDir "Shaders"
+$headerPath = Join-Path $ProjectDir "EmbeddedShaders.h"
+
+$out = New-Object System.Text.StringBuilder
+[void]$out.Append("//generated from Shaders/ by EmbedShaders.ps1 before every build, do not edit`n")
+[void]$out.Append("#ifndef EMBEDDED_SHADERS_H`n#define EMBEDDED_SHADERS_H`n`n")
+[void]$out.Append("struct EmbeddedShader {`n`tconst char* path;`n`tconst char* source;`n};`n`n")
+[void]$out.Append("inline constexpr EmbeddedShader embeddedShaders[] = {`n")
+
+foreach ($file in Get-ChildItem $shaderDir -File | Sort-Object Name) {
+	[void]$out.Append("`t{ `"Shaders/$($file.Name)`",`n")
+	$text = [System.IO.File]::ReadAllText($file.FullName).Replace("`r`n", "`n")
+	$lines = $text.Split("`n")
+	#a trailing newline leaves an empty last element
+	$count = $lines.Length
+	if ($text.EndsWith("`n")) { $count-- }
+	if ($count -eq 0) { [void]$out.Append("`t`t`"`"`n") }
+	for ($i = 0; $i -lt $count; $i++) {
+		$line = $lines[$i].Replace("\", "\\").Replace("`"", "\`"")
+		$newline = if ($i -lt $count - 1 -or $text.EndsWith("`n")) { "\n" } else { "" }
+		[void]$out.Append("`t`t`"$line$newline`"`n")
+	}
+	[void]$out.Append("`t},`n")
+}
+
+[void]$out.Append("};`n`n#endif`n")
+$header = $out.ToString()
+
+if (-not (Test-Path $headerPath) -or [System.IO.File]::ReadAllText($headerPath) -ne $header) {
+	[System.IO.File]::WriteAllText($headerPath, $header)
+	Write-Host "EmbedShaders: wrote $headerPath"
+}
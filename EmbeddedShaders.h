@@ -0,0 +1,340 @@
+//generated from Shaders/ by EmbedShaders.ps1 before every build, do not edit
+#ifndef EMBEDDED_SHADERS_H
+#define EMBEDDED_SHADERS_H
+
+struct EmbeddedShader {
+	const char* path;
+	const char* source;
+};
+
+inline constexpr EmbeddedShader embeddedShaders[] = {
+	{ "Shaders/cullInstances.cs",
+		"#version 430 core\n"
+		"\n"
+		"layout(local_size_x = 64) in;\n"
+		"\n"
+		"//matches DrawArraysIndirectCommand in GpuCulling.h\n"
+		"struct DrawArraysIndirectCommand {\n"
+		"	uint count;\n"
+		"	uint instanceCount;\n"
+		"	uint first;\n"
+		"	uint baseInstance;\n"
+		"};\n"
+		"\n"
+		"//world space bounding sphere per instance: xyz center, w radius\n"
+		"layout(std430, binding = 0) readonly buffer Bounds {\n"
+		"	vec4 bounds[];\n"
+		"};\n"
+		"//per instance mesh range: x first vertex, y vertex count\n"
+		"layout(std430, binding = 1) readonly buffer InstanceMeshes {\n"
+		"	uvec2 instanceMeshes[];\n"
+		"};\n"
+		"layout(std430, binding = 2) writeonly buffer Commands {\n"
+		"	DrawArraysIndirectCommand commands[];\n"
+		"};\n"
+		"//compacted list of surviving instance indices, read back by the vertex shader through baseInstance\n"
+		"layout(std430, binding = 3) writeonly buffer VisibleInstances {\n"
+		"	uint visibleInstances[];\n"
+		"};\n"
+		"\n"
+		"layout(binding = 0) uniform atomic_uint drawCount;\n"
+		"\n"
+		"uniform vec4 planes[6];\n"
+		"uniform uint instanceCount;\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	uint instance = gl_GlobalInvocationID.x;\n"
+		"	if (instance >= instanceCount) {\n"
+		"		return;\n"
+		"	}\n"
+		"	vec4 sphere = bounds[instance];\n"
+		"	for (int i = 0; i < 6; i++) {\n"
+		"		if (dot(planes[i].xyz, sphere.xyz) + planes[i].w < -sphere.w) {\n"
+		"			return;\n"
+		"		}\n"
+		"	}\n"
+		"	uint slot = atomicCounterIncrement(drawCount);\n"
+		"	uvec2 mesh = instanceMeshes[instance];\n"
+		"	commands[slot] = DrawArraysIndirectCommand(mesh.y, 1u, mesh.x, slot);\n"
+		"	visibleInstances[slot] = instance;\n"
+		"}\n"
+	},
+	{ "Shaders/fragmentShader.fs",
+		"#version 330 core\n"
+		"\n"
+		"out vec4 FragColor;\n"
+		"\n"
+		"in vec3 ourColor;\n"
+		"void main()\n"
+		"{\n"
+		"    FragColor = vec4(ourColor, 1.0);\n"
+		"}"
+	},
+	{ "Shaders/gpuCulled.vs",
+		"#version 430 core\n"
+		"\n"
+		"layout(location = 0) in vec3 aPos;\n"
+		"layout(location = 1) in vec3 aColor;\n"
+		"//instanced attribute over the compacted visible list, baseInstance selects this draw's entry\n"
+		"layout(location = 2) in uint instanceIndex;\n"
+		"\n"
+		"layout(std430, binding = 0) readonly buffer Bounds {\n"
+		"	vec4 bounds[];\n"
+		"};\n"
+		"\n"
+		"uniform mat4 viewProjection;\n"
+		"\n"
+		"out vec3 ourColor;\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	gl_Position = viewProjection * vec4(aPos + bounds[instanceIndex].xyz, 1.0);\n"
+		"	ourColor = aColor;\n"
+		"}\n"
+	},
+	{ "Shaders/hiZDownsample.cs",
+		"#version 430 core\n"
+		"\n"
+		"layout(local_size_x = 8, local_size_y = 8) in;\n"
+		"\n"
+		"//level 0 is built from the depth texture, every later level from the level above it\n"
+		"uniform sampler2D depth;\n"
+		"layout(r32f, binding = 0) readonly uniform image2D source;\n"
+		"layout(r32f, binding = 1) writeonly uniform image2D destination;\n"
+		"\n"
+		"uniform bool fromDepth;\n"
+		"//reversed-Z keeps the farthest depth as the minimum instead of the maximum\n"
+		"uniform bool reversedZ;\n"
+		"uniform ivec2 depthSize;\n"
+		"uniform ivec2 destinationSize;\n"
+		"\n"
+		"float farther(float a, float b)\n"
+		"{\n"
+		"	return reversedZ ? min(a, b) : max(a, b);\n"
+		"}\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);\n"
+		"	if (any(greaterThanEqual(texel, destinationSize))) {\n"
+		"		return;\n"
+		"	}\n"
+		"	float farthest = reversedZ ? 1.0 : 0.0;\n"
+		"	if (fromDepth) {\n"
+		"		//level 0 is a power of two no larger than the depth buffer, so one texel covers\n"
+		"		//between 1 and 2 depth texels per axis and has to take the max over all it touches\n"
+		"		vec2 ratio = vec2(depthSize) / vec2(destinationSize);\n"
+		"		ivec2 first = ivec2(floor(vec2(texel) * ratio));\n"
+		"		ivec2 last = min(ivec2(ceil(vec2(texel + 1) * ratio)) - 1, depthSize - 1);\n"
+		"		for (int y = first.y; y <= last.y; y++) {\n"
+		"			for (int x = first.x; x <= last.x; x++) {\n"
+		"				farthest = farther(farthest, texelFetch(depth, ivec2(x, y), 0).r);\n"
+		"			}\n"
+		"		}\n"
+		"	}\n"
+		"	else {\n"
+		"		//a 1 texel wide level would read past its edge, clamp rather than rely on out of range loads\n"
+		"		ivec2 base = texel * 2;\n"
+		"		ivec2 edge = min(base + 1, imageSize(source) - 1);\n"
+		"		farthest = farther(farther(imageLoad(source, base).r, imageLoad(source, ivec2(edge.x, base.y)).r),\n"
+		"			farther(imageLoad(source, ivec2(base.x, edge.y)).r, imageLoad(source, edge).r));\n"
+		"	}\n"
+		"	imageStore(destination, texel, vec4(farthest));\n"
+		"}\n"
+	},
+	{ "Shaders/occlusionTest.cs",
+		"#version 430 core\n"
+		"\n"
+		"layout(local_size_x = 64) in;\n"
+		"\n"
+		"//world space bounding sphere per object: xyz center, w radius\n"
+		"layout(std430, binding = 0) readonly buffer Bounds {\n"
+		"	vec4 bounds[];\n"
+		"};\n"
+		"//1 when the object may be visible, 0 when the pyramid proves it is hidden\n"
+		"layout(std430, binding = 1) writeonly buffer Visibility {\n"
+		"	uint visibility[];\n"
+		"};\n"
+		"\n"
+		"uniform sampler2D hiZ;\n"
+		"uniform mat4 viewProjection;\n"
+		"uniform ivec2 hiZSize;\n"
+		"uniform int hiZLevels;\n"
+		"uniform uint objectCount;\n"
+		"//reversed-Z: clip depth is already 0 to 1, nearer is larger, the pyramid holds minimums\n"
+		"uniform bool reversedZ;\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	uint object = gl_GlobalInvocationID.x;\n"
+		"	if (object >= objectCount) {\n"
+		"		return;\n"
+		"	}\n"
+		"	vec4 sphere = bounds[object];\n"
+		"\n"
+		"	//screen rectangle and nearest depth of the sphere's bounding box\n"
+		"	vec3 minimum = vec3(1.0);\n"
+		"	vec3 maximum = vec3(0.0);\n"
+		"	float nearest = reversedZ ? 0.0 : 1.0;\n"
+		"	for (int i = 0; i < 8; i++) {\n"
+		"		vec3 corner = sphere.xyz + sphere.w * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);\n"
+		"		vec4 clip = viewProjection * vec4(corner, 1.0);\n"
+		"		//crossing the near plane, the projection is unbounded so keep the object\n"
+		"		if (clip.w <= 0.0) {\n"
+		"			visibility[object] = 1u;\n"
+		"			return;\n"
+		"		}\n"
+		"		vec3 window = clip.xyz / clip.w * 0.5 + 0.5;\n"
+		"		float depth = reversedZ ? clip.z / clip.w : window.z;\n"
+		"		nearest = reversedZ ? max(nearest, depth) : min(nearest, depth);\n"
+		"		minimum = min(minimum, window);\n"
+		"		maximum = max(maximum, window);\n"
+		"	}\n"
+		"	minimum.xy = clamp(minimum.xy, 0.0, 1.0);\n"
+		"	maximum.xy = clamp(maximum.xy, 0.0, 1.0);\n"
+		"\n"
+		"	//coarsest level where the rectangle spans at most 2x2 texels\n"
+		"	vec2 extent = (maximum.xy - minimum.xy) * vec2(hiZSize);\n"
+		"	int level = int(ceil(log2(max(max(extent.x, extent.y), 1.0))));\n"
+		"	level = clamp(level, 0, hiZLevels - 1);\n"
+		"	ivec2 levelSize = max(hiZSize >> level, ivec2(1));\n"
+		"	ivec2 first = min(ivec2(minimum.xy * vec2(levelSize)), levelSize - 1);\n"
+		"	ivec2 last = min(ivec2(maximum.xy * vec2(levelSize)), levelSize - 1);\n"
+		"\n"
+		"	vec4 texels = vec4(texelFetch(hiZ, first, level).r, texelFetch(hiZ, ivec2(last.x, first.y), level).r,\n"
+		"		texelFetch(hiZ, ivec2(first.x, last.y), level).r, texelFetch(hiZ, last, level).r);\n"
+		"	bool hidden;\n"
+		"	if (reversedZ) {\n"
+		"		hidden = nearest < min(min(texels.x, texels.y), min(texels.z, texels.w));\n"
+		"	}\n"
+		"	else {\n"
+		"		hidden = nearest > max(max(texels.x, texels.y), max(texels.z, texels.w));\n"
+		"	}\n"
+		"	visibility[object] = hidden ? 0u : 1u;\n"
+		"}\n"
+	},
+	{ "Shaders/opaqueIndirect.vs",
+		"#version 430 core\n"
+		"\n"
+		"layout(location = 0) in vec3 aPos;\n"
+		"layout(location = 1) in vec3 aColor;\n"
+		"//instanced attribute over 0, 1, 2..., baseInstance makes it this draw's index\n"
+		"layout(location = 2) in uint drawIndex;\n"
+		"//atlas coordinates, the layer in z\n"
+		"layout(location = 3) in vec3 aTexCoord;\n"
+		"\n"
+		"layout(std430, binding = 0) readonly buffer Models {\n"
+		"	mat4 models[];\n"
+		"};\n"
+		"\n"
+		"uniform mat4 viewProjection;\n"
+		"\n"
+		"out vec3 ourColor;\n"
+		"out vec3 texCoord;\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	gl_Position = viewProjection * models[drawIndex] * vec4(aPos, 1.0);\n"
+		"	ourColor = aColor;\n"
+		"	texCoord = aTexCoord;\n"
+		"}\n"
+	},
+	{ "Shaders/overdraw.fs",
+		"#version 330 core\n"
+		"\n"
+		"//every fragment that survives the depth test adds one step, blended additively so the\n"
+		"//red channel ends up holding how many times each pixel was shaded. a step of 1/255 makes it\n"
+		"//an exact count for readback, a larger one a heat map that is visible on screen\n"
+		"out vec4 FragColor;\n"
+		"\n"
+		"uniform float layerStep = 1.0 / 255.0;\n"
+		"\n"
+		"in vec3 ourColor;\n"
+		"void main()\n"
+		"{\n"
+		"    FragColor = vec4(layerStep, 0.0, 0.0, 1.0);\n"
+		"}\n"
+	},
+	{ "Shaders/textured.fs",
+		"#version 330 core\n"
+		"\n"
+		"//the vertex color tinted by the face's image in the texture atlas\n"
+		"out vec4 FragColor;\n"
+		"\n"
+		"uniform sampler2DArray atlas;\n"
+		"\n"
+		"in vec3 ourColor;\n"
+		"in vec3 texCoord;\n"
+		"void main()\n"
+		"{\n"
+		"    FragColor = vec4(ourColor, 1.0) * texture(atlas, texCoord);\n"
+		"}\n"
+	},
+	{ "Shaders/vertexPulling.vs",
+		"#version 430 core\n"
+		"\n"
+		"//one interleaved vertex, matches PulledVertex in VertexPulling.h\n"
+		"struct Vertex {\n"
+		"	vec4 position;\n"
+		"	vec4 color;\n"
+		"};\n"
+		"\n"
+		"layout(std430, binding = 0) readonly buffer Vertices {\n"
+		"	Vertex vertices[];\n"
+		"};\n"
+		"//per object translation\n"
+		"layout(std430, binding = 1) readonly buffer Objects {\n"
+		"	vec4 objectOffsets[];\n"
+		"};\n"
+		"//per drawn triangle: first vertex of the triangle's mesh triangle, object index\n"
+		"layout(std430, binding = 2) readonly buffer Triangles {\n"
+		"	uvec2 triangles[];\n"
+		"};\n"
+		"\n"
+		"//instanced mode draws one mesh starting at firstVertex once per object\n"
+		"uniform bool instanced;\n"
+		"uniform int firstVertex;\n"
+		"\n"
+		"out vec3 ourColor;\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	Vertex v;\n"
+		"	uint object;\n"
+		"	if (instanced) {\n"
+		"		v = vertices[firstVertex + gl_VertexID];\n"
+		"		object = uint(gl_InstanceID);\n"
+		"	}\n"
+		"	else {\n"
+		"		uvec2 triangle = triangles[gl_VertexID / 3];\n"
+		"		v = vertices[triangle.x + uint(gl_VertexID % 3)];\n"
+		"		object = triangle.y;\n"
+		"	}\n"
+		"	gl_Position = vec4(v.position.xyz + objectOffsets[object].xyz, 1.0);\n"
+		"	ourColor = v.color.rgb;\n"
+		"}\n"
+	},
+	{ "Shaders/vertexShader.vs",
+		"#version 330 core\n"
+		"\n"
+		"layout(location = 0) in vec3 aPos;\n"
+		"layout(location = 1) in vec3 aColor;\n"
+		"//atlas coordinates, the layer in z\n"
+		"layout(location = 3) in vec3 aTexCoord;\n"
+		"\n"
+		"out vec3 ourColor;\n"
+		"out vec3 texCoord;\n"
+		"\n"
+		"uniform mat4 transform;\n"
+		"\n"
+		"void main()\n"
+		"{\n"
+		"	gl_Position = transform * vec4(aPos, 1.0);\n"
+		"	ourColor=aColor;\n"
+		"	texCoord = aTexCoord;\n"
+		"};"
+	},
+};
+
+#endif
@@ -1,18 +1,172 @@
+//this translation unit provides the counting operator new, see FrameAllocator.h
+#define FRAME_ALLOCATOR_COUNT_HEAP
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <cmath>
 #include "Shader.h"
+#include "GLResources.h"
+#include "VertexPulling.h"
+#include "Scene.h"
+#include "Culling.h"
+#include "GpuCulling.h"
+#include "HiZ.h"
+#include "Depth.h"
+#include "DynamicResolution.h"
+#include "RenderGraph.h"
+#include "FrameCapture.h"
+#include "Golden.h"
+#include "GLIntercept.h"
+#include "GLCapture.h"
+#include "GLLoader.h"
+#include "GLCapabilities.h"
+#include "Trace.h"
+#include "GLDebug.h"
+#include "Startup.h"
+#include "FrameAllocator.h"
+#include "GpuMemory.h"
+#include "MeshPool.h"
+#include "Texture.h"
+
+//everything the window callbacks need to reach, set as the window user pointer
+struct WindowState {
+	DynamicResolution* dynamicResolution = NULL;
+	RenderGraph* frameGraph = NULL;
+	//graph imports of the dynamic resolution target, its textures are new after a resize
+	RenderGraph::Resource sceneTarget = -1;
+	RenderGraph::Resource sceneDepthTarget = -1;
+};
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void processInput(GLFWwindow* window);
+void runNamedBenchmark(const char* name);
+bool runNamedSelfTest(const char* name);
+
+
+int main(int argc, char** argv) {
+	//command line: --bench <name> and --selftest <name> run in a hidden window and exit
+	const char* benchmark = NULL;
+	const char* selfTest = NULL;
+	//--golden <scene|all> runs golden image scenes, each in a child started with --golden-scene
+	const char* golden = NULL;
+	const char* goldenScene = NULL;
+	bool goldenUpdate = false;
+	//--golden-allow-missing reports scenes without a reference as skipped instead of failed
+	bool goldenAllowMissing = false;
+	bool compareDSA = false;
+	double frameBudgetMs = 16.6;
+	const char* capturePath = NULL;
+	//--gl-intercept counts GL calls per entry point and frame, --gl-timing also times them
+	bool glIntercept = false;
+	bool glTiming = false;
+	//--gl-capture <file> records the GL calls of startup and --gl-capture-frames frames for FirstGLFWReplay
+	const char* glCapturePath = NULL;
+	int glCaptureFrames = 60;
+	const char* tracePath = NULL;
+	int traceSample = 1;
+	int traceMemory = 64;
+	//--overdraw shows the scene as a heat map of how often each pixel was shaded
+	bool overdraw = false;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+			benchmark = argv[++i];
+		}
+		else if (strcmp(argv[i], "--selftest") == 0 && i + 1 < argc) {
+			selfTest = argv[++i];
+		}
+		else if (strcmp(argv[i], "--compare-dsa") == 0) {
+			compareDSA = true;
+		}
+		else if (strcmp(argv[i], "--frame-budget") == 0 && i + 1 < argc) {
+			frameBudgetMs = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+			capturePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+			golden = argv[++i];
+		}
+		else if (strcmp(argv[i], "--golden-scene") == 0 && i + 1 < argc) {
+			goldenScene = argv[++i];
+		}
+		else if (strcmp(argv[i], "--golden-update") == 0) {
+			goldenUpdate = true;
+		}
+		else if (strcmp(argv[i], "--golden-allow-missing") == 0) {
+			goldenAllowMissing = true;
+		}
+		else if (strcmp(argv[i], "--gl-intercept") == 0) {
+			glIntercept = true;
+		}
+		else if (strcmp(argv[i], "--gl-timing") == 0) {
+			glIntercept = true;
+			glTiming = true;
+		}
+		else if (strcmp(argv[i], "--gl-capture") == 0 && i + 1 < argc) {
+			glCapturePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--gl-capture-frames") == 0 && i + 1 < argc) {
+			glCaptureFrames = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--shader-dir") == 0 && i + 1 < argc) {
+			ShaderSources::overrideDirectory = argv[++i];
+		}
+		else if (strcmp(argv[i], "--gpu-budget") == 0 && i + 1 < argc) {
+			GpuMemory::budgetBytes = (size_t)std::max(0, atoi(argv[++i])) << 20;
+		}
+		else if (strcmp(argv[i], "--frame-memory") == 0) {
+			FrameMemory::reportInterval = 60;
+		}
+		else if (strcmp(argv[i], "--overdraw") == 0) {
+			overdraw = true;
+		}
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			tracePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--trace-sample") == 0 && i + 1 < argc) {
+			traceSample = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--trace-memory") == 0 && i + 1 < argc) {
+			traceMemory = atoi(argv[++i]);
+		}
+	}
+
+	//the suite itself needs no window, only its child processes do
+	if (golden) {
+		return Golden::runSuite(argv[0], golden, goldenUpdate, goldenAllowMissing) ? 0 : 1;
+	}
 
+	//the newest context the driver has, benchmarks and self tests need at least 4.3 for paths
+	//such as shader storage buffers, the window at least 3.3
+	bool headless = benchmark != NULL || selfTest != NULL || goldenScene != NULL;
+	//shaders are compiled in, only files from --shader-dir are read, while glfw and the context start up
+	if (!headless) {
+		//which vertex shader the scene uses depends on the context, so both are read
+		ShaderSources::preload("Shaders/vertexShader.vs");
+		ShaderSources::preload("Shaders/opaqueIndirect.vs");
+		ShaderSources::preload("Shaders/textured.fs");
+		if (overdraw) ShaderSources::preload("Shaders/overdraw.fs");
+	}
 
-int main() {
 	//glfw: Initialize and configure
+	Startup::Phase glfwPhase("glfwInit");
 	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwPhase.end();
+	//the loader benchmark asks for what the window does, its eager and deferred split depends on it
+	bool loaderBenchmark = benchmark != NULL && strcmp(benchmark, "loader") == 0;
+	int requestMajor = headless && !loaderBenchmark ? 4 : 3;
+	int requestMinor = 3;
+	if (headless) {
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_DEPTH_BITS, 24);
+	//some drivers only report debug messages in a debug context
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLDebug::enabled ? GLFW_TRUE : GLFW_FALSE);
 
 #ifdef __APPLE__
 	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
@@ -20,7 +174,8 @@ int main() {
 
 
 	//glfw: Create window
-	GLFWwindow* window = glfwCreateWindow(800, 600, "LearnOpenGL", NULL, NULL);
+	Startup::Phase windowPhase("window and context");
+	GLFWwindow* window = GLCapabilities::createHighestContext(800, 600, "LearnOpenGL", requestMajor, requestMinor);
 	if (window == NULL) {
 		std::cout << "Failed to create GLFW window" << std::endl;
 		glfwTerminate();
@@ -28,68 +183,363 @@ int main() {
 	}
 	glfwMakeContextCurrent(window);  //glfw: set windows as thread focus
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);//set viewport dimensions
+	windowPhase.end();
 
-	//glad: Load OpenGL function pointers
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+	//glad: Load OpenGL function pointers, the requested version now and anything newer the
+	//context has on first use
+	Startup::Phase loaderPhase("GL loader and capabilities");
+	if (!GLLoader::load((GLADloadproc)glfwGetProcAddress, requestMajor, requestMinor)) {
 		std::cout << "Failed to initialize GLAD" << std::endl;
 		return -1;
 	}
+	//extensions of the fast paths and the tier they add up to, before anything wraps the entry points
+	GLCapabilities::detect();
+	GLCapabilities::report();
+	GLDebug::install();
+	loaderPhase.end();
+	GLLoader::report();
+	//capture goes in first so intercept, when both are on, measures the calls and not the recording
+	if (glCapturePath != NULL) {
+		int width, height;
+		glfwGetFramebufferSize(window, &width, &height);
+		GLCapture::install(glCapturePath, width, height, glCaptureFrames);
+	}
+	if (glIntercept) {
+		GLIntercept::install(glTiming);
+	}
+	//one frame in traceSample is recorded, into at most traceMemory MB
+	if (tracePath != NULL) {
+		Trace::start(tracePath, traceSample, (size_t)std::max(1, traceMemory));
+	}
 
-	Shader ourShader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+	if (loaderBenchmark) {
+		//at the window's 3.3 and at the 4.3 the other headless runs ask for
+		GLLoader::benchmarkLoader((GLADloadproc)glfwGetProcAddress, 3, 3);
+		GLLoader::benchmarkLoader((GLADloadproc)glfwGetProcAddress, 4, 3);
+		glfwTerminate();
+		return 0;
+	}
+	if (benchmark) {
+		runNamedBenchmark(benchmark);
+		glfwTerminate();
+		return 0;
+	}
+	if (selfTest) {
+		bool passed = runNamedSelfTest(selfTest);
+		glfwTerminate();
+		return passed ? 0 : 1;
+	}
+	if (goldenScene) {
+		bool passed = Golden::runScene(goldenScene, goldenUpdate, goldenAllowMissing);
+		glfwTerminate();
+		return passed ? 0 : 1;
+	}
 
-	//setup for vertex data, buffers, and configure vertex attributes
-	float vertices[] = {
-		 //positions         //colors
-		 -0.4f,  0.2f, 0.0f,  1.0f, 0.0f, 0.0f,  //bottom right
-		 -0.6f, -0.2f, 0.0f,  0.0f, 1.0f, 0.0f,  //bottom left
-		 -0.2f, -0.2f, 0.0f,  0.0f, 0.0f, 1.0f   //top
-	};
+	//every GL object of the app lives in this scope, so all are deleted before the leak check
+	//and the context
+	{
+		//paths follow the capability tier: from GPU_DRIVEN up the scene is one multi-draw indirect
+		//call with its matrices in a ring, persistently mapped where the context can, and Hi-Z
+		//occlusion runs; below it every object is a uniform and a draw call. resources use DSA
+		//whenever the context has it
+		const GLCapabilities::Capabilities& caps = GLCapabilities::current;
+		bool gpuDriven = caps.tier >= GLCapabilities::TIER_GPU_DRIVEN;
+		const char* sceneVertexShader = gpuDriven ? "Shaders/opaqueIndirect.vs" : "Shaders/vertexShader.vs";
 
-	//Create vertex buffer object and assign to GPU memory as static
-	unsigned int VBO1, VAO1;
-	glGenVertexArrays(1, &VAO1);
-	glGenBuffers(1, &VBO1);
+		Startup::Phase shaderPhase("shaders");
+		Shader ourShader(sceneVertexShader, "Shaders/textured.fs");
+		ourShader.use();
+		ourShader.setInt("atlas", 0);
+		std::unique_ptr<Shader> overdrawShader;
+		if (overdraw) {
+			overdrawShader.reset(new Shader(sceneVertexShader, "Shaders/overdraw.fs"));
+			//8 layers saturate to full red
+			overdrawShader->use();
+			overdrawShader->setFloat("layerStep", 1.0f / 8.0f);
+		}
+		shaderPhase.end();
 
-	//Set current vertex array in use
-	glBindVertexArray(VAO1);
+		//one image per cube face, packed into a single texture array so the whole cube still
+		//draws with one binding. uploads stream through the PBO staging ring, which is released
+		//again once the atlas holds every face
+		Startup::Phase texturePhase("textures");
+		const int faceImageSize = 64;
+		TextureArrayAtlas atlas(256, 1);
+		AtlasRegion faceRegions[6];
+		{
+			TextureUploader uploader((size_t)faceImageSize * faceImageSize * 4, 6);
+			std::vector<uint8_t> faceImage((size_t)faceImageSize * faceImageSize * 4);
+			for (int f = 0; f < 6; f++) {
+				//a grid that gets coarser from face to face, the last three fill every other cell
+				int cell = 4 << (f % 3);
+				for (int y = 0; y < faceImageSize; y++) {
+					for (int x = 0; x < faceImageSize; x++) {
+						bool line = x % cell == 0 || y % cell == 0;
+						bool filled = f >= 3 && ((x / cell + y / cell) & 1);
+						uint8_t* texel = &faceImage[((size_t)y * faceImageSize + x) * 4];
+						texel[0] = texel[1] = texel[2] = line ? 120 : filled ? 200 : 255;
+						texel[3] = 255;
+					}
+				}
+				atlas.add(faceImage.data(), faceImageSize, faceImageSize, faceRegions[f], &uploader);
+			}
+			uploader.report();
+		}
+		texturePhase.end();
 
-	//Set current buffer data to use
-	glBindBuffer(GL_ARRAY_BUFFER, VBO1);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-	
-	//Pass vertex Position to the current VAO
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
+		//setup for vertex data, buffers, and configure vertex attributes: a unit cube, two
+		//triangles per face, one color per face and each face mapped onto its atlas region
+		const float corners[8][3] = {
+			{ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+			{ -0.5f, -0.5f,  0.5f }, { 0.5f, -0.5f,  0.5f }, { 0.5f, 0.5f,  0.5f }, { -0.5f, 0.5f,  0.5f }
+		};
+		//counter clockwise seen from outside
+		const int faces[6][4] = { { 4, 5, 6, 7 }, { 1, 0, 3, 2 }, { 5, 1, 2, 6 }, { 0, 4, 7, 3 }, { 7, 6, 2, 3 }, { 0, 1, 5, 4 } };
+		const float faceColors[6][3] = {
+			{ 1.0f, 0.5f, 0.2f }, { 0.2f, 1.0f, 0.5f }, { 0.5f, 0.2f, 1.0f },
+			{ 1.0f, 0.9f, 0.3f }, { 0.3f, 0.8f, 1.0f }, { 0.9f, 0.3f, 0.6f }
+		};
+		const float cornerUVs[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+		//half a texel in from the region's edge, so linear filtering never reads the padding
+		const float inset = 0.5f / atlas.layerSize;
+		std::vector<float> vertices;
+		for (int f = 0; f < 6; f++) {
+			const AtlasRegion& region = faceRegions[f];
+			for (int corner : { 0, 1, 2, 0, 2, 3 }) {
+				vertices.insert(vertices.end(), corners[faces[f][corner]], corners[faces[f][corner]] + 3);
+				vertices.insert(vertices.end(), faceColors[f], faceColors[f] + 3);
+				vertices.push_back(region.u0 + inset + (region.u1 - region.u0 - inset * 2) * cornerUVs[corner][0]);
+				vertices.push_back(region.v0 + inset + (region.v1 - region.v0 - inset * 2) * cornerUVs[corner][1]);
+				vertices.push_back((float)region.layer);
+			}
+		}
+		const int cubeVertexCount = 36;
+		GLsizeiptr verticesSize = (GLsizeiptr)(vertices.size() * sizeof(float));
 
-	//Pass vertex color to current VAO
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
+		//Vertex layout: position, color, then atlas coordinates and layer, 9 floats per vertex
+		VertexFormat cubeFormat(9 * sizeof(float));
+		cubeFormat.add(0, 3, GL_FLOAT, 0);
+		cubeFormat.add(1, 3, GL_FLOAT, 3 * sizeof(float));
+		cubeFormat.add(3, 3, GL_FLOAT, 6 * sizeof(float));
 
+		//Create vertex buffer object and vertex array, uses DSA when the context supports it
+		Startup::Phase bufferPhase("buffers");
+		GLResources resources(!caps.directStateAccess);
+		GpuBuffer cubeVBO(resources.createBuffer(verticesSize, vertices.data(), false, "cube"));
+		GpuVertexArray cubeVAO(resources.createVertexArray(cubeFormat, cubeVBO));
+		bufferPhase.end();
+		resources.report();
 
-	//render loop
-	//Keep window open untill told to close
-	while (!glfwWindowShouldClose(window)) {
-		//check for input
-		processInput(window);
+		//a grid of cubes with a ring of walls standing in it, seen by a camera circling the
+		//middle. each frame the bounds are frustum culled and only what is left is queued
+		Scene field;
+		const int fieldSide = 48;
+		const int wallCount = 12;
+		field.reserve(fieldSide * fieldSide + wallCount);
+		for (int z = 0; z < fieldSide; z++) {
+			for (int x = 0; x < fieldSide; x++) {
+				Vec3 position((x - fieldSide / 2) * 3.0f, 0.5f, (z - fieldSide / 2) * 3.0f);
+				field.addNode(Scene::NO_PARENT, position, Quat(), Vec3(1, 1, 1), Vec3(), 0.87f);
+			}
+		}
+		for (int i = 0; i < wallCount; i++) {
+			float angle = i * 6.2831853f / wallCount;
+			Vec3 position(std::cos(angle) * 24.0f, 4.0f, std::sin(angle) * 24.0f);
+			field.addNode(Scene::NO_PARENT, position, Quat::fromAxisAngle(Vec3(0, 1, 0), -angle + 1.5707963f),
+				Vec3(10.0f, 8.0f, 1.0f), Vec3(), 0.87f);
+		}
+		field.updateWorld();
+		FrustumCuller culler;
+		OpaqueQueue drawQueue;
+		drawQueue.draws.reserve(field.size());
+		//every draw in the queue is the cube, so the indirect path can draw them all from cubeVBO
+		std::unique_ptr<IndirectOpaqueRenderer> indirect;
+		if (gpuDriven) {
+			indirect.reset(new IndirectOpaqueRenderer((uint32_t)field.size(), cubeFormat, cubeVBO, caps.persistentMapping));
+		}
 
-		//redering commands here
-		glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
+		//Compare setup and update cost of the DSA and bind-to-edit paths
+		if (compareDSA) {
+			GLResources::compare(cubeFormat, vertices.data(), verticesSize);
+		}
 
-		//Activate shader
-		ourShader.use();
 
-		//Draw first triangle
-		glBindVertexArray(VAO1);
-		glDrawArrays(GL_TRIANGLES, 0, 3);
+		//the window's depth buffer is 24 bit fixed point, reversed-Z only pays off in a float
+		//depth target such as Framebuffer, so the window keeps the standard configuration and
+		//the scene target uses reversed-Z where glClipControl exists
+		Startup::Phase targetPhase("render targets and graph");
+		DepthSettings windowDepth;
+		windowDepth.apply();
+		DepthSettings sceneDepth;
+		sceneDepth.reversedZ = true;
+		Mat4 view, projection;
+
+		//Scene renders offscreen at a scale chosen from GPU frame time, then is upscaled to the window
+		int framebufferWidth, framebufferHeight;
+		glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+		DynamicResolution dynamicResolution(framebufferWidth, framebufferHeight, frameBudgetMs);
+
+		//Hi-Z occlusion: before the scene pass the pyramid is built from the depth the previous
+		//frame left in the scene target and every object is tested against it with that frame's
+		//camera. results arrive a frame or two later and remove hidden objects from the queue;
+		//hidden ones stay in the test, so they come back as soon as they are uncovered
+		std::unique_ptr<HiZPyramid> pyramid;
+		std::unique_ptr<OcclusionCuller> occlusion;
+		GpuBuffer boundsBuffer;
+		if (gpuDriven) {
+			pyramid.reset(new HiZPyramid(framebufferWidth, framebufferHeight));
+			occlusion.reset(new OcclusionCuller((uint32_t)field.size()));
+			boundsBuffer.reset(resources.createBuffer(field.size() * sizeof(Vec4), NULL, true, "occlusion bounds"));
+		}
+		std::cout << "RENDER_PATHS tier " << GLCapabilities::tierName(caps.tier) << ": scene "
+			<< (indirect ? (indirect->persistent ? "multi-draw indirect, persistent mapped" : "multi-draw indirect, glBufferSubData")
+				: "draw per object")
+			<< ", resources " << (resources.useDSA ? "DSA" : "bind-to-edit") << ", occlusion " << (occlusion ? "Hi-Z" : "off") << std::endl;
+		//what the depth in the scene target was rendered with, the size is 0 until it holds a frame
+		Mat4 depthViewProjection;
+		int depthWidth = 0, depthHeight = 0;
+		int depthTargetWidth = 0, depthTargetHeight = 0;
+
+		//Frame as a render graph: post passes added later declare what they read and write and
+		//get their intermediate targets allocated, aliased and resized by the graph
+		RenderGraph frameGraph(framebufferWidth, framebufferHeight);
+		RenderGraph::Resource sceneTarget = frameGraph.importTexture("scene target", dynamicResolution.target.colorTexture);
+		RenderGraph::Resource sceneDepthTarget = frameGraph.importTexture("scene depth", dynamicResolution.target.depthTexture);
+		RenderGraph::Resource windowTarget = frameGraph.importTexture("window");
+		//reads the scene depth before the scene pass writes it, so it sees the previous frame's.
+		//a resized target holds no frame yet and is skipped
+		frameGraph.addPass("hi-z", { sceneDepthTarget }, {}, [&](const RenderGraph::PassContext& context) {
+			if (!occlusion || depthWidth == 0) return;
+			if (depthTargetWidth != dynamicResolution.target.width || depthTargetHeight != dynamicResolution.target.height) return;
+			pyramid->reversedZ = sceneDepth.reversed();
+			pyramid->resize(depthWidth, depthHeight);
+			pyramid->build(context.texture(sceneDepthTarget));
+			//staging for the upload only, so it comes from the frame arena
+			ArenaVector<Vec4> bounds{ ArenaAllocator<Vec4>(FrameMemory::frame) };
+			bounds.resize(field.size());
+			for (size_t i = 0; i < bounds.size(); i++) {
+				bounds[i] = Vec4(field.boundsX[i], field.boundsY[i], field.boundsZ[i], field.boundsRadius[i]);
+			}
+			resources.updateBuffer(boundsBuffer, 0, bounds.size() * sizeof(Vec4), bounds.data());
+			occlusion->test(*pyramid, depthViewProjection, boundsBuffer, (uint32_t)bounds.size());
+		});
+		frameGraph.addPass("scene", {}, { sceneTarget, sceneDepthTarget }, [&](const RenderGraph::PassContext&) {
+			dynamicResolution.beginFrame();
+			//sorted front to back, so early-Z rejects most of what the walls hide
+			if (overdrawShader) {
+				glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+				glEnable(GL_BLEND);
+				glBlendFunc(GL_ONE, GL_ONE);
+				renderOpaque(drawQueue, *overdrawShader, view, projection, sceneDepth, indirect.get());
+				glDisable(GL_BLEND);
+			}
+			else {
+				glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+				atlas.bind(0);
+				renderOpaque(drawQueue, ourShader, view, projection, sceneDepth, indirect.get());
+			}
+			windowDepth.apply();
+			depthViewProjection = projection * view;
+			depthWidth = dynamicResolution.renderWidth();
+			depthHeight = dynamicResolution.renderHeight();
+			depthTargetWidth = dynamicResolution.target.width;
+			depthTargetHeight = dynamicResolution.target.height;
+		});
+		frameGraph.addPass("upscale", { sceneTarget }, { windowTarget }, [&](const RenderGraph::PassContext&) {
+			dynamicResolution.endFrame();
+		});
+		frameGraph.compile();
+		targetPhase.end();
+
+		//--capture out.y4m records raw video, any other path is a prefix for a PNG sequence.
+		//frames keep the window size from startup, a resized window is scaled to it
+		std::unique_ptr<FrameCapture> capture;
+		if (capturePath != NULL) {
+			size_t length = strlen(capturePath);
+			bool video = length > 4 && strcmp(capturePath + length - 4, ".y4m") == 0;
+			capture.reset(new FrameCapture(framebufferWidth, framebufferHeight,
+				video ? CaptureFormat::Y4M : CaptureFormat::PNG_SEQUENCE, capturePath));
+		}
 
-		//Clear current array in use
-		glBindVertexArray(0);
+		WindowState windowState;
+		windowState.dynamicResolution = &dynamicResolution;
+		windowState.frameGraph = &frameGraph;
+		windowState.sceneTarget = sceneTarget;
+		windowState.sceneDepthTarget = sceneDepthTarget;
+		glfwSetWindowUserPointer(window, &windowState);
 
-		//check and call events and swap the buffers
-		glfwSwapBuffers(window);
-		glfwPollEvents();
+		GLCapture::endSetup();
+		//startup ends when the first frame is presented, the report is printed then
+		Startup::Phase firstFramePhase("first frame");
+		//render loop
+		//Keep window open untill told to close
+		while (!glfwWindowShouldClose(window)) {
+			FrameMemory::beginFrame();
+			{
+				TRACE_SCOPE("frame");
+				//check for input
+				processInput(window);
+
+				//camera and culling, the draw queue holds only what the frustum test kept
+				float orbit = (float)glfwGetTime() * 0.2f;
+				view = Mat4::lookAt(Vec3(std::cos(orbit) * 60.0f, 12.0f, std::sin(orbit) * 60.0f), Vec3(0, 0, 0), Vec3(0, 1, 0));
+				projection = sceneDepth.projection(1.047f,
+					(float)dynamicResolution.renderWidth() / dynamicResolution.renderHeight(), 0.1f, 300.0f);
+				field.updateWorld();
+				culler.cull(Frustum::fromMatrix(projection * view), field.boundsX.data(), field.boundsY.data(),
+					field.boundsZ.data(), field.boundsRadius.data(), field.size());
+				//the newest finished occlusion test, every flag stays 1 until one has finished
+				if (occlusion) occlusion->collect();
+				drawQueue.clear();
+				for (uint32_t i : culler.visible) {
+					if (occlusion && occlusion->visible[i] == 0) continue;
+					drawQueue.add(cubeVAO, 0, cubeVertexCount, field.worlds[i]);
+				}
+
+				//redering commands here
+				frameGraph.execute();
+				if (capture) {
+					capture->captureScaled(0, dynamicResolution.windowWidth, dynamicResolution.windowHeight);
+				}
+
+				//check and call events and swap the buffers
+				{
+					TRACE_SCOPE("swap");
+					glfwSwapBuffers(window);
+				}
+				firstFramePhase.end();
+				Startup::firstFrame();
+				glfwPollEvents();
+			}
+			GLIntercept::endFrame();
+			GLCapture::endFrame();
+			Trace::endFrame();
+			GLDebug::drain();
+			FrameMemory::endFrame();
+			GpuMemory::endFrame();
+		}
+		dynamicResolution.controller.report();
+		std::cout << "SCENE " << field.size() << " objects, last frame " << culler.visible.size() << " in the frustum, "
+			<< drawQueue.draws.size() << " drawn";
+		if (occlusion) std::cout << ", " << occlusion->lastOccluded << " hidden by Hi-Z";
+		else std::cout << ", Hi-Z needs the GPU_DRIVEN tier";
+		if (indirect) std::cout << ", " << indirect->stalls << " indirect upload stalls";
+		std::cout << std::endl;
+		GLIntercept::summary();
+		GLCapture::finish();
+		Trace::finish();
+		GLDebug::report();
+		//how many of the deferred entry points the run ended up calling
+		GLLoader::report();
+		FrameMemory::summary();
+		if (capture) {
+			capture->finish();
+			capture->report(capturePath);
+		}
+		GpuMemory::report();
+		glfwSetWindowUserPointer(window, NULL);
 	}
+	GpuMemory::checkLeaks();
 
 	//Clear and remove all windows
 	glfwTerminate();
@@ -99,6 +549,20 @@ int main() {
 //resize window to match user resizing
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
 	glViewport(0, 0, width, height);
+	//offscreen targets follow the window, only the ones sized relative to it are rebuilt
+	WindowState* state = (WindowState*)glfwGetWindowUserPointer(window);
+	if (state == NULL) return;
+	if (state->dynamicResolution != NULL) {
+		state->dynamicResolution->resize(width, height);
+	}
+	if (state->frameGraph != NULL) {
+		state->frameGraph->resize(width, height);
+		if (state->dynamicResolution != NULL) {
+			const Framebuffer& target = state->dynamicResolution->target;
+			state->frameGraph->setImportedTexture(state->sceneTarget, target.colorTexture);
+			state->frameGraph->setImportedTexture(state->sceneDepthTarget, target.depthTexture);
+		}
+	}
 }
 
 void processInput(GLFWwindow* window) {
@@ -106,4 +570,32 @@ void processInput(GLFWwindow* window) {
 	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
 		glfwSetWindowShouldClose(window, true);
 	}
+}
+
+//correctness checks selectable with --selftest, run headless under llvmpipe with
+//LIBGL_ALWAYS_SOFTWARE=1, exit code is non zero on failure
+bool runNamedSelfTest(const char* name) {
+	if (strcmp(name, "gpu-culling") == 0) {
+		return selfTestGpuCulling();
+	}
+	if (strcmp(name, "hi-z") == 0) {
+		return selfTestHiZ();
+	}
+	if (strcmp(name, "gpu-memory") == 0) {
+		return selfTestGpuMemory();
+	}
+	if (strcmp(name, "offset-allocator") == 0) {
+		return selfTestOffsetAllocator();
+	}
+	if (strcmp(name, "mesh-pool") == 0) {
+		return selfTestMeshPool();
+	}
+	if (strcmp(name, "texture") == 0) {
+		return selfTestTexture();
+	}
+	if (strcmp(name, "frame-memory") == 0) {
+		return selfTestFrameMemory();
+	}
+	std::cout << "Unknown self test " << name << std::endl;
+	return false;
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <iostream>
+
+
+//every heap allocation made through operator new, counted by the replacement operators that
+//the one translation unit defining FRAME_ALLOCATOR_COUNT_HEAP before including this compiles
+namespace HeapCounter {
+	inline std::atomic<uint64_t> allocations{ 0 };
+	inline std::atomic<uint64_t> bytes{ 0 };
+}
+
+#ifdef FRAME_ALLOCATOR_COUNT_HEAP
+void* operator new(std::size_t size) {
+	HeapCounter::allocations.fetch_add(1, std::memory_order_relaxed);
+	HeapCounter::bytes.fetch_add(size, std::memory_order_relaxed);
+	void* p = std::malloc(size > 0 ? size : 1);
+	if (p == NULL) throw std::bad_alloc();
+	return p;
+}
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+	std::free(p);
+}
+#endif
+
+
+//bump allocator over large blocks. allocating is a pointer increment, freeing only happens all
+//at once with reset() or back to a marker. blocks are kept across resets, so after the first
+//few frames it touches the heap no more
+class LinearArena {
+public:
+	//where to rewind to, see ArenaMarker
+	struct Marker {
+		size_t block;
+		size_t offset;
+		//bytes handed out when the marker was taken, allocate counts requested sizes so
+		//this cannot be worked out from block sizes and padding on rewind
+		size_t used;
+	};
+
+	explicit LinearArena(size_t blockSize = 1 << 20) : blockSize(blockSize) {}
+	~LinearArena() {
+		for (Block& block : blocks) std::free(block.memory);
+	}
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+		for (;;) {
+			if (current < blocks.size()) {
+				Block& block = blocks[current];
+				uintptr_t base = (uintptr_t)block.memory;
+				size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+				if (aligned + size <= block.size) {
+					offset = aligned + size;
+					used += size;
+					highWater = std::max(highWater, used);
+					return block.memory + aligned;
+				}
+				//the next kept block, or a new one
+				if (current + 1 < blocks.size()) {
+					current++;
+					offset = 0;
+					continue;
+				}
+			}
+			size_t bytes = std::max(blockSize, size + alignment);
+			Block block = { (char*)std::malloc(bytes), bytes };
+			if (block.memory == NULL) throw std::bad_alloc();
+			blocks.push_back(block);
+			current = blocks.size() - 1;
+			offset = 0;
+		}
+	}
+
+	Marker mark() const {
+		return { current, offset, used };
+	}
+	//frees everything allocated after the marker was taken
+	void rewind(const Marker& marker) {
+		current = marker.block;
+		offset = marker.offset;
+		used = marker.used;
+	}
+	void reset() {
+		rewind({ 0, 0, 0 });
+	}
+
+	size_t bytesUsed() const { return used; }
+	size_t bytesReserved() const {
+		size_t total = 0;
+		for (const Block& block : blocks) total += block.size;
+		return total;
+	}
+	size_t highWaterBytes() const { return highWater; }
+
+private:
+	struct Block {
+		char* memory;
+		size_t size;
+	};
+	size_t blockSize;
+	std::vector<Block> blocks;
+	size_t current = 0;
+	size_t offset = 0;
+	size_t used = 0;
+	size_t highWater = 0;
+};
+
+//rewinds the arena when it goes out of scope, for temporaries of one function
+class ArenaMarker {
+public:
+	explicit ArenaMarker(LinearArena& arena) : arena(arena), marker(arena.mark()) {}
+	~ArenaMarker() {
+		arena.rewind(marker);
+	}
+	ArenaMarker(const ArenaMarker&) = delete;
+	ArenaMarker& operator=(const ArenaMarker&) = delete;
+
+private:
+	LinearArena& arena;
+	LinearArena::Marker marker;
+};
+
+//standard allocator over an arena, deallocate is a no-op. containers using it must not outlive
+//the next reset or rewind of their arena
+template<typename T>
+class ArenaAllocator {
+public:
+	typedef T value_type;
+	LinearArena* arena;
+
+	explicit ArenaAllocator(LinearArena& arena) : arena(&arena) {}
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(size_t n) {
+		return (T*)arena->allocate(n * sizeof(T), alignof(T));
+	}
+	void deallocate(T*, size_t) {}
+
+	template<typename U>
+	bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+	template<typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> ArenaString;
+
+
+//the frame arena is reset at the start of every frame. endFrame() tracks heap allocations per
+//frame, which should be zero once the app has warmed up
+namespace FrameMemory {
+	inline LinearArena frame;
+	//frames skipped before the steady state average starts
+	inline uint64_t warmupFrames = 60;
+	//print every this many frames, 0 only keeps totals for summary()
+	inline int reportInterval = 0;
+
+	inline uint64_t frames = 0;
+	inline uint64_t lastAllocations = 0;
+	inline uint64_t intervalAllocations = 0;
+	inline uint64_t steadyAllocations = 0;
+	inline uint64_t worstFrame = 0;
+
+	//call at the top of the frame, nothing from the previous frame's arena survives it
+	inline void beginFrame() {
+		frame.reset();
+	}
+
+	inline void endFrame() {
+		uint64_t now = HeapCounter::allocations.load(std::memory_order_relaxed);
+		uint64_t allocations = now - lastAllocations;
+		lastAllocations = now;
+		frames++;
+		intervalAllocations += allocations;
+		if (frames > warmupFrames) {
+			steadyAllocations += allocations;
+			worstFrame = std::max(worstFrame, allocations);
+		}
+		if (reportInterval > 0 && frames % reportInterval == 0) {
+			std::cout << "FRAME_MEMORY frame " << frames << ": " << (double)intervalAllocations / reportInterval
+				<< " heap allocations per frame, frame arena " << frame.highWaterBytes() << " bytes high water" << std::endl;
+			intervalAllocations = 0;
+		}
+	}
+
+	inline void summary() {
+		if (frames <= warmupFrames) return;
+		uint64_t counted = frames - warmupFrames;
+		std::cout << "FRAME_MEMORY " << (double)steadyAllocations / counted << " heap allocations per frame after "
+			<< warmupFrames << " warmup frames, worst " << worstFrame << ", frame arena " << frame.highWaterBytes()
+			<< " of " << frame.bytesReserved() << " bytes" << std::endl;
+	}
+}
+
+//arena accounting through allocate, mark, rewind and reset, and that blocks are kept and
+//handed out again rather than allocated anew
+inline bool selfTestFrameMemory() {
+	bool passed = true;
+	auto check = [&passed](bool condition, const char* what) {
+		if (!condition) {
+			std::cout << "ERROR::FRAME_MEMORY::SELFTEST " << what << std::endl;
+			passed = false;
+		}
+	};
+
+	//explicit alignments, so block sizes do not depend on the platform's max_align_t
+	LinearArena arena(1024);
+	char* a = (char*)arena.allocate(100, 16);
+	check(arena.bytesUsed() == 100 && arena.highWaterBytes() == 100 && arena.bytesReserved() == 1024, "first allocation");
+	LinearArena::Marker marker = arena.mark();
+	char* b = (char*)arena.allocate(200, 16);
+	check(((uintptr_t)b & 15) == 0 && b >= a + 100, "alignment");
+	check(arena.bytesUsed() == 300 && arena.highWaterBytes() == 300, "used after second allocation");
+	arena.rewind(marker);
+	check(arena.bytesUsed() == 100 && arena.highWaterBytes() == 300, "rewind keeps the high water mark");
+	check(arena.allocate(200, 16) == b, "rewound memory handed out again");
+
+	//does not fit behind b, so it opens a second block of the arena's block size
+	char* c = (char*)arena.allocate(900, 16);
+	check(arena.bytesReserved() == 2048 && arena.bytesUsed() == 1200, "second block");
+	{
+		ArenaMarker scope(arena);
+		arena.allocate(50, 16);
+		check(arena.bytesUsed() == 1250, "used inside a scope");
+	}
+	check(arena.bytesUsed() == 1200 && arena.highWaterBytes() == 1250, "scope rewound");
+
+	arena.reset();
+	check(arena.bytesUsed() == 0 && arena.highWaterBytes() == 1250 && arena.bytesReserved() == 2048, "reset");
+	//a warm arena serves containers and the same sequence again without reaching the heap, and
+	//the sequence lands where it did before
+	uint64_t heapBefore = HeapCounter::allocations.load();
+	{
+		ArenaMarker scope(arena);
+		ArenaVector<int> values{ ArenaAllocator<int>(arena) };
+		for (int i = 0; i < 32; i++) values.push_back(i);
+		check(values[31] == 31 && arena.bytesUsed() >= 32 * sizeof(int), "vector in the arena");
+	}
+	bool same = arena.allocate(100, 16) == a && arena.allocate(200, 16) == b && arena.allocate(900, 16) == c;
+	check(same && arena.bytesReserved() == 2048, "blocks reused after reset");
+	check(HeapCounter::allocations.load() == heapBefore, "heap untouched by a warm arena");
+
+	//bigger than a block, gets a block of its own
+	arena.allocate(4096, 16);
+	check(arena.bytesReserved() == 2048 + 4096 + 16, "oversized block");
+
+	FrameMemory::frame.allocate(64);
+	FrameMemory::beginFrame();
+	check(FrameMemory::frame.bytesUsed() == 0, "frame arena reset by beginFrame");
+
+	std::cout << "SELFTEST frame-memory: " << (passed ? "passed" : "FAILED") << std::endl;
+	return passed;
+}
+
+#endif
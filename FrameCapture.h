@@ -0,0 +1,295 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <iostream>
+#include "Framebuffer.h"
+#include "Png.h"
+
+
+//what FrameCapture writes
+enum class CaptureFormat {
+	PNG_SEQUENCE,
+	Y4M,
+};
+
+//reads frames back through a ring of pixel pack buffers: glReadPixels into a buffer returns
+//at once, and the buffer is only mapped ring size frames later when its fence has long since
+//signalled. mapped pixels are copied out and handed to a writer thread that encodes them.
+//an empty path encodes but discards, which measures capture without the disk
+class FrameCapture {
+public:
+	struct Stats {
+		size_t captured = 0;
+		size_t written = 0;
+		//times a map had to wait on its fence, or capture had to wait on the writer
+		size_t fenceWaits = 0;
+		size_t writerWaits = 0;
+		double readbackMs = 0.0;
+		double encodeMs = 0.0;
+		size_t bytesWritten = 0;
+	};
+
+	int width;
+	int height;
+	CaptureFormat format;
+	std::string path;
+	int ringSize;
+	//frames waiting for the writer before capture blocks
+	size_t maxQueued = 8;
+
+	FrameCapture(int width, int height, CaptureFormat format, const std::string& path, int ringSize = 3)
+		: width(width), height(height), format(format), path(path), ringSize(std::max(1, ringSize))
+	{
+		frameBytes = (size_t)width * height * 4;
+		buffers.resize(this->ringSize);
+		fences.assign(this->ringSize, NULL);
+		glGenBuffers(this->ringSize, buffers.data());
+		for (unsigned int buffer : buffers) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+			glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, NULL, GL_STREAM_READ);
+			GpuMemory::track(GpuMemory::BUFFER, buffer, frameBytes, "capture readback");
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		writer = std::thread(&FrameCapture::writerLoop, this);
+	}
+	~FrameCapture() {
+		finish();
+		for (unsigned int buffer : buffers) GpuMemory::destroy(GpuMemory::BUFFER, buffer);
+	}
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator=(const FrameCapture&) = delete;
+
+	//queues a read of the color attachment of framebuffer (0 = window) and retires the
+	//capture from ring size frames ago
+	void capture(unsigned int framebuffer = 0) {
+		int slot = (int)(issued % ringSize);
+		if (fences[slot] != NULL) retire(slot);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[slot]);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+		fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		issued++;
+	}
+
+	//capture for a source whose size may differ from the capture's, such as a window that was
+	//resized while recording. it is scaled into a target of the capture size first, so every
+	//frame of the file keeps the size it started with
+	void captureScaled(unsigned int framebuffer, int sourceWidth, int sourceHeight) {
+		if (sourceWidth == width && sourceHeight == height) {
+			capture(framebuffer);
+			return;
+		}
+		if (!scaled) scaled.reset(new Framebuffer(width, height));
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, scaled->ID);
+		glBlitFramebuffer(0, 0, sourceWidth, sourceHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		capture(scaled->ID);
+	}
+
+	//retires every outstanding read, waits for the writer to drain and stops it
+	void finish() {
+		if (!writer.joinable()) return;
+		for (uint64_t i = 0; i < (uint64_t)ringSize; i++) {
+			int slot = (int)((issued + i) % ringSize);
+			if (fences[slot] != NULL) retire(slot);
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		writer.join();
+	}
+
+	Stats stats() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return counters;
+	}
+	void report(const std::string& label) {
+		Stats s = stats();
+		std::cout << "CAPTURE " << label << ": " << s.captured << " frames read back, " << s.written << " encoded, "
+			<< s.fenceWaits << " fence waits, " << s.writerWaits << " writer waits, readback "
+			<< (s.captured ? s.readbackMs / s.captured : 0.0) << " ms/frame, encode "
+			<< (s.written ? s.encodeMs / s.written : 0.0) << " ms/frame, " << s.bytesWritten / (1024 * 1024) << " MiB" << std::endl;
+	}
+
+private:
+	std::vector<unsigned int> buffers;
+	std::vector<GLsync> fences;
+	size_t frameBytes;
+	//created on the first captureScaled with a different size
+	std::unique_ptr<Framebuffer> scaled;
+	uint64_t issued = 0;
+
+	std::thread writer;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable drained;
+	std::deque<std::vector<uint8_t>> queue;
+	//returned by the writer so frames are not reallocated every capture
+	std::vector<std::vector<uint8_t>> spare;
+	bool stopping = false;
+	Stats counters;
+
+	void retire(int slot) {
+		auto start = std::chrono::high_resolution_clock::now();
+		bool waited = false;
+		if (glClientWaitSync(fences[slot], 0, 0) == GL_TIMEOUT_EXPIRED) {
+			waited = true;
+			glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 5000000000ull);
+		}
+		glDeleteSync(fences[slot]);
+		fences[slot] = NULL;
+
+		std::vector<uint8_t> frame;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			if (queue.size() >= maxQueued) {
+				counters.writerWaits++;
+				drained.wait(lock, [&]() { return queue.size() < maxQueued; });
+			}
+			if (!spare.empty()) {
+				frame.swap(spare.back());
+				spare.pop_back();
+			}
+		}
+		frame.resize(frameBytes);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[slot]);
+		void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+		if (pixels != NULL) {
+			std::memcpy(frame.data(), pixels, frameBytes);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		else {
+			std::cout << "ERROR::CAPTURE::MAP_FAILED" << std::endl;
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		auto end = std::chrono::high_resolution_clock::now();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			counters.captured++;
+			counters.fenceWaits += waited ? 1 : 0;
+			counters.readbackMs += std::chrono::duration<double, std::milli>(end - start).count();
+			queue.push_back(std::move(frame));
+		}
+		wake.notify_one();
+	}
+
+	void writerLoop() {
+		FILE* video = NULL;
+		if (format == CaptureFormat::Y4M && !path.empty()) {
+			video = fopen(path.c_str(), "wb");
+			if (video == NULL) std::cout << "ERROR::CAPTURE::FILE_NOT_OPENED " << path << std::endl;
+			else fprintf(video, "YUV4MPEG2 W%d H%d F60:1 Ip A1:1 C420jpeg\n", width, height);
+		}
+		std::vector<uint8_t> encoded;
+		uint64_t index = 0;
+		while (true) {
+			std::vector<uint8_t> frame;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&]() { return stopping || !queue.empty(); });
+				if (queue.empty()) break;
+				frame = std::move(queue.front());
+				queue.pop_front();
+			}
+			drained.notify_one();
+
+			auto start = std::chrono::high_resolution_clock::now();
+			if (format == CaptureFormat::PNG_SEQUENCE) {
+				Png::encode(frame.data(), width, height, encoded);
+			}
+			else {
+				encodeY4MFrame(frame.data(), encoded);
+			}
+			size_t bytes = 0;
+			if (format == CaptureFormat::PNG_SEQUENCE && !path.empty()) {
+				char name[32];
+				snprintf(name, sizeof(name), "_%06llu.png", (unsigned long long)index);
+				FILE* file = fopen((path + name).c_str(), "wb");
+				if (file != NULL) {
+					bytes = fwrite(encoded.data(), 1, encoded.size(), file);
+					fclose(file);
+				}
+				else {
+					std::cout << "ERROR::CAPTURE::FILE_NOT_OPENED " << path + name << std::endl;
+				}
+			}
+			else if (video != NULL) {
+				bytes = fwrite(encoded.data(), 1, encoded.size(), video);
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+			index++;
+
+			std::lock_guard<std::mutex> lock(mutex);
+			counters.written++;
+			counters.encodeMs += std::chrono::duration<double, std::milli>(end - start).count();
+			counters.bytesWritten += bytes;
+			spare.push_back(std::move(frame));
+		}
+		if (video != NULL) fclose(video);
+	}
+
+	//"FRAME" then full resolution Y and quarter resolution Cb and Cr planes, full range BT.601
+	//to match C420jpeg, with rows flipped to top down
+	void encodeY4MFrame(const uint8_t* rgba, std::vector<uint8_t>& out) const {
+		const char* tag = "FRAME\n";
+		size_t lumaBytes = (size_t)width * height;
+		int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+		size_t chromaBytes = (size_t)chromaWidth * chromaHeight;
+		out.resize(6 + lumaBytes + chromaBytes * 2);
+		std::memcpy(out.data(), tag, 6);
+		uint8_t* luma = out.data() + 6;
+		uint8_t* cb = luma + lumaBytes;
+		uint8_t* cr = cb + chromaBytes;
+		for (int y = 0; y < height; y++) {
+			const uint8_t* row = rgba + (size_t)width * 4 * (height - 1 - y);
+			for (int x = 0; x < width; x++) {
+				const uint8_t* p = row + x * 4;
+				luma[(size_t)y * width + x] = (uint8_t)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+			}
+		}
+		for (int y = 0; y < chromaHeight; y++) {
+			for (int x = 0; x < chromaWidth; x++) {
+				//average the 2x2 block, clamped at odd edges
+				int r = 0, g = 0, b = 0;
+				for (int dy = 0; dy < 2; dy++) {
+					int sy = std::min(height - 1, y * 2 + dy);
+					const uint8_t* row = rgba + (size_t)width * 4 * (height - 1 - sy);
+					for (int dx = 0; dx < 2; dx++) {
+						const uint8_t* p = row + std::min(width - 1, x * 2 + dx) * 4;
+						r += p[0];
+						g += p[1];
+						b += p[2];
+					}
+				}
+				r /= 4; g /= 4; b /= 4;
+				cb[(size_t)y * chromaWidth + x] = (uint8_t)std::min(255, std::max(0, 128 + ((-43 * r - 85 * g + 128 * b) >> 8)));
+				cr[(size_t)y * chromaWidth + x] = (uint8_t)std::min(255, std::max(0, 128 + ((128 * r - 107 * g - 21 * b) >> 8)));
+			}
+		}
+	}
+};
+
+#endif
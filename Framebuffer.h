@@ -0,0 +1,99 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <glad/glad.h>
+
+#include <iostream>
+#include "Texture.h"
+
+
+//offscreen render target with an RGBA8 color texture and a 32 bit float depth texture.
+//unlike the window's depth buffer the depth texture can be sampled, which Hi-Z needs
+class Framebuffer {
+public:
+	unsigned int ID = 0;
+	unsigned int colorTexture = 0;
+	unsigned int depthTexture = 0;
+	int width = 0;
+	int height = 0;
+
+	Framebuffer(int width, int height) {
+		create(width, height);
+	}
+	~Framebuffer() {
+		destroy();
+	}
+	Framebuffer(const Framebuffer&) = delete;
+	Framebuffer& operator=(const Framebuffer&) = delete;
+
+	//attachments are immutable storage when available, so resizing recreates them
+	void resize(int newWidth, int newHeight) {
+		if (newWidth == width && newHeight == height) return;
+		destroy();
+		create(newWidth, newHeight);
+	}
+
+	void bind() {
+		glBindFramebuffer(GL_FRAMEBUFFER, ID);
+		glViewport(0, 0, width, height);
+	}
+	static void unbind() {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	//copies the color attachment to the window, stretched to its size
+	void blitToScreen(int screenWidth, int screenHeight, GLenum filter = GL_LINEAR) {
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, ID);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, width, height, 0, 0, screenWidth, screenHeight, GL_COLOR_BUFFER_BIT, filter);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+private:
+	void create(int w, int h) {
+		width = w;
+		height = h;
+		colorTexture = makeTexture(GL_RGBA8);
+		depthTexture = makeTexture(GL_DEPTH_COMPONENT32F);
+
+		glGenFramebuffers(1, &ID);
+		glBindFramebuffer(GL_FRAMEBUFFER, ID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+			std::cout << "ERROR::FRAMEBUFFER::NOT_COMPLETE" << std::endl;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+	void destroy() {
+		glDeleteFramebuffers(1, &ID);
+		GpuMemory::destroy(GpuMemory::TEXTURE, colorTexture);
+		GpuMemory::destroy(GpuMemory::TEXTURE, depthTexture);
+		ID = colorTexture = depthTexture = 0;
+	}
+
+	unsigned int makeTexture(GLenum internalFormat) {
+		unsigned int texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		if (glTexStorage2D != NULL) {
+			glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, width, height);
+		}
+		else if (internalFormat == GL_DEPTH_COMPONENT32F) {
+			glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+		}
+		else {
+			glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+		//depth is read with texelFetch, nearest keeps the texture complete without mips
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		GpuMemory::track(GpuMemory::TEXTURE, texture, textureStorageBytes(width, height, 1, 1, internalFormat), "framebuffer");
+		return texture;
+	}
+};
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef GL_CAPABILITIES_H
+#define GL_CAPABILITIES_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+#include <iostream>
+#include "GLFunctions.h"
+#include "GLLoader.h"
+
+
+//glad.c was generated without extensions, these are the ones the renderer's fast paths use.
+//declared the way glad declares its own so call sites read the same
+#ifndef GL_ARB_bindless_texture
+#define GL_ARB_bindless_texture 1
+typedef GLuint64(APIENTRYP PFNGLGETTEXTUREHANDLEARBPROC)(GLuint texture);
+typedef GLuint64(APIENTRYP PFNGLGETTEXTURESAMPLERHANDLEARBPROC)(GLuint texture, GLuint sampler);
+typedef void (APIENTRYP PFNGLMAKETEXTUREHANDLERESIDENTARBPROC)(GLuint64 handle);
+typedef void (APIENTRYP PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC)(GLuint64 handle);
+typedef GLboolean(APIENTRYP PFNGLISTEXTUREHANDLERESIDENTARBPROC)(GLuint64 handle);
+typedef void (APIENTRYP PFNGLUNIFORMHANDLEUI64ARBPROC)(GLint location, GLuint64 value);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORMHANDLEUI64ARBPROC)(GLuint program, GLint location, GLuint64 value);
+#endif
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+#endif
+#ifndef GL_ARB_parallel_shader_compile
+#define GL_ARB_parallel_shader_compile 1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSARBPROC)(GLuint count);
+#endif
+
+inline int GLAD_GL_KHR_debug = 0;
+inline int GLAD_GL_ARB_direct_state_access = 0;
+inline int GLAD_GL_ARB_buffer_storage = 0;
+inline int GLAD_GL_ARB_multi_draw_indirect = 0;
+inline int GLAD_GL_ARB_indirect_parameters = 0;
+inline int GLAD_GL_ARB_shader_draw_parameters = 0;
+inline int GLAD_GL_ARB_clip_control = 0;
+inline int GLAD_GL_ARB_bindless_texture = 0;
+inline int GLAD_GL_KHR_parallel_shader_compile = 0;
+inline int GLAD_GL_ARB_parallel_shader_compile = 0;
+
+inline PFNGLGETTEXTUREHANDLEARBPROC glad_glGetTextureHandleARB = NULL;
+#define glGetTextureHandleARB glad_glGetTextureHandleARB
+inline PFNGLGETTEXTURESAMPLERHANDLEARBPROC glad_glGetTextureSamplerHandleARB = NULL;
+#define glGetTextureSamplerHandleARB glad_glGetTextureSamplerHandleARB
+inline PFNGLMAKETEXTUREHANDLERESIDENTARBPROC glad_glMakeTextureHandleResidentARB = NULL;
+#define glMakeTextureHandleResidentARB glad_glMakeTextureHandleResidentARB
+inline PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC glad_glMakeTextureHandleNonResidentARB = NULL;
+#define glMakeTextureHandleNonResidentARB glad_glMakeTextureHandleNonResidentARB
+inline PFNGLISTEXTUREHANDLERESIDENTARBPROC glad_glIsTextureHandleResidentARB = NULL;
+#define glIsTextureHandleResidentARB glad_glIsTextureHandleResidentARB
+inline PFNGLUNIFORMHANDLEUI64ARBPROC glad_glUniformHandleui64ARB = NULL;
+#define glUniformHandleui64ARB glad_glUniformHandleui64ARB
+inline PFNGLPROGRAMUNIFORMHANDLEUI64ARBPROC glad_glProgramUniformHandleui64ARB = NULL;
+#define glProgramUniformHandleui64ARB glad_glProgramUniformHandleui64ARB
+inline PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glad_glMaxShaderCompilerThreadsKHR = NULL;
+#define glMaxShaderCompilerThreadsKHR glad_glMaxShaderCompilerThreadsKHR
+
+
+//what the context can do and the tier that sums it up. extensions that became core are
+//loaded into the core entry points, so checks such as glClipControl != NULL, GLResources'
+//dsaAvailable and GpuCuller's draw count pick them up on older contexts without changes
+namespace GLCapabilities {
+
+	//each tier includes everything below it
+	enum Tier {
+		//3.3 core: bind-to-edit, one draw call per mesh
+		TIER_GL33,
+		//compute shaders, storage buffers and multi-draw indirect: GPU culling, vertex pulling, Hi-Z
+		TIER_GPU_DRIVEN,
+		//persistent mapped buffers, DSA and a GPU side draw count: the approaching-zero-driver-overhead set
+		TIER_AZDO,
+		//plus bindless textures, no texture binds between draws
+		TIER_AZDO_BINDLESS
+	};
+
+	struct Capabilities {
+		int major = 0;
+		int minor = 0;
+		bool computeShaders = false;
+		bool multiDrawIndirect = false;
+		bool drawCount = false;
+		bool shaderDrawParameters = false;
+		bool persistentMapping = false;
+		bool directStateAccess = false;
+		bool clipControl = false;
+		bool bindlessTexture = false;
+		bool parallelShaderCompile = false;
+		bool debugOutput = false;
+		Tier tier = TIER_GL33;
+	};
+
+	inline Capabilities current;
+
+	inline const char* tierName(Tier tier) {
+		switch (tier) {
+		case TIER_GPU_DRIVEN: return "GPU_DRIVEN";
+		case TIER_AZDO: return "AZDO";
+		case TIER_AZDO_BINDLESS: return "AZDO_BINDLESS";
+		default: return "GL33";
+		}
+	}
+
+	//newest first, glfwCreateWindow fails for versions the driver does not have. macOS stops at 4.1
+	inline const int contextVersions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 4 }, { 4, 3 }, { 4, 2 }, { 4, 1 }, { 4, 0 }, { 3, 3 } };
+
+	//the newest core context down to minMajor.minMinor, with the other hints already set.
+	//NULL when not even the minimum can be created
+	inline GLFWwindow* createHighestContext(int width, int height, const char* title, int minMajor, int minMinor) {
+		for (const int* version : contextVersions) {
+			if (version[0] * 10 + version[1] < minMajor * 10 + minMinor) break;
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version[0]);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version[1]);
+			GLFWwindow* window = glfwCreateWindow(width, height, title, NULL, NULL);
+			if (window != NULL) return window;
+		}
+		return NULL;
+	}
+
+	//sets a glad core entry point the context lacks from the extension that was promoted to it
+	inline bool promote(const char* core, const char* extension) {
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			if (std::strcmp(glFunctionNames[id], core) != 0) continue;
+			void* function = GLLoader::loadProc(extension);
+			if (function == NULL) return false;
+#define GL_FUNCTION(name, type) \
+			case GLID_##name: \
+				if (glad_##name == NULL) glad_##name = (type)function; \
+				return true;
+			switch (id) {
+				GL_FUNCTION_LIST
+			}
+#undef GL_FUNCTION
+		}
+		return false;
+	}
+
+	//every 4.5 entry point of ARB_direct_state_access, the rest of 4.5 came from other extensions
+	inline bool isDirectStateAccess(int id) {
+		static const char* const others[] = {
+			"glClipControl", "glMemoryBarrierByRegion", "glGetTextureSubImage", "glGetCompressedTextureSubImage",
+			"glGetGraphicsResetStatus", "glReadnPixels", "glTextureBarrier"
+		};
+		if (glFunctionVersions[id] != 45 || std::strncmp(glFunctionNames[id], "glGetn", 6) == 0) return false;
+		for (const char* other : others) if (std::strcmp(glFunctionNames[id], other) == 0) return false;
+		return true;
+	}
+
+	//call after GLLoader::load, before anything is installed over the glad pointers
+	inline const Capabilities& detect() {
+		Capabilities& caps = current;
+		caps = Capabilities();
+		caps.major = GLVersion.major;
+		caps.minor = GLVersion.minor;
+
+		GLAD_GL_KHR_debug = GLLoader::hasExtension("GL_KHR_debug");
+		GLAD_GL_ARB_direct_state_access = GLLoader::hasExtension("GL_ARB_direct_state_access");
+		GLAD_GL_ARB_buffer_storage = GLLoader::hasExtension("GL_ARB_buffer_storage");
+		GLAD_GL_ARB_multi_draw_indirect = GLLoader::hasExtension("GL_ARB_multi_draw_indirect");
+		GLAD_GL_ARB_indirect_parameters = GLLoader::hasExtension("GL_ARB_indirect_parameters");
+		GLAD_GL_ARB_shader_draw_parameters = GLLoader::hasExtension("GL_ARB_shader_draw_parameters");
+		GLAD_GL_ARB_clip_control = GLLoader::hasExtension("GL_ARB_clip_control");
+		GLAD_GL_ARB_bindless_texture = GLLoader::hasExtension("GL_ARB_bindless_texture");
+		GLAD_GL_KHR_parallel_shader_compile = GLLoader::hasExtension("GL_KHR_parallel_shader_compile");
+		GLAD_GL_ARB_parallel_shader_compile = GLLoader::hasExtension("GL_ARB_parallel_shader_compile");
+
+		//same names as the core functions for these, different ones for indirect parameters
+		if (GLAD_GL_ARB_direct_state_access && !GLAD_GL_VERSION_4_5) {
+			for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+				if (isDirectStateAccess(id)) promote(glFunctionNames[id], glFunctionNames[id]);
+			}
+		}
+		if (GLAD_GL_KHR_debug && !GLAD_GL_VERSION_4_3) {
+			static const char* const debug[] = {
+				"glDebugMessageControl", "glDebugMessageInsert", "glDebugMessageCallback", "glGetDebugMessageLog",
+				"glPushDebugGroup", "glPopDebugGroup", "glObjectLabel", "glGetObjectLabel"
+			};
+			for (const char* name : debug) promote(name, name);
+		}
+		if (GLAD_GL_ARB_buffer_storage && !GLAD_GL_VERSION_4_4) promote("glBufferStorage", "glBufferStorage");
+		if (GLAD_GL_ARB_multi_draw_indirect && !GLAD_GL_VERSION_4_3) {
+			promote("glMultiDrawArraysIndirect", "glMultiDrawArraysIndirect");
+			promote("glMultiDrawElementsIndirect", "glMultiDrawElementsIndirect");
+		}
+		if (GLAD_GL_ARB_indirect_parameters && !GLAD_GL_VERSION_4_6) {
+			promote("glMultiDrawArraysIndirectCount", "glMultiDrawArraysIndirectCountARB");
+			promote("glMultiDrawElementsIndirectCount", "glMultiDrawElementsIndirectCountARB");
+		}
+		if (GLAD_GL_ARB_clip_control && !GLAD_GL_VERSION_4_5) promote("glClipControl", "glClipControl");
+
+		if (GLAD_GL_ARB_bindless_texture) {
+			glad_glGetTextureHandleARB = (PFNGLGETTEXTUREHANDLEARBPROC)GLLoader::loadProc("glGetTextureHandleARB");
+			glad_glGetTextureSamplerHandleARB = (PFNGLGETTEXTURESAMPLERHANDLEARBPROC)GLLoader::loadProc("glGetTextureSamplerHandleARB");
+			glad_glMakeTextureHandleResidentARB = (PFNGLMAKETEXTUREHANDLERESIDENTARBPROC)GLLoader::loadProc("glMakeTextureHandleResidentARB");
+			glad_glMakeTextureHandleNonResidentARB = (PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC)GLLoader::loadProc("glMakeTextureHandleNonResidentARB");
+			glad_glIsTextureHandleResidentARB = (PFNGLISTEXTUREHANDLERESIDENTARBPROC)GLLoader::loadProc("glIsTextureHandleResidentARB");
+			glad_glUniformHandleui64ARB = (PFNGLUNIFORMHANDLEUI64ARBPROC)GLLoader::loadProc("glUniformHandleui64ARB");
+			glad_glProgramUniformHandleui64ARB = (PFNGLPROGRAMUNIFORMHANDLEUI64ARBPROC)GLLoader::loadProc("glProgramUniformHandleui64ARB");
+		}
+		//the ARB variant takes the same argument
+		if (GLAD_GL_KHR_parallel_shader_compile) {
+			glad_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)GLLoader::loadProc("glMaxShaderCompilerThreadsKHR");
+		}
+		else if (GLAD_GL_ARB_parallel_shader_compile) {
+			glad_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)GLLoader::loadProc("glMaxShaderCompilerThreadsARB");
+		}
+
+		caps.computeShaders = GLAD_GL_VERSION_4_3 != 0;
+		caps.multiDrawIndirect = glMultiDrawArraysIndirect != NULL && glMultiDrawElementsIndirect != NULL;
+		caps.drawCount = glMultiDrawArraysIndirectCount != NULL && glMultiDrawElementsIndirectCount != NULL;
+		caps.shaderDrawParameters = GLAD_GL_VERSION_4_6 || GLAD_GL_ARB_shader_draw_parameters;
+		caps.persistentMapping = glBufferStorage != NULL;
+		caps.directStateAccess = glCreateBuffers != NULL && glNamedBufferStorage != NULL && glCreateVertexArrays != NULL;
+		caps.clipControl = glClipControl != NULL;
+		caps.bindlessTexture = glGetTextureHandleARB != NULL && glMakeTextureHandleResidentARB != NULL;
+		caps.parallelShaderCompile = glMaxShaderCompilerThreadsKHR != NULL;
+		caps.debugOutput = glDebugMessageCallback != NULL;
+
+		if (caps.computeShaders && caps.multiDrawIndirect) {
+			caps.tier = TIER_GPU_DRIVEN;
+			if (caps.persistentMapping && caps.directStateAccess && caps.drawCount && caps.shaderDrawParameters) {
+				caps.tier = caps.bindlessTexture ? TIER_AZDO_BINDLESS : TIER_AZDO;
+			}
+		}
+
+		//let the driver compile on as many threads as it likes, links finish in the background
+		if (caps.parallelShaderCompile) glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+		return caps;
+	}
+
+	inline void report() {
+		const Capabilities& caps = current;
+		auto yes = [](bool value) { return value ? "yes" : "no"; };
+		std::cout << "GL_CAPABILITIES OpenGL " << caps.major << "." << caps.minor << " " << glGetString(GL_RENDERER)
+			<< ", tier " << tierName(caps.tier) << std::endl;
+		std::cout << "  compute " << yes(caps.computeShaders) << ", multi-draw indirect " << yes(caps.multiDrawIndirect)
+			<< ", draw count " << yes(caps.drawCount) << ", draw parameters " << yes(caps.shaderDrawParameters)
+			<< ", persistent mapping " << yes(caps.persistentMapping) << ", DSA " << yes(caps.directStateAccess)
+			<< ", clip control " << yes(caps.clipControl) << ", bindless " << yes(caps.bindlessTexture)
+			<< ", parallel compile " << yes(caps.parallelShaderCompile) << ", debug output " << yes(caps.debugOutput) << std::endl;
+	}
+}
+
+#endif
@@ -0,0 +1,539 @@
+#ifndef GL_CAPTURE_H
+#define GL_CAPTURE_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <iostream>
+#include "GLFunctions.h"
+
+
+//records the GL command stream of the first frames of a run, with the data every call reads
+//through a pointer, into a file GLReplay.h plays back without the app. capture starts at
+//install() so the file holds every object the frames use from its creation on.
+//
+//file: "GLCAPTUR", then varints: version, GL major, GL minor, width, height, function count,
+//and per function its name and argument spec. then commands, each the function's index in
+//that table followed by its encoded arguments; index == function count ends a frame,
+//function count + 1 ends the file and function count + 2 is a write through a persistent
+//mapping: the mapping's index in map order, the offset into it and the bytes. frame 0 is
+//everything before endSetup()
+namespace GLCapture {
+
+	const char MAGIC[8] = { 'G', 'L', 'C', 'A', 'P', 'T', 'U', 'R' };
+	const uint64_t VERSION = 2;
+
+	//how each argument is encoded, one character per parameter, then ':' and the result kind
+	//for results that matter to later calls:
+	//  v value, o pointer used as a buffer offset
+	//  b t a p s f q r object name: buffer, texture, vertex array, program, shader, framebuffer,
+	//                  query, renderbuffer. names are remapped on replay
+	//  B T A F Q R     array of names the call reads, its length is the previous argument
+	//  +b +t ...       array of names the call creates, its length is the previous argument
+	//  d               data the call reads, its size comes from payloadSize()
+	//  x               memory the call writes, replay hands it scratch memory
+	//  z               zero terminated string, S array of strings with previous argument count
+	//  n               pointer replayed as NULL
+	//  u               uniform location, y sync object
+	//  result m        mapped pointer, the data written through it is captured at unmap, or for
+	//                  persistent mappings before every call that can read buffers
+	//entry points missing here capture values as they are and pointers as offsets
+	struct SpecEntry {
+		const char* name;
+		const char* spec;
+	};
+	inline const SpecEntry specTable[] = {
+		{ "glBindBuffer", "vb" }, { "glBindBufferBase", "vvb" }, { "glBindBufferRange", "vvbvv" },
+		{ "glBindVertexArray", "a" }, { "glBindTexture", "vt" }, { "glBindFramebuffer", "vf" },
+		{ "glBindRenderbuffer", "vr" }, { "glBindImageTexture", "vtvvvvv" }, { "glBindVertexBuffer", "vbvv" },
+		{ "glUseProgram", "p" },
+		{ "glGenBuffers", "v+b" }, { "glGenVertexArrays", "v+a" }, { "glGenTextures", "v+t" },
+		{ "glGenFramebuffers", "v+f" }, { "glGenQueries", "v+q" }, { "glGenRenderbuffers", "v+r" },
+		{ "glCreateBuffers", "v+b" }, { "glCreateVertexArrays", "v+a" }, { "glCreateTextures", "vv+t" },
+		{ "glCreateFramebuffers", "v+f" },
+		{ "glDeleteBuffers", "vB" }, { "glDeleteVertexArrays", "vA" }, { "glDeleteTextures", "vT" },
+		{ "glDeleteFramebuffers", "vF" }, { "glDeleteQueries", "vQ" }, { "glDeleteRenderbuffers", "vR" },
+		{ "glCreateShader", "v:s" }, { "glCreateProgram", ":p" }, { "glShaderSource", "svSn" },
+		{ "glCompileShader", "s" }, { "glAttachShader", "ps" }, { "glLinkProgram", "p" },
+		{ "glDeleteShader", "s" }, { "glDeleteProgram", "p" },
+		{ "glGetShaderiv", "svx" }, { "glGetProgramiv", "pvx" }, { "glGetShaderInfoLog", "svxx" },
+		{ "glGetProgramInfoLog", "pvxx" }, { "glGetUniformLocation", "pz:u" },
+		{ "glUniform1i", "uv" }, { "glUniform2i", "uvv" }, { "glUniform3i", "uvvv" }, { "glUniform4i", "uvvvv" },
+		{ "glUniform1ui", "uv" }, { "glUniform2ui", "uvv" }, { "glUniform3ui", "uvvv" }, { "glUniform4ui", "uvvvv" },
+		{ "glUniform1f", "uv" }, { "glUniform2f", "uvv" }, { "glUniform3f", "uvvv" }, { "glUniform4f", "uvvvv" },
+		{ "glUniform1fv", "uvd" }, { "glUniform2fv", "uvd" }, { "glUniform3fv", "uvd" }, { "glUniform4fv", "uvd" },
+		{ "glUniform1iv", "uvd" }, { "glUniform2iv", "uvd" }, { "glUniform3iv", "uvd" }, { "glUniform4iv", "uvd" },
+		{ "glUniformMatrix3fv", "uvvd" }, { "glUniformMatrix4fv", "uvvd" },
+		{ "glBufferData", "vvdv" }, { "glBufferSubData", "vvvd" }, { "glBufferStorage", "vvdv" }, { "glNamedBufferStorage", "bvdv" },
+		{ "glNamedBufferSubData", "bvvd" }, { "glGetBufferSubData", "vvvx" }, { "glClearBufferData", "vvvvd" },
+		{ "glMapBufferRange", "vvvv:m" },
+		{ "glVertexAttribPointer", "vvvvvo" }, { "glVertexAttribIPointer", "vvvvo" },
+		{ "glDrawElements", "vvvo" }, { "glDrawElementsBaseVertex", "vvvov" }, { "glDrawArraysIndirect", "vo" },
+		{ "glMultiDrawArraysIndirect", "vovv" }, { "glMultiDrawArraysIndirectCount", "vovvv" },
+		{ "glVertexArrayVertexBuffer", "avbvv" }, { "glVertexArrayElementBuffer", "ab" },
+		{ "glVertexArrayAttribFormat", "avvvvv" }, { "glVertexArrayAttribBinding", "avv" },
+		{ "glEnableVertexArrayAttrib", "av" },
+		{ "glTexImage2D", "vvvvvvvvd" }, { "glTexSubImage2D", "vvvvvvvvd" }, { "glTexImage3D", "vvvvvvvvvd" },
+		{ "glTexSubImage3D", "vvvvvvvvvvd" }, { "glReadPixels", "vvvvvvx" },
+		{ "glPushDebugGroup", "vvvz" }, { "glFramebufferTexture2D", "vvvtv" }, { "glFramebufferTexture", "vvtv" }, { "glDrawBuffers", "vd" },
+		{ "glBeginQuery", "vq" }, { "glQueryCounter", "qv" }, { "glGetQueryObjectiv", "qvx" },
+		{ "glGetQueryObjectuiv", "qvx" }, { "glGetQueryObjectui64v", "qvx" },
+		{ "glFenceSync", "vv:y" }, { "glClientWaitSync", "yvv" }, { "glWaitSync", "yvv" }, { "glDeleteSync", "y" },
+		{ "glGetIntegerv", "vx" }, { "glGetInteger64v", "vx" }, { "glGetFloatv", "vx" }, { "glGetBooleanv", "vx" }
+	};
+
+	//object name kinds in the order replay keeps its name maps
+	const char* const NAME_SPACES = "btapsfqr";
+
+	//one parsed argument: kind is v o d x z S n u y, N for a name, A for a name array read,
+	//G for a name array created, P (replay only) for a pointer of an entry point without a
+	//spec. space indexes NAME_SPACES
+	struct ArgSpec {
+		char kind;
+		int space;
+	};
+
+	inline int nameSpace(char c) {
+		const char* found = std::strchr(NAME_SPACES, c);
+		return found != NULL && c != 0 ? (int)(found - NAME_SPACES) : -1;
+	}
+
+	//an argument kind that reads or writes memory needs a pointer parameter, a value kind must not have one
+	inline bool matchesSignature(int id, const std::vector<ArgSpec>& args) {
+		if ((int)args.size() != glArgumentCounts[id]) return false;
+		for (size_t i = 0; i < args.size(); i++) {
+			bool pointer = (glPointerMasks[id] >> i) & 1;
+			if (std::strchr("odxzSnAG", args[i].kind) && !pointer) return false;
+			if (std::strchr("vNu", args[i].kind) && pointer) return false;
+		}
+		return true;
+	}
+
+	//false on a character outside the spec language
+	inline bool parseSpec(const char* spec, std::vector<ArgSpec>& args, char& result) {
+		args.clear();
+		result = 0;
+		for (const char* c = spec; *c; c++) {
+			if (*c == ':') {
+				result = c[1];
+				return true;
+			}
+			if (std::strchr("vodxzSnuy", *c)) args.push_back({ *c, -1 });
+			else if (nameSpace(*c) >= 0) args.push_back({ 'N', nameSpace(*c) });
+			else if (*c >= 'A' && *c <= 'Z' && nameSpace(*c - 'A' + 'a') >= 0) args.push_back({ 'A', nameSpace(*c - 'A' + 'a') });
+			else if (*c == '+' && nameSpace(c[1]) >= 0) {
+				args.push_back({ 'G', nameSpace(c[1]) });
+				c++;
+			}
+			else return false;
+		}
+		return true;
+	}
+
+	//bytes per pixel of client memory in a format and type
+	inline size_t pixelBytes(GLenum format, GLenum type) {
+		switch (type) {
+		case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_5_5_5_1:
+			return 2;
+		case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV: case GL_UNSIGNED_INT_10_10_10_2:
+		case GL_UNSIGNED_INT_2_10_10_10_REV: case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV:
+		case GL_UNSIGNED_INT_5_9_9_9_REV:
+			return 4;
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+			return 8;
+		}
+		size_t components = 4;
+		switch (format) {
+		case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: components = 1; break;
+		case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL: components = 2; break;
+		case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER: components = 3; break;
+		}
+		size_t size = 4;
+		switch (type) {
+		case GL_UNSIGNED_BYTE: case GL_BYTE: size = 1; break;
+		case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: size = 2; break;
+		}
+		return components * size;
+	}
+
+	//client memory of a width x height x depth image, rows padded to alignment
+	inline size_t imageBytes(uint64_t width, uint64_t height, uint64_t depth, GLenum format, GLenum type, int alignment) {
+		if (width == 0 || height == 0 || depth == 0) return 0;
+		size_t row = (size_t)width * pixelBytes(format, type);
+		size_t stride = (row + alignment - 1) / alignment * alignment;
+		return stride * ((size_t)height * depth - 1) + row;
+	}
+
+	struct PixelState {
+		int packAlignment = 4;
+		int unpackAlignment = 4;
+		uint64_t packBuffer = 0;
+		uint64_t unpackBuffer = 0;
+	};
+
+	//bytes behind pointer argument arg of a call, 0 when unknown
+	inline size_t payloadSize(int id, const uint64_t* a, int arg, const PixelState& pixels) {
+		switch (id) {
+		case GLID_glBufferData: case GLID_glBufferStorage: case GLID_glNamedBufferStorage: return (size_t)a[1];
+		case GLID_glBufferSubData: case GLID_glNamedBufferSubData: case GLID_glGetBufferSubData: return (size_t)a[2];
+		case GLID_glUniform1fv: case GLID_glUniform1iv: return (size_t)a[1] * 4;
+		case GLID_glUniform2fv: case GLID_glUniform2iv: return (size_t)a[1] * 8;
+		case GLID_glUniform3fv: case GLID_glUniform3iv: return (size_t)a[1] * 12;
+		case GLID_glUniform4fv: case GLID_glUniform4iv: return (size_t)a[1] * 16;
+		case GLID_glUniformMatrix3fv: return (size_t)a[1] * 36;
+		case GLID_glUniformMatrix4fv: return (size_t)a[1] * 64;
+		case GLID_glDrawBuffers: return (size_t)a[0] * sizeof(GLenum);
+		case GLID_glClearBufferData: return pixelBytes((GLenum)a[2], (GLenum)a[3]);
+		case GLID_glTexImage2D: return imageBytes(a[3], a[4], 1, (GLenum)a[6], (GLenum)a[7], pixels.unpackAlignment);
+		case GLID_glTexSubImage2D: return imageBytes(a[4], a[5], 1, (GLenum)a[6], (GLenum)a[7], pixels.unpackAlignment);
+		case GLID_glTexImage3D: return imageBytes(a[3], a[4], a[5], (GLenum)a[7], (GLenum)a[8], pixels.unpackAlignment);
+		case GLID_glTexSubImage3D: return imageBytes(a[5], a[6], a[7], (GLenum)a[8], (GLenum)a[9], pixels.unpackAlignment);
+		case GLID_glReadPixels: return imageBytes(a[2], a[3], 1, (GLenum)a[4], (GLenum)a[5], pixels.packAlignment);
+		case GLID_glGetShaderInfoLog: case GLID_glGetProgramInfoLog: return arg == 3 ? (size_t)a[1] : sizeof(GLsizei);
+		case GLID_glGetQueryObjectui64v: return sizeof(GLuint64);
+		}
+		return 0;
+	}
+
+	//pixel transfers take an offset instead of a pointer while a pixel buffer is bound
+	inline bool pointerIsOffset(int id, const PixelState& pixels) {
+		switch (id) {
+		case GLID_glTexImage2D: case GLID_glTexSubImage2D: case GLID_glTexImage3D: case GLID_glTexSubImage3D:
+			return pixels.unpackBuffer != 0;
+		case GLID_glReadPixels:
+			return pixels.packBuffer != 0;
+		}
+		return false;
+	}
+
+	//calls that may read buffer memory, persistent mappings are brought up to date before them
+	inline bool readsBuffers(int id) {
+		switch (id) {
+		case GLID_glDrawArrays: case GLID_glDrawArraysInstanced: case GLID_glDrawArraysInstancedBaseInstance:
+		case GLID_glDrawArraysIndirect: case GLID_glMultiDrawArrays: case GLID_glMultiDrawArraysIndirect:
+		case GLID_glMultiDrawArraysIndirectCount: case GLID_glDrawElements: case GLID_glDrawElementsBaseVertex:
+		case GLID_glDrawElementsInstanced: case GLID_glDrawElementsInstancedBaseVertex:
+		case GLID_glDrawElementsInstancedBaseInstance: case GLID_glDrawElementsInstancedBaseVertexBaseInstance:
+		case GLID_glDrawRangeElements: case GLID_glDrawRangeElementsBaseVertex: case GLID_glDrawElementsIndirect:
+		case GLID_glMultiDrawElements: case GLID_glMultiDrawElementsBaseVertex: case GLID_glMultiDrawElementsIndirect:
+		case GLID_glMultiDrawElementsIndirectCount: case GLID_glDispatchCompute: case GLID_glDispatchComputeIndirect:
+		case GLID_glCopyBufferSubData: case GLID_glTexSubImage2D: case GLID_glTexSubImage3D:
+			return true;
+		}
+		return false;
+	}
+
+	inline void putVarint(std::vector<unsigned char>& out, uint64_t value) {
+		while (value >= 0x80) {
+			out.push_back((unsigned char)(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back((unsigned char)value);
+	}
+	inline void putBytes(std::vector<unsigned char>& out, const void* data, size_t size) {
+		putVarint(out, size);
+		const unsigned char* bytes = (const unsigned char*)data;
+		out.insert(out.end(), bytes, bytes + size);
+	}
+
+	//pointer arguments start with one of these
+	enum PointerTag : unsigned char { POINTER_NULL, POINTER_DATA, POINTER_OFFSET };
+
+
+	struct Mapping {
+		void* pointer = NULL;
+		uint64_t length = 0;
+		uint64_t access = 0;
+	};
+	//a persistent mapping stays valid across draws, so its writes are found by comparing the
+	//memory with what was last written to the file
+	struct PersistentMapping {
+		uint64_t index;
+		uint64_t buffer;
+		const unsigned char* pointer;
+		size_t length;
+		std::vector<unsigned char> written;
+	};
+
+	inline bool recording = false;
+	inline bool installed = false;
+	inline std::ofstream file;
+	inline std::string path;
+	inline std::vector<unsigned char> stream;
+	inline std::vector<std::vector<ArgSpec>> argSpecs(GL_FUNCTION_COUNT);
+	inline std::vector<char> resultSpecs(GL_FUNCTION_COUNT);
+	inline std::vector<bool> warned(GL_FUNCTION_COUNT);
+	inline PixelState pixels;
+	inline std::unordered_map<uint64_t, Mapping> mappings;
+	inline std::vector<unsigned char> unmapData;
+	inline std::vector<PersistentMapping> persistentMappings;
+	inline uint64_t persistentMapCount = 0;
+	//buffer last bound to each target, what a persistent mapping belongs to
+	inline std::unordered_map<uint64_t, uint64_t> boundBuffers;
+	inline uint64_t frames = 0;
+	inline uint64_t frameLimit = 0;
+	inline uint64_t commands = 0;
+	inline uint64_t bytesWritten = 0;
+
+	//writes the bytes of every persistent mapping that changed since it was last written, the
+	//first time the whole range
+	inline void syncPersistent() {
+		for (PersistentMapping& mapping : persistentMappings) {
+			size_t first = 0, last = mapping.length;
+			if (mapping.written.size() == mapping.length) {
+				while (first < last && mapping.pointer[first] == mapping.written[first]) first++;
+				while (last > first && mapping.pointer[last - 1] == mapping.written[last - 1]) last--;
+				if (first == last) continue;
+				std::memcpy(mapping.written.data() + first, mapping.pointer + first, last - first);
+			}
+			else {
+				mapping.written.assign(mapping.pointer, mapping.pointer + mapping.length);
+			}
+			putVarint(stream, GL_FUNCTION_COUNT + 2);
+			putVarint(stream, mapping.index);
+			putVarint(stream, first);
+			putBytes(stream, mapping.pointer + first, last - first);
+		}
+	}
+	inline void dropPersistent(uint64_t buffer) {
+		for (size_t i = 0; i < persistentMappings.size(); i++) {
+			if (persistentMappings[i].buffer != buffer) continue;
+			persistentMappings.erase(persistentMappings.begin() + i);
+			return;
+		}
+	}
+
+	//the mapped range of target is still readable before the real glUnmapBuffer runs
+	inline void beforeUnmap(uint64_t target) {
+		unmapData.clear();
+		auto bound = boundBuffers.find(target);
+		if (bound != boundBuffers.end()) {
+			for (const PersistentMapping& mapping : persistentMappings) {
+				if (mapping.buffer != bound->second) continue;
+				syncPersistent();
+				dropPersistent(bound->second);
+				return;
+			}
+		}
+		auto found = mappings.find(target);
+		if (found == mappings.end()) return;
+		if ((found->second.access & GL_MAP_WRITE_BIT) && found->second.pointer != NULL) {
+			const unsigned char* bytes = (const unsigned char*)found->second.pointer;
+			unmapData.assign(bytes, bytes + found->second.length);
+		}
+		mappings.erase(found);
+	}
+
+	inline void record(int id, const uint64_t* a, uint64_t result) {
+		const std::vector<ArgSpec>& args = argSpecs[id];
+		if (!warned[id] && args.empty() && glPointerMasks[id] != 0) {
+			warned[id] = true;
+			std::cout << "GL_CAPTURE " << glFunctionNames[id] << " has no argument spec, replay skips its calls with pointers" << std::endl;
+		}
+		//the file's function table has the same order as this build's ids
+		putVarint(stream, (uint64_t)id);
+		for (size_t i = 0; i < args.size(); i++) {
+			const ArgSpec& arg = args[i];
+			switch (arg.kind) {
+			case 'v': case 'o': case 'y':
+				putVarint(stream, a[i]);
+				break;
+			case 'N': case 'u':
+				putVarint(stream, (uint32_t)a[i]);
+				break;
+			case 'd': case 'x': {
+				if (pointerIsOffset(id, pixels)) {
+					stream.push_back(POINTER_OFFSET);
+					putVarint(stream, a[i]);
+				}
+				else if (a[i] == 0) {
+					stream.push_back(POINTER_NULL);
+				}
+				else if (arg.kind == 'd') {
+					stream.push_back(POINTER_DATA);
+					putBytes(stream, (const void*)(uintptr_t)a[i], payloadSize(id, a, (int)i, pixels));
+				}
+				else {
+					//only the size goes in the file, replay allocates it
+					stream.push_back(POINTER_DATA);
+					putVarint(stream, payloadSize(id, a, (int)i, pixels));
+				}
+				break;
+			}
+			case 'z': {
+				const char* text = (const char*)(uintptr_t)a[i];
+				putBytes(stream, text, std::strlen(text) + 1);
+				break;
+			}
+			case 'S': {
+				const char* const* strings = (const char* const*)(uintptr_t)a[i];
+				const GLint* lengths = (const GLint*)(uintptr_t)a[i + 1];
+				for (uint64_t s = 0; s < a[i - 1]; s++) {
+					size_t length = lengths != NULL && lengths[s] >= 0 ? (size_t)lengths[s] : std::strlen(strings[s]);
+					//stored zero terminated so replay can pass the file's memory straight through
+					std::string text(strings[s], length);
+					putBytes(stream, text.c_str(), length + 1);
+				}
+				break;
+			}
+			case 'A': case 'G': {
+				const GLuint* names = (const GLuint*)(uintptr_t)a[i];
+				for (uint64_t n = 0; n < a[i - 1]; n++) putVarint(stream, names[n]);
+				break;
+			}
+			}
+		}
+		if (args.empty()) {
+			for (int i = 0; i < glArgumentCounts[id]; i++) putVarint(stream, a[i]);
+		}
+
+		char kind = resultSpecs[id];
+		if (kind == 'y') putVarint(stream, result);
+		else if (kind == 'u' || nameSpace(kind) >= 0) putVarint(stream, (uint32_t)result);
+		else if (kind == 'm' && (a[3] & GL_MAP_PERSISTENT_BIT)) {
+			//counted even when failed or read only, replay numbers its persistent mappings the same way
+			uint64_t index = persistentMapCount++;
+			if (result != 0 && (a[3] & GL_MAP_WRITE_BIT)) {
+				persistentMappings.push_back({ index, boundBuffers[a[0]], (const unsigned char*)(uintptr_t)result, (size_t)a[2], {} });
+			}
+		}
+		else if (kind == 'm') mappings[a[0]] = { (void*)(uintptr_t)result, a[2], a[3] };
+
+		if (id == GLID_glUnmapBuffer) putBytes(stream, unmapData.data(), unmapData.size());
+		else if (id == GLID_glPixelStorei && a[0] == GL_PACK_ALIGNMENT) pixels.packAlignment = (int)a[1];
+		else if (id == GLID_glPixelStorei && a[0] == GL_UNPACK_ALIGNMENT) pixels.unpackAlignment = (int)a[1];
+		else if (id == GLID_glBindBuffer && a[0] == GL_PIXEL_PACK_BUFFER) pixels.packBuffer = a[1];
+		else if (id == GLID_glBindBuffer && a[0] == GL_PIXEL_UNPACK_BUFFER) pixels.unpackBuffer = a[1];
+		if (id == GLID_glBindBuffer) boundBuffers[a[0]] = a[1];
+		else if (id == GLID_glBindBufferBase || id == GLID_glBindBufferRange) boundBuffers[a[0]] = a[2];
+		else if (id == GLID_glDeleteBuffers) {
+			//deleting a buffer unmaps it, nothing reads the mapping after this
+			const GLuint* names = (const GLuint*)(uintptr_t)a[1];
+			for (uint64_t n = 0; n < a[0]; n++) dropPersistent(names[n]);
+		}
+		commands++;
+	}
+
+	//one thunk per entry point, real holds the pointer that was loaded before install()
+	template<int Id, typename T>
+	struct Thunk;
+	template<int Id, typename R, typename... A>
+	struct Thunk<Id, R(APIENTRYP)(A...)> {
+		using Pointer = R(APIENTRYP)(A...);
+		static inline Pointer real = NULL;
+
+		static R APIENTRY call(A... args) {
+			if (!recording) return real(args...);
+			uint64_t raw[sizeof...(A) + 1] = { glArgumentBits(args)... };
+			if (Id == GLID_glUnmapBuffer) beforeUnmap(raw[0]);
+			if (readsBuffers(Id)) syncPersistent();
+			if constexpr (std::is_void<R>::value) {
+				real(args...);
+				record(Id, raw, 0);
+			}
+			else {
+				R result = real(args...);
+				record(Id, raw, glArgumentBits(result));
+				return result;
+			}
+		}
+	};
+
+	inline void flush() {
+		file.write((const char*)stream.data(), stream.size());
+		bytesWritten += stream.size();
+		stream.clear();
+	}
+
+	//writes the header and starts recording every GL call. frames is how many endFrame()
+	//calls to record after endSetup(), the file is finished after the last one
+	inline bool install(const std::string& capturePath, int width, int height, uint64_t frameCount) {
+		if (installed) return false;
+		file.open(capturePath, std::ios::binary);
+		if (!file) {
+			std::cout << "ERROR::GL_CAPTURE::CANNOT_WRITE " << capturePath << std::endl;
+			return false;
+		}
+		path = capturePath;
+		frameLimit = frameCount;
+
+		std::vector<std::string> specs(GL_FUNCTION_COUNT);
+		for (const SpecEntry& entry : specTable) {
+			for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+				if (std::strcmp(glFunctionNames[id], entry.name) == 0) specs[id] = entry.spec;
+			}
+		}
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			if (!parseSpec(specs[id].c_str(), argSpecs[id], resultSpecs[id])
+				|| (!specs[id].empty() && !matchesSignature(id, argSpecs[id]))) {
+				std::cout << "ERROR::GL_CAPTURE::BAD_SPEC " << glFunctionNames[id] << std::endl;
+				argSpecs[id].clear();
+				specs[id].clear();
+			}
+		}
+
+		GLint major = 0, minor = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+		stream.insert(stream.end(), MAGIC, MAGIC + sizeof(MAGIC));
+		putVarint(stream, VERSION);
+		putVarint(stream, (uint64_t)major);
+		putVarint(stream, (uint64_t)minor);
+		putVarint(stream, (uint64_t)width);
+		putVarint(stream, (uint64_t)height);
+		putVarint(stream, GL_FUNCTION_COUNT);
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			putBytes(stream, glFunctionNames[id], std::strlen(glFunctionNames[id]));
+			putBytes(stream, specs[id].data(), specs[id].size());
+		}
+		flush();
+
+#define GL_FUNCTION(name, type) \
+		if (glad_##name != NULL) { \
+			Thunk<GLID_##name, type>::real = glad_##name; \
+			glad_##name = &Thunk<GLID_##name, type>::call; \
+		}
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+		installed = true;
+		recording = true;
+		return true;
+	}
+
+	//closes the file. the thunks stay in place but only forward, something installed on top
+	//of them may still be calling through
+	inline void finish() {
+		if (!recording) return;
+		recording = false;
+		putVarint(stream, GL_FUNCTION_COUNT + 1);
+		flush();
+		file.close();
+		std::cout << "GL_CAPTURE " << path << ": " << frames << " frames, " << commands << " commands, "
+			<< bytesWritten / 1024 << " KiB" << std::endl;
+#define GL_FUNCTION(name, type) \
+		if (glad_##name == &Thunk<GLID_##name, type>::call) glad_##name = Thunk<GLID_##name, type>::real;
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+	}
+
+	inline void endSetup() {
+		if (!recording) return;
+		putVarint(stream, GL_FUNCTION_COUNT);
+		flush();
+	}
+
+	inline void endFrame() {
+		if (!recording) return;
+		putVarint(stream, GL_FUNCTION_COUNT);
+		flush();
+		frames++;
+		if (frames >= frameLimit) finish();
+	}
+}
+
+#endif
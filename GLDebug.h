@@ -0,0 +1,201 @@
+#ifndef GL_DEBUG_H
+#define GL_DEBUG_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <iostream>
+
+
+//on in Debug builds, stripped from Release. define GL_DEBUG_MESSAGES to 0 or 1 to override
+#ifndef GL_DEBUG_MESSAGES
+#ifdef _DEBUG
+#define GL_DEBUG_MESSAGES 1
+#else
+#define GL_DEBUG_MESSAGES 0
+#endif
+#endif
+
+//KHR_debug messages (core in 4.3, promoted from the extension by GLCapabilities on older
+//contexts) without glGetError after every call. the driver's callback only copies the message
+//into a lock-free queue, it may run on a driver thread when output is asynchronous. drain(),
+//once per frame after the swap, prints each distinct message the first time and then at most
+//once per rateLimitSeconds with the number of repeats in between. notifications are filtered
+//out in the driver so they never reach the callback
+namespace GLDebug {
+
+	constexpr bool enabled = GL_DEBUG_MESSAGES != 0;
+
+#if GL_DEBUG_MESSAGES
+
+	struct Message {
+		GLenum source;
+		GLenum type;
+		GLuint id;
+		GLenum severity;
+		char text[256];
+	};
+
+	//bounded queue for any number of producers and one consumer, each slot's sequence says
+	//whether it is free for the producer claiming that position or full for the consumer
+	static const uint32_t QUEUE_SIZE = 1024;
+	struct Slot {
+		std::atomic<uint32_t> sequence;
+		Message message;
+	};
+	inline Slot queue[QUEUE_SIZE];
+	inline std::atomic<uint32_t> tail{ 0 };
+	inline uint32_t head = 0;
+	inline std::atomic<uint64_t> dropped{ 0 };
+
+	inline bool installed = false;
+	inline double rateLimitSeconds = 5.0;
+	//lines printed by one drain, the rest only count towards their repeats
+	inline int linesPerDrain = 20;
+
+	struct Seen {
+		uint64_t count = 0;
+		uint64_t unprinted = 0;
+		std::chrono::steady_clock::time_point printed;
+	};
+	inline std::unordered_map<uint64_t, Seen> seen;
+	inline uint64_t errors = 0;
+	inline uint64_t performance = 0;
+
+	inline bool push(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* text) {
+		uint32_t position = tail.load(std::memory_order_relaxed);
+		Slot* slot;
+		for (;;) {
+			slot = &queue[position % QUEUE_SIZE];
+			int32_t difference = (int32_t)(slot->sequence.load(std::memory_order_acquire) - position);
+			if (difference == 0) {
+				if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+			}
+			else if (difference < 0) {
+				return false;
+			}
+			else {
+				position = tail.load(std::memory_order_relaxed);
+			}
+		}
+		Message& m = slot->message;
+		m.source = source;
+		m.type = type;
+		m.id = id;
+		m.severity = severity;
+		size_t size = length < 0 ? std::strlen(text) : (size_t)length;
+		size = size < sizeof(m.text) - 1 ? size : sizeof(m.text) - 1;
+		std::memcpy(m.text, text, size);
+		m.text[size] = '\0';
+		slot->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	inline bool pop(Message& message) {
+		Slot& slot = queue[head % QUEUE_SIZE];
+		if (slot.sequence.load(std::memory_order_acquire) != head + 1) return false;
+		message = slot.message;
+		slot.sequence.store(head + QUEUE_SIZE, std::memory_order_release);
+		head++;
+		return true;
+	}
+
+	inline void APIENTRY callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+		const GLchar* message, const void*) {
+		if (!push(source, type, id, severity, length, message)) dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	inline const char* typeName(GLenum type) {
+		switch (type) {
+		case GL_DEBUG_TYPE_ERROR: return "ERROR";
+		case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "DEPRECATED";
+		case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "UNDEFINED_BEHAVIOR";
+		case GL_DEBUG_TYPE_PORTABILITY: return "PORTABILITY";
+		case GL_DEBUG_TYPE_PERFORMANCE: return "PERFORMANCE";
+		case GL_DEBUG_TYPE_MARKER: return "MARKER";
+		default: return "OTHER";
+		}
+	}
+
+	inline bool contains(const char* text, const char* word) {
+		return std::strstr(text, word) != NULL;
+	}
+
+	//drivers word the two warnings that matter most differently, these cover NVIDIA and Mesa
+	inline const char* performanceKind(const Message& m) {
+		if (m.type != GL_DEBUG_TYPE_PERFORMANCE) return "";
+		if (contains(m.text, "stall") || contains(m.text, "sync") || contains(m.text, "wait")) return " implicit sync";
+		if (contains(m.text, "realloc") || contains(m.text, "moved") || contains(m.text, "copied")
+			|| contains(m.text, "orphan")) return " buffer reallocation";
+		return "";
+	}
+
+	inline uint64_t key(const Message& m) {
+		uint64_t hash = 14695981039346656037ull;
+		uint64_t fields[] = { m.source, m.type, m.id, m.severity };
+		for (uint64_t field : fields) hash = (hash ^ field) * 1099511628211ull;
+		for (const char* c = m.text; *c; c++) hash = (hash ^ (uint8_t)*c) * 1099511628211ull;
+		return hash;
+	}
+
+	//call after loading, before anything wraps the entry points. does nothing without KHR_debug
+	inline void install() {
+		if (installed || glDebugMessageCallback == NULL || glDebugMessageControl == NULL) return;
+		for (Slot& slot : queue) slot.sequence.store((uint32_t)(&slot - queue), std::memory_order_relaxed);
+		tail = 0;
+		head = 0;
+		glEnable(GL_DEBUG_OUTPUT);
+		//asynchronous: the driver does not serialise itself to deliver messages
+		glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
+		glDebugMessageCallback(callback, NULL);
+		installed = true;
+	}
+
+	inline void drain() {
+		if (!installed) return;
+		auto now = std::chrono::steady_clock::now();
+		int lines = 0;
+		Message m;
+		while (pop(m)) {
+			if (m.type == GL_DEBUG_TYPE_ERROR) errors++;
+			if (m.type == GL_DEBUG_TYPE_PERFORMANCE) performance++;
+			Seen& s = seen[key(m)];
+			s.count++;
+			bool due = s.count == 1 || std::chrono::duration<double>(now - s.printed).count() >= rateLimitSeconds;
+			if (!due || lines >= linesPerDrain) {
+				s.unprinted++;
+				continue;
+			}
+			lines++;
+			s.printed = now;
+			std::cout << (m.type == GL_DEBUG_TYPE_ERROR ? "ERROR::GL_DEBUG::" : "GL_DEBUG ") << typeName(m.type)
+				<< performanceKind(m) << " " << m.id << ": " << m.text;
+			if (s.unprinted > 0) std::cout << " (" << s.unprinted << " repeats)";
+			std::cout << std::endl;
+			s.unprinted = 0;
+		}
+	}
+
+	inline void report() {
+		if (!installed) return;
+		drain();
+		std::cout << "GL_DEBUG " << seen.size() << " distinct messages, " << errors << " errors, " << performance
+			<< " performance warnings, " << dropped << " dropped" << std::endl;
+	}
+
+#else
+
+	inline void install() {}
+	inline void drain() {}
+	inline void report() {}
+
+#endif
+}
+
+#endif
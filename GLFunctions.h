@@ -0,0 +1,814 @@
+#ifndef GL_FUNCTIONS_H
+#define GL_FUNCTIONS_H
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+//every GL entry point glad.c loads, as GL_FUNCTION(name, pointer type), in glad.c order.
+//define GL_FUNCTION, include this list, undefine it. generated from glad.c with
+//  grep -o "^PFNGL[A-Z0-9_]*PROC glad_gl[A-Za-z0-9_]*" glad.c
+//so regenerate it whenever glad.c is regenerated
+#define GL_FUNCTION_LIST \
+	GL_FUNCTION(glActiveShaderProgram, PFNGLACTIVESHADERPROGRAMPROC) \
+	GL_FUNCTION(glActiveTexture, PFNGLACTIVETEXTUREPROC) \
+	GL_FUNCTION(glAttachShader, PFNGLATTACHSHADERPROC) \
+	GL_FUNCTION(glBeginConditionalRender, PFNGLBEGINCONDITIONALRENDERPROC) \
+	GL_FUNCTION(glBeginQuery, PFNGLBEGINQUERYPROC) \
+	GL_FUNCTION(glBeginQueryIndexed, PFNGLBEGINQUERYINDEXEDPROC) \
+	GL_FUNCTION(glBeginTransformFeedback, PFNGLBEGINTRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glBindAttribLocation, PFNGLBINDATTRIBLOCATIONPROC) \
+	GL_FUNCTION(glBindBuffer, PFNGLBINDBUFFERPROC) \
+	GL_FUNCTION(glBindBufferBase, PFNGLBINDBUFFERBASEPROC) \
+	GL_FUNCTION(glBindBufferRange, PFNGLBINDBUFFERRANGEPROC) \
+	GL_FUNCTION(glBindBuffersBase, PFNGLBINDBUFFERSBASEPROC) \
+	GL_FUNCTION(glBindBuffersRange, PFNGLBINDBUFFERSRANGEPROC) \
+	GL_FUNCTION(glBindFragDataLocation, PFNGLBINDFRAGDATALOCATIONPROC) \
+	GL_FUNCTION(glBindFragDataLocationIndexed, PFNGLBINDFRAGDATALOCATIONINDEXEDPROC) \
+	GL_FUNCTION(glBindFramebuffer, PFNGLBINDFRAMEBUFFERPROC) \
+	GL_FUNCTION(glBindImageTexture, PFNGLBINDIMAGETEXTUREPROC) \
+	GL_FUNCTION(glBindImageTextures, PFNGLBINDIMAGETEXTURESPROC) \
+	GL_FUNCTION(glBindProgramPipeline, PFNGLBINDPROGRAMPIPELINEPROC) \
+	GL_FUNCTION(glBindRenderbuffer, PFNGLBINDRENDERBUFFERPROC) \
+	GL_FUNCTION(glBindSampler, PFNGLBINDSAMPLERPROC) \
+	GL_FUNCTION(glBindSamplers, PFNGLBINDSAMPLERSPROC) \
+	GL_FUNCTION(glBindTexture, PFNGLBINDTEXTUREPROC) \
+	GL_FUNCTION(glBindTextureUnit, PFNGLBINDTEXTUREUNITPROC) \
+	GL_FUNCTION(glBindTextures, PFNGLBINDTEXTURESPROC) \
+	GL_FUNCTION(glBindTransformFeedback, PFNGLBINDTRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glBindVertexArray, PFNGLBINDVERTEXARRAYPROC) \
+	GL_FUNCTION(glBindVertexBuffer, PFNGLBINDVERTEXBUFFERPROC) \
+	GL_FUNCTION(glBindVertexBuffers, PFNGLBINDVERTEXBUFFERSPROC) \
+	GL_FUNCTION(glBlendColor, PFNGLBLENDCOLORPROC) \
+	GL_FUNCTION(glBlendEquation, PFNGLBLENDEQUATIONPROC) \
+	GL_FUNCTION(glBlendEquationSeparate, PFNGLBLENDEQUATIONSEPARATEPROC) \
+	GL_FUNCTION(glBlendEquationSeparatei, PFNGLBLENDEQUATIONSEPARATEIPROC) \
+	GL_FUNCTION(glBlendEquationi, PFNGLBLENDEQUATIONIPROC) \
+	GL_FUNCTION(glBlendFunc, PFNGLBLENDFUNCPROC) \
+	GL_FUNCTION(glBlendFuncSeparate, PFNGLBLENDFUNCSEPARATEPROC) \
+	GL_FUNCTION(glBlendFuncSeparatei, PFNGLBLENDFUNCSEPARATEIPROC) \
+	GL_FUNCTION(glBlendFunci, PFNGLBLENDFUNCIPROC) \
+	GL_FUNCTION(glBlitFramebuffer, PFNGLBLITFRAMEBUFFERPROC) \
+	GL_FUNCTION(glBlitNamedFramebuffer, PFNGLBLITNAMEDFRAMEBUFFERPROC) \
+	GL_FUNCTION(glBufferData, PFNGLBUFFERDATAPROC) \
+	GL_FUNCTION(glBufferStorage, PFNGLBUFFERSTORAGEPROC) \
+	GL_FUNCTION(glBufferSubData, PFNGLBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glCheckFramebufferStatus, PFNGLCHECKFRAMEBUFFERSTATUSPROC) \
+	GL_FUNCTION(glCheckNamedFramebufferStatus, PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC) \
+	GL_FUNCTION(glClampColor, PFNGLCLAMPCOLORPROC) \
+	GL_FUNCTION(glClear, PFNGLCLEARPROC) \
+	GL_FUNCTION(glClearBufferData, PFNGLCLEARBUFFERDATAPROC) \
+	GL_FUNCTION(glClearBufferSubData, PFNGLCLEARBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glClearBufferfi, PFNGLCLEARBUFFERFIPROC) \
+	GL_FUNCTION(glClearBufferfv, PFNGLCLEARBUFFERFVPROC) \
+	GL_FUNCTION(glClearBufferiv, PFNGLCLEARBUFFERIVPROC) \
+	GL_FUNCTION(glClearBufferuiv, PFNGLCLEARBUFFERUIVPROC) \
+	GL_FUNCTION(glClearColor, PFNGLCLEARCOLORPROC) \
+	GL_FUNCTION(glClearDepth, PFNGLCLEARDEPTHPROC) \
+	GL_FUNCTION(glClearDepthf, PFNGLCLEARDEPTHFPROC) \
+	GL_FUNCTION(glClearNamedBufferData, PFNGLCLEARNAMEDBUFFERDATAPROC) \
+	GL_FUNCTION(glClearNamedBufferSubData, PFNGLCLEARNAMEDBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glClearNamedFramebufferfi, PFNGLCLEARNAMEDFRAMEBUFFERFIPROC) \
+	GL_FUNCTION(glClearNamedFramebufferfv, PFNGLCLEARNAMEDFRAMEBUFFERFVPROC) \
+	GL_FUNCTION(glClearNamedFramebufferiv, PFNGLCLEARNAMEDFRAMEBUFFERIVPROC) \
+	GL_FUNCTION(glClearNamedFramebufferuiv, PFNGLCLEARNAMEDFRAMEBUFFERUIVPROC) \
+	GL_FUNCTION(glClearStencil, PFNGLCLEARSTENCILPROC) \
+	GL_FUNCTION(glClearTexImage, PFNGLCLEARTEXIMAGEPROC) \
+	GL_FUNCTION(glClearTexSubImage, PFNGLCLEARTEXSUBIMAGEPROC) \
+	GL_FUNCTION(glClientWaitSync, PFNGLCLIENTWAITSYNCPROC) \
+	GL_FUNCTION(glClipControl, PFNGLCLIPCONTROLPROC) \
+	GL_FUNCTION(glColorMask, PFNGLCOLORMASKPROC) \
+	GL_FUNCTION(glColorMaski, PFNGLCOLORMASKIPROC) \
+	GL_FUNCTION(glColorP3ui, PFNGLCOLORP3UIPROC) \
+	GL_FUNCTION(glColorP3uiv, PFNGLCOLORP3UIVPROC) \
+	GL_FUNCTION(glColorP4ui, PFNGLCOLORP4UIPROC) \
+	GL_FUNCTION(glColorP4uiv, PFNGLCOLORP4UIVPROC) \
+	GL_FUNCTION(glCompileShader, PFNGLCOMPILESHADERPROC) \
+	GL_FUNCTION(glCompressedTexImage1D, PFNGLCOMPRESSEDTEXIMAGE1DPROC) \
+	GL_FUNCTION(glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC) \
+	GL_FUNCTION(glCompressedTexImage3D, PFNGLCOMPRESSEDTEXIMAGE3DPROC) \
+	GL_FUNCTION(glCompressedTexSubImage1D, PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC) \
+	GL_FUNCTION(glCompressedTexSubImage2D, PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC) \
+	GL_FUNCTION(glCompressedTexSubImage3D, PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC) \
+	GL_FUNCTION(glCompressedTextureSubImage1D, PFNGLCOMPRESSEDTEXTURESUBIMAGE1DPROC) \
+	GL_FUNCTION(glCompressedTextureSubImage2D, PFNGLCOMPRESSEDTEXTURESUBIMAGE2DPROC) \
+	GL_FUNCTION(glCompressedTextureSubImage3D, PFNGLCOMPRESSEDTEXTURESUBIMAGE3DPROC) \
+	GL_FUNCTION(glCopyBufferSubData, PFNGLCOPYBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glCopyImageSubData, PFNGLCOPYIMAGESUBDATAPROC) \
+	GL_FUNCTION(glCopyNamedBufferSubData, PFNGLCOPYNAMEDBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glCopyTexImage1D, PFNGLCOPYTEXIMAGE1DPROC) \
+	GL_FUNCTION(glCopyTexImage2D, PFNGLCOPYTEXIMAGE2DPROC) \
+	GL_FUNCTION(glCopyTexSubImage1D, PFNGLCOPYTEXSUBIMAGE1DPROC) \
+	GL_FUNCTION(glCopyTexSubImage2D, PFNGLCOPYTEXSUBIMAGE2DPROC) \
+	GL_FUNCTION(glCopyTexSubImage3D, PFNGLCOPYTEXSUBIMAGE3DPROC) \
+	GL_FUNCTION(glCopyTextureSubImage1D, PFNGLCOPYTEXTURESUBIMAGE1DPROC) \
+	GL_FUNCTION(glCopyTextureSubImage2D, PFNGLCOPYTEXTURESUBIMAGE2DPROC) \
+	GL_FUNCTION(glCopyTextureSubImage3D, PFNGLCOPYTEXTURESUBIMAGE3DPROC) \
+	GL_FUNCTION(glCreateBuffers, PFNGLCREATEBUFFERSPROC) \
+	GL_FUNCTION(glCreateFramebuffers, PFNGLCREATEFRAMEBUFFERSPROC) \
+	GL_FUNCTION(glCreateProgram, PFNGLCREATEPROGRAMPROC) \
+	GL_FUNCTION(glCreateProgramPipelines, PFNGLCREATEPROGRAMPIPELINESPROC) \
+	GL_FUNCTION(glCreateQueries, PFNGLCREATEQUERIESPROC) \
+	GL_FUNCTION(glCreateRenderbuffers, PFNGLCREATERENDERBUFFERSPROC) \
+	GL_FUNCTION(glCreateSamplers, PFNGLCREATESAMPLERSPROC) \
+	GL_FUNCTION(glCreateShader, PFNGLCREATESHADERPROC) \
+	GL_FUNCTION(glCreateShaderProgramv, PFNGLCREATESHADERPROGRAMVPROC) \
+	GL_FUNCTION(glCreateTextures, PFNGLCREATETEXTURESPROC) \
+	GL_FUNCTION(glCreateTransformFeedbacks, PFNGLCREATETRANSFORMFEEDBACKSPROC) \
+	GL_FUNCTION(glCreateVertexArrays, PFNGLCREATEVERTEXARRAYSPROC) \
+	GL_FUNCTION(glCullFace, PFNGLCULLFACEPROC) \
+	GL_FUNCTION(glDebugMessageCallback, PFNGLDEBUGMESSAGECALLBACKPROC) \
+	GL_FUNCTION(glDebugMessageControl, PFNGLDEBUGMESSAGECONTROLPROC) \
+	GL_FUNCTION(glDebugMessageInsert, PFNGLDEBUGMESSAGEINSERTPROC) \
+	GL_FUNCTION(glDeleteBuffers, PFNGLDELETEBUFFERSPROC) \
+	GL_FUNCTION(glDeleteFramebuffers, PFNGLDELETEFRAMEBUFFERSPROC) \
+	GL_FUNCTION(glDeleteProgram, PFNGLDELETEPROGRAMPROC) \
+	GL_FUNCTION(glDeleteProgramPipelines, PFNGLDELETEPROGRAMPIPELINESPROC) \
+	GL_FUNCTION(glDeleteQueries, PFNGLDELETEQUERIESPROC) \
+	GL_FUNCTION(glDeleteRenderbuffers, PFNGLDELETERENDERBUFFERSPROC) \
+	GL_FUNCTION(glDeleteSamplers, PFNGLDELETESAMPLERSPROC) \
+	GL_FUNCTION(glDeleteShader, PFNGLDELETESHADERPROC) \
+	GL_FUNCTION(glDeleteSync, PFNGLDELETESYNCPROC) \
+	GL_FUNCTION(glDeleteTextures, PFNGLDELETETEXTURESPROC) \
+	GL_FUNCTION(glDeleteTransformFeedbacks, PFNGLDELETETRANSFORMFEEDBACKSPROC) \
+	GL_FUNCTION(glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC) \
+	GL_FUNCTION(glDepthFunc, PFNGLDEPTHFUNCPROC) \
+	GL_FUNCTION(glDepthMask, PFNGLDEPTHMASKPROC) \
+	GL_FUNCTION(glDepthRange, PFNGLDEPTHRANGEPROC) \
+	GL_FUNCTION(glDepthRangeArrayv, PFNGLDEPTHRANGEARRAYVPROC) \
+	GL_FUNCTION(glDepthRangeIndexed, PFNGLDEPTHRANGEINDEXEDPROC) \
+	GL_FUNCTION(glDepthRangef, PFNGLDEPTHRANGEFPROC) \
+	GL_FUNCTION(glDetachShader, PFNGLDETACHSHADERPROC) \
+	GL_FUNCTION(glDisable, PFNGLDISABLEPROC) \
+	GL_FUNCTION(glDisableVertexArrayAttrib, PFNGLDISABLEVERTEXARRAYATTRIBPROC) \
+	GL_FUNCTION(glDisableVertexAttribArray, PFNGLDISABLEVERTEXATTRIBARRAYPROC) \
+	GL_FUNCTION(glDisablei, PFNGLDISABLEIPROC) \
+	GL_FUNCTION(glDispatchCompute, PFNGLDISPATCHCOMPUTEPROC) \
+	GL_FUNCTION(glDispatchComputeIndirect, PFNGLDISPATCHCOMPUTEINDIRECTPROC) \
+	GL_FUNCTION(glDrawArrays, PFNGLDRAWARRAYSPROC) \
+	GL_FUNCTION(glDrawArraysIndirect, PFNGLDRAWARRAYSINDIRECTPROC) \
+	GL_FUNCTION(glDrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC) \
+	GL_FUNCTION(glDrawArraysInstancedBaseInstance, PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC) \
+	GL_FUNCTION(glDrawBuffer, PFNGLDRAWBUFFERPROC) \
+	GL_FUNCTION(glDrawBuffers, PFNGLDRAWBUFFERSPROC) \
+	GL_FUNCTION(glDrawElements, PFNGLDRAWELEMENTSPROC) \
+	GL_FUNCTION(glDrawElementsBaseVertex, PFNGLDRAWELEMENTSBASEVERTEXPROC) \
+	GL_FUNCTION(glDrawElementsIndirect, PFNGLDRAWELEMENTSINDIRECTPROC) \
+	GL_FUNCTION(glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC) \
+	GL_FUNCTION(glDrawElementsInstancedBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC) \
+	GL_FUNCTION(glDrawElementsInstancedBaseVertex, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC) \
+	GL_FUNCTION(glDrawElementsInstancedBaseVertexBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC) \
+	GL_FUNCTION(glDrawRangeElements, PFNGLDRAWRANGEELEMENTSPROC) \
+	GL_FUNCTION(glDrawRangeElementsBaseVertex, PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC) \
+	GL_FUNCTION(glDrawTransformFeedback, PFNGLDRAWTRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glDrawTransformFeedbackInstanced, PFNGLDRAWTRANSFORMFEEDBACKINSTANCEDPROC) \
+	GL_FUNCTION(glDrawTransformFeedbackStream, PFNGLDRAWTRANSFORMFEEDBACKSTREAMPROC) \
+	GL_FUNCTION(glDrawTransformFeedbackStreamInstanced, PFNGLDRAWTRANSFORMFEEDBACKSTREAMINSTANCEDPROC) \
+	GL_FUNCTION(glEnable, PFNGLENABLEPROC) \
+	GL_FUNCTION(glEnableVertexArrayAttrib, PFNGLENABLEVERTEXARRAYATTRIBPROC) \
+	GL_FUNCTION(glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC) \
+	GL_FUNCTION(glEnablei, PFNGLENABLEIPROC) \
+	GL_FUNCTION(glEndConditionalRender, PFNGLENDCONDITIONALRENDERPROC) \
+	GL_FUNCTION(glEndQuery, PFNGLENDQUERYPROC) \
+	GL_FUNCTION(glEndQueryIndexed, PFNGLENDQUERYINDEXEDPROC) \
+	GL_FUNCTION(glEndTransformFeedback, PFNGLENDTRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glFenceSync, PFNGLFENCESYNCPROC) \
+	GL_FUNCTION(glFinish, PFNGLFINISHPROC) \
+	GL_FUNCTION(glFlush, PFNGLFLUSHPROC) \
+	GL_FUNCTION(glFlushMappedBufferRange, PFNGLFLUSHMAPPEDBUFFERRANGEPROC) \
+	GL_FUNCTION(glFlushMappedNamedBufferRange, PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC) \
+	GL_FUNCTION(glFramebufferParameteri, PFNGLFRAMEBUFFERPARAMETERIPROC) \
+	GL_FUNCTION(glFramebufferRenderbuffer, PFNGLFRAMEBUFFERRENDERBUFFERPROC) \
+	GL_FUNCTION(glFramebufferTexture, PFNGLFRAMEBUFFERTEXTUREPROC) \
+	GL_FUNCTION(glFramebufferTexture1D, PFNGLFRAMEBUFFERTEXTURE1DPROC) \
+	GL_FUNCTION(glFramebufferTexture2D, PFNGLFRAMEBUFFERTEXTURE2DPROC) \
+	GL_FUNCTION(glFramebufferTexture3D, PFNGLFRAMEBUFFERTEXTURE3DPROC) \
+	GL_FUNCTION(glFramebufferTextureLayer, PFNGLFRAMEBUFFERTEXTURELAYERPROC) \
+	GL_FUNCTION(glFrontFace, PFNGLFRONTFACEPROC) \
+	GL_FUNCTION(glGenBuffers, PFNGLGENBUFFERSPROC) \
+	GL_FUNCTION(glGenFramebuffers, PFNGLGENFRAMEBUFFERSPROC) \
+	GL_FUNCTION(glGenProgramPipelines, PFNGLGENPROGRAMPIPELINESPROC) \
+	GL_FUNCTION(glGenQueries, PFNGLGENQUERIESPROC) \
+	GL_FUNCTION(glGenRenderbuffers, PFNGLGENRENDERBUFFERSPROC) \
+	GL_FUNCTION(glGenSamplers, PFNGLGENSAMPLERSPROC) \
+	GL_FUNCTION(glGenTextures, PFNGLGENTEXTURESPROC) \
+	GL_FUNCTION(glGenTransformFeedbacks, PFNGLGENTRANSFORMFEEDBACKSPROC) \
+	GL_FUNCTION(glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC) \
+	GL_FUNCTION(glGenerateMipmap, PFNGLGENERATEMIPMAPPROC) \
+	GL_FUNCTION(glGenerateTextureMipmap, PFNGLGENERATETEXTUREMIPMAPPROC) \
+	GL_FUNCTION(glGetActiveAtomicCounterBufferiv, PFNGLGETACTIVEATOMICCOUNTERBUFFERIVPROC) \
+	GL_FUNCTION(glGetActiveAttrib, PFNGLGETACTIVEATTRIBPROC) \
+	GL_FUNCTION(glGetActiveSubroutineName, PFNGLGETACTIVESUBROUTINENAMEPROC) \
+	GL_FUNCTION(glGetActiveSubroutineUniformName, PFNGLGETACTIVESUBROUTINEUNIFORMNAMEPROC) \
+	GL_FUNCTION(glGetActiveSubroutineUniformiv, PFNGLGETACTIVESUBROUTINEUNIFORMIVPROC) \
+	GL_FUNCTION(glGetActiveUniform, PFNGLGETACTIVEUNIFORMPROC) \
+	GL_FUNCTION(glGetActiveUniformBlockName, PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC) \
+	GL_FUNCTION(glGetActiveUniformBlockiv, PFNGLGETACTIVEUNIFORMBLOCKIVPROC) \
+	GL_FUNCTION(glGetActiveUniformName, PFNGLGETACTIVEUNIFORMNAMEPROC) \
+	GL_FUNCTION(glGetActiveUniformsiv, PFNGLGETACTIVEUNIFORMSIVPROC) \
+	GL_FUNCTION(glGetAttachedShaders, PFNGLGETATTACHEDSHADERSPROC) \
+	GL_FUNCTION(glGetAttribLocation, PFNGLGETATTRIBLOCATIONPROC) \
+	GL_FUNCTION(glGetBooleani_v, PFNGLGETBOOLEANI_VPROC) \
+	GL_FUNCTION(glGetBooleanv, PFNGLGETBOOLEANVPROC) \
+	GL_FUNCTION(glGetBufferParameteri64v, PFNGLGETBUFFERPARAMETERI64VPROC) \
+	GL_FUNCTION(glGetBufferParameteriv, PFNGLGETBUFFERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetBufferPointerv, PFNGLGETBUFFERPOINTERVPROC) \
+	GL_FUNCTION(glGetBufferSubData, PFNGLGETBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glGetCompressedTexImage, PFNGLGETCOMPRESSEDTEXIMAGEPROC) \
+	GL_FUNCTION(glGetCompressedTextureImage, PFNGLGETCOMPRESSEDTEXTUREIMAGEPROC) \
+	GL_FUNCTION(glGetCompressedTextureSubImage, PFNGLGETCOMPRESSEDTEXTURESUBIMAGEPROC) \
+	GL_FUNCTION(glGetDebugMessageLog, PFNGLGETDEBUGMESSAGELOGPROC) \
+	GL_FUNCTION(glGetDoublei_v, PFNGLGETDOUBLEI_VPROC) \
+	GL_FUNCTION(glGetDoublev, PFNGLGETDOUBLEVPROC) \
+	GL_FUNCTION(glGetError, PFNGLGETERRORPROC) \
+	GL_FUNCTION(glGetFloati_v, PFNGLGETFLOATI_VPROC) \
+	GL_FUNCTION(glGetFloatv, PFNGLGETFLOATVPROC) \
+	GL_FUNCTION(glGetFragDataIndex, PFNGLGETFRAGDATAINDEXPROC) \
+	GL_FUNCTION(glGetFragDataLocation, PFNGLGETFRAGDATALOCATIONPROC) \
+	GL_FUNCTION(glGetFramebufferAttachmentParameteriv, PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC) \
+	GL_FUNCTION(glGetFramebufferParameteriv, PFNGLGETFRAMEBUFFERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetGraphicsResetStatus, PFNGLGETGRAPHICSRESETSTATUSPROC) \
+	GL_FUNCTION(glGetInteger64i_v, PFNGLGETINTEGER64I_VPROC) \
+	GL_FUNCTION(glGetInteger64v, PFNGLGETINTEGER64VPROC) \
+	GL_FUNCTION(glGetIntegeri_v, PFNGLGETINTEGERI_VPROC) \
+	GL_FUNCTION(glGetIntegerv, PFNGLGETINTEGERVPROC) \
+	GL_FUNCTION(glGetInternalformati64v, PFNGLGETINTERNALFORMATI64VPROC) \
+	GL_FUNCTION(glGetInternalformativ, PFNGLGETINTERNALFORMATIVPROC) \
+	GL_FUNCTION(glGetMultisamplefv, PFNGLGETMULTISAMPLEFVPROC) \
+	GL_FUNCTION(glGetNamedBufferParameteri64v, PFNGLGETNAMEDBUFFERPARAMETERI64VPROC) \
+	GL_FUNCTION(glGetNamedBufferParameteriv, PFNGLGETNAMEDBUFFERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetNamedBufferPointerv, PFNGLGETNAMEDBUFFERPOINTERVPROC) \
+	GL_FUNCTION(glGetNamedBufferSubData, PFNGLGETNAMEDBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glGetNamedFramebufferAttachmentParameteriv, PFNGLGETNAMEDFRAMEBUFFERATTACHMENTPARAMETERIVPROC) \
+	GL_FUNCTION(glGetNamedFramebufferParameteriv, PFNGLGETNAMEDFRAMEBUFFERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetNamedRenderbufferParameteriv, PFNGLGETNAMEDRENDERBUFFERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetObjectLabel, PFNGLGETOBJECTLABELPROC) \
+	GL_FUNCTION(glGetObjectPtrLabel, PFNGLGETOBJECTPTRLABELPROC) \
+	GL_FUNCTION(glGetPointerv, PFNGLGETPOINTERVPROC) \
+	GL_FUNCTION(glGetProgramBinary, PFNGLGETPROGRAMBINARYPROC) \
+	GL_FUNCTION(glGetProgramInfoLog, PFNGLGETPROGRAMINFOLOGPROC) \
+	GL_FUNCTION(glGetProgramInterfaceiv, PFNGLGETPROGRAMINTERFACEIVPROC) \
+	GL_FUNCTION(glGetProgramPipelineInfoLog, PFNGLGETPROGRAMPIPELINEINFOLOGPROC) \
+	GL_FUNCTION(glGetProgramPipelineiv, PFNGLGETPROGRAMPIPELINEIVPROC) \
+	GL_FUNCTION(glGetProgramResourceIndex, PFNGLGETPROGRAMRESOURCEINDEXPROC) \
+	GL_FUNCTION(glGetProgramResourceLocation, PFNGLGETPROGRAMRESOURCELOCATIONPROC) \
+	GL_FUNCTION(glGetProgramResourceLocationIndex, PFNGLGETPROGRAMRESOURCELOCATIONINDEXPROC) \
+	GL_FUNCTION(glGetProgramResourceName, PFNGLGETPROGRAMRESOURCENAMEPROC) \
+	GL_FUNCTION(glGetProgramResourceiv, PFNGLGETPROGRAMRESOURCEIVPROC) \
+	GL_FUNCTION(glGetProgramStageiv, PFNGLGETPROGRAMSTAGEIVPROC) \
+	GL_FUNCTION(glGetProgramiv, PFNGLGETPROGRAMIVPROC) \
+	GL_FUNCTION(glGetQueryBufferObjecti64v, PFNGLGETQUERYBUFFEROBJECTI64VPROC) \
+	GL_FUNCTION(glGetQueryBufferObjectiv, PFNGLGETQUERYBUFFEROBJECTIVPROC) \
+	GL_FUNCTION(glGetQueryBufferObjectui64v, PFNGLGETQUERYBUFFEROBJECTUI64VPROC) \
+	GL_FUNCTION(glGetQueryBufferObjectuiv, PFNGLGETQUERYBUFFEROBJECTUIVPROC) \
+	GL_FUNCTION(glGetQueryIndexediv, PFNGLGETQUERYINDEXEDIVPROC) \
+	GL_FUNCTION(glGetQueryObjecti64v, PFNGLGETQUERYOBJECTI64VPROC) \
+	GL_FUNCTION(glGetQueryObjectiv, PFNGLGETQUERYOBJECTIVPROC) \
+	GL_FUNCTION(glGetQueryObjectui64v, PFNGLGETQUERYOBJECTUI64VPROC) \
+	GL_FUNCTION(glGetQueryObjectuiv, PFNGLGETQUERYOBJECTUIVPROC) \
+	GL_FUNCTION(glGetQueryiv, PFNGLGETQUERYIVPROC) \
+	GL_FUNCTION(glGetRenderbufferParameteriv, PFNGLGETRENDERBUFFERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetSamplerParameterIiv, PFNGLGETSAMPLERPARAMETERIIVPROC) \
+	GL_FUNCTION(glGetSamplerParameterIuiv, PFNGLGETSAMPLERPARAMETERIUIVPROC) \
+	GL_FUNCTION(glGetSamplerParameterfv, PFNGLGETSAMPLERPARAMETERFVPROC) \
+	GL_FUNCTION(glGetSamplerParameteriv, PFNGLGETSAMPLERPARAMETERIVPROC) \
+	GL_FUNCTION(glGetShaderInfoLog, PFNGLGETSHADERINFOLOGPROC) \
+	GL_FUNCTION(glGetShaderPrecisionFormat, PFNGLGETSHADERPRECISIONFORMATPROC) \
+	GL_FUNCTION(glGetShaderSource, PFNGLGETSHADERSOURCEPROC) \
+	GL_FUNCTION(glGetShaderiv, PFNGLGETSHADERIVPROC) \
+	GL_FUNCTION(glGetString, PFNGLGETSTRINGPROC) \
+	GL_FUNCTION(glGetStringi, PFNGLGETSTRINGIPROC) \
+	GL_FUNCTION(glGetSubroutineIndex, PFNGLGETSUBROUTINEINDEXPROC) \
+	GL_FUNCTION(glGetSubroutineUniformLocation, PFNGLGETSUBROUTINEUNIFORMLOCATIONPROC) \
+	GL_FUNCTION(glGetSynciv, PFNGLGETSYNCIVPROC) \
+	GL_FUNCTION(glGetTexImage, PFNGLGETTEXIMAGEPROC) \
+	GL_FUNCTION(glGetTexLevelParameterfv, PFNGLGETTEXLEVELPARAMETERFVPROC) \
+	GL_FUNCTION(glGetTexLevelParameteriv, PFNGLGETTEXLEVELPARAMETERIVPROC) \
+	GL_FUNCTION(glGetTexParameterIiv, PFNGLGETTEXPARAMETERIIVPROC) \
+	GL_FUNCTION(glGetTexParameterIuiv, PFNGLGETTEXPARAMETERIUIVPROC) \
+	GL_FUNCTION(glGetTexParameterfv, PFNGLGETTEXPARAMETERFVPROC) \
+	GL_FUNCTION(glGetTexParameteriv, PFNGLGETTEXPARAMETERIVPROC) \
+	GL_FUNCTION(glGetTextureImage, PFNGLGETTEXTUREIMAGEPROC) \
+	GL_FUNCTION(glGetTextureLevelParameterfv, PFNGLGETTEXTURELEVELPARAMETERFVPROC) \
+	GL_FUNCTION(glGetTextureLevelParameteriv, PFNGLGETTEXTURELEVELPARAMETERIVPROC) \
+	GL_FUNCTION(glGetTextureParameterIiv, PFNGLGETTEXTUREPARAMETERIIVPROC) \
+	GL_FUNCTION(glGetTextureParameterIuiv, PFNGLGETTEXTUREPARAMETERIUIVPROC) \
+	GL_FUNCTION(glGetTextureParameterfv, PFNGLGETTEXTUREPARAMETERFVPROC) \
+	GL_FUNCTION(glGetTextureParameteriv, PFNGLGETTEXTUREPARAMETERIVPROC) \
+	GL_FUNCTION(glGetTextureSubImage, PFNGLGETTEXTURESUBIMAGEPROC) \
+	GL_FUNCTION(glGetTransformFeedbackVarying, PFNGLGETTRANSFORMFEEDBACKVARYINGPROC) \
+	GL_FUNCTION(glGetTransformFeedbacki64_v, PFNGLGETTRANSFORMFEEDBACKI64_VPROC) \
+	GL_FUNCTION(glGetTransformFeedbacki_v, PFNGLGETTRANSFORMFEEDBACKI_VPROC) \
+	GL_FUNCTION(glGetTransformFeedbackiv, PFNGLGETTRANSFORMFEEDBACKIVPROC) \
+	GL_FUNCTION(glGetUniformBlockIndex, PFNGLGETUNIFORMBLOCKINDEXPROC) \
+	GL_FUNCTION(glGetUniformIndices, PFNGLGETUNIFORMINDICESPROC) \
+	GL_FUNCTION(glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC) \
+	GL_FUNCTION(glGetUniformSubroutineuiv, PFNGLGETUNIFORMSUBROUTINEUIVPROC) \
+	GL_FUNCTION(glGetUniformdv, PFNGLGETUNIFORMDVPROC) \
+	GL_FUNCTION(glGetUniformfv, PFNGLGETUNIFORMFVPROC) \
+	GL_FUNCTION(glGetUniformiv, PFNGLGETUNIFORMIVPROC) \
+	GL_FUNCTION(glGetUniformuiv, PFNGLGETUNIFORMUIVPROC) \
+	GL_FUNCTION(glGetVertexArrayIndexed64iv, PFNGLGETVERTEXARRAYINDEXED64IVPROC) \
+	GL_FUNCTION(glGetVertexArrayIndexediv, PFNGLGETVERTEXARRAYINDEXEDIVPROC) \
+	GL_FUNCTION(glGetVertexArrayiv, PFNGLGETVERTEXARRAYIVPROC) \
+	GL_FUNCTION(glGetVertexAttribIiv, PFNGLGETVERTEXATTRIBIIVPROC) \
+	GL_FUNCTION(glGetVertexAttribIuiv, PFNGLGETVERTEXATTRIBIUIVPROC) \
+	GL_FUNCTION(glGetVertexAttribLdv, PFNGLGETVERTEXATTRIBLDVPROC) \
+	GL_FUNCTION(glGetVertexAttribPointerv, PFNGLGETVERTEXATTRIBPOINTERVPROC) \
+	GL_FUNCTION(glGetVertexAttribdv, PFNGLGETVERTEXATTRIBDVPROC) \
+	GL_FUNCTION(glGetVertexAttribfv, PFNGLGETVERTEXATTRIBFVPROC) \
+	GL_FUNCTION(glGetVertexAttribiv, PFNGLGETVERTEXATTRIBIVPROC) \
+	GL_FUNCTION(glGetnColorTable, PFNGLGETNCOLORTABLEPROC) \
+	GL_FUNCTION(glGetnCompressedTexImage, PFNGLGETNCOMPRESSEDTEXIMAGEPROC) \
+	GL_FUNCTION(glGetnConvolutionFilter, PFNGLGETNCONVOLUTIONFILTERPROC) \
+	GL_FUNCTION(glGetnHistogram, PFNGLGETNHISTOGRAMPROC) \
+	GL_FUNCTION(glGetnMapdv, PFNGLGETNMAPDVPROC) \
+	GL_FUNCTION(glGetnMapfv, PFNGLGETNMAPFVPROC) \
+	GL_FUNCTION(glGetnMapiv, PFNGLGETNMAPIVPROC) \
+	GL_FUNCTION(glGetnMinmax, PFNGLGETNMINMAXPROC) \
+	GL_FUNCTION(glGetnPixelMapfv, PFNGLGETNPIXELMAPFVPROC) \
+	GL_FUNCTION(glGetnPixelMapuiv, PFNGLGETNPIXELMAPUIVPROC) \
+	GL_FUNCTION(glGetnPixelMapusv, PFNGLGETNPIXELMAPUSVPROC) \
+	GL_FUNCTION(glGetnPolygonStipple, PFNGLGETNPOLYGONSTIPPLEPROC) \
+	GL_FUNCTION(glGetnSeparableFilter, PFNGLGETNSEPARABLEFILTERPROC) \
+	GL_FUNCTION(glGetnTexImage, PFNGLGETNTEXIMAGEPROC) \
+	GL_FUNCTION(glGetnUniformdv, PFNGLGETNUNIFORMDVPROC) \
+	GL_FUNCTION(glGetnUniformfv, PFNGLGETNUNIFORMFVPROC) \
+	GL_FUNCTION(glGetnUniformiv, PFNGLGETNUNIFORMIVPROC) \
+	GL_FUNCTION(glGetnUniformuiv, PFNGLGETNUNIFORMUIVPROC) \
+	GL_FUNCTION(glHint, PFNGLHINTPROC) \
+	GL_FUNCTION(glInvalidateBufferData, PFNGLINVALIDATEBUFFERDATAPROC) \
+	GL_FUNCTION(glInvalidateBufferSubData, PFNGLINVALIDATEBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glInvalidateFramebuffer, PFNGLINVALIDATEFRAMEBUFFERPROC) \
+	GL_FUNCTION(glInvalidateNamedFramebufferData, PFNGLINVALIDATENAMEDFRAMEBUFFERDATAPROC) \
+	GL_FUNCTION(glInvalidateNamedFramebufferSubData, PFNGLINVALIDATENAMEDFRAMEBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glInvalidateSubFramebuffer, PFNGLINVALIDATESUBFRAMEBUFFERPROC) \
+	GL_FUNCTION(glInvalidateTexImage, PFNGLINVALIDATETEXIMAGEPROC) \
+	GL_FUNCTION(glInvalidateTexSubImage, PFNGLINVALIDATETEXSUBIMAGEPROC) \
+	GL_FUNCTION(glIsBuffer, PFNGLISBUFFERPROC) \
+	GL_FUNCTION(glIsEnabled, PFNGLISENABLEDPROC) \
+	GL_FUNCTION(glIsEnabledi, PFNGLISENABLEDIPROC) \
+	GL_FUNCTION(glIsFramebuffer, PFNGLISFRAMEBUFFERPROC) \
+	GL_FUNCTION(glIsProgram, PFNGLISPROGRAMPROC) \
+	GL_FUNCTION(glIsProgramPipeline, PFNGLISPROGRAMPIPELINEPROC) \
+	GL_FUNCTION(glIsQuery, PFNGLISQUERYPROC) \
+	GL_FUNCTION(glIsRenderbuffer, PFNGLISRENDERBUFFERPROC) \
+	GL_FUNCTION(glIsSampler, PFNGLISSAMPLERPROC) \
+	GL_FUNCTION(glIsShader, PFNGLISSHADERPROC) \
+	GL_FUNCTION(glIsSync, PFNGLISSYNCPROC) \
+	GL_FUNCTION(glIsTexture, PFNGLISTEXTUREPROC) \
+	GL_FUNCTION(glIsTransformFeedback, PFNGLISTRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glIsVertexArray, PFNGLISVERTEXARRAYPROC) \
+	GL_FUNCTION(glLineWidth, PFNGLLINEWIDTHPROC) \
+	GL_FUNCTION(glLinkProgram, PFNGLLINKPROGRAMPROC) \
+	GL_FUNCTION(glLogicOp, PFNGLLOGICOPPROC) \
+	GL_FUNCTION(glMapBuffer, PFNGLMAPBUFFERPROC) \
+	GL_FUNCTION(glMapBufferRange, PFNGLMAPBUFFERRANGEPROC) \
+	GL_FUNCTION(glMapNamedBuffer, PFNGLMAPNAMEDBUFFERPROC) \
+	GL_FUNCTION(glMapNamedBufferRange, PFNGLMAPNAMEDBUFFERRANGEPROC) \
+	GL_FUNCTION(glMemoryBarrier, PFNGLMEMORYBARRIERPROC) \
+	GL_FUNCTION(glMemoryBarrierByRegion, PFNGLMEMORYBARRIERBYREGIONPROC) \
+	GL_FUNCTION(glMinSampleShading, PFNGLMINSAMPLESHADINGPROC) \
+	GL_FUNCTION(glMultiDrawArrays, PFNGLMULTIDRAWARRAYSPROC) \
+	GL_FUNCTION(glMultiDrawArraysIndirect, PFNGLMULTIDRAWARRAYSINDIRECTPROC) \
+	GL_FUNCTION(glMultiDrawArraysIndirectCount, PFNGLMULTIDRAWARRAYSINDIRECTCOUNTPROC) \
+	GL_FUNCTION(glMultiDrawElements, PFNGLMULTIDRAWELEMENTSPROC) \
+	GL_FUNCTION(glMultiDrawElementsBaseVertex, PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC) \
+	GL_FUNCTION(glMultiDrawElementsIndirect, PFNGLMULTIDRAWELEMENTSINDIRECTPROC) \
+	GL_FUNCTION(glMultiDrawElementsIndirectCount, PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC) \
+	GL_FUNCTION(glMultiTexCoordP1ui, PFNGLMULTITEXCOORDP1UIPROC) \
+	GL_FUNCTION(glMultiTexCoordP1uiv, PFNGLMULTITEXCOORDP1UIVPROC) \
+	GL_FUNCTION(glMultiTexCoordP2ui, PFNGLMULTITEXCOORDP2UIPROC) \
+	GL_FUNCTION(glMultiTexCoordP2uiv, PFNGLMULTITEXCOORDP2UIVPROC) \
+	GL_FUNCTION(glMultiTexCoordP3ui, PFNGLMULTITEXCOORDP3UIPROC) \
+	GL_FUNCTION(glMultiTexCoordP3uiv, PFNGLMULTITEXCOORDP3UIVPROC) \
+	GL_FUNCTION(glMultiTexCoordP4ui, PFNGLMULTITEXCOORDP4UIPROC) \
+	GL_FUNCTION(glMultiTexCoordP4uiv, PFNGLMULTITEXCOORDP4UIVPROC) \
+	GL_FUNCTION(glNamedBufferData, PFNGLNAMEDBUFFERDATAPROC) \
+	GL_FUNCTION(glNamedBufferStorage, PFNGLNAMEDBUFFERSTORAGEPROC) \
+	GL_FUNCTION(glNamedBufferSubData, PFNGLNAMEDBUFFERSUBDATAPROC) \
+	GL_FUNCTION(glNamedFramebufferDrawBuffer, PFNGLNAMEDFRAMEBUFFERDRAWBUFFERPROC) \
+	GL_FUNCTION(glNamedFramebufferDrawBuffers, PFNGLNAMEDFRAMEBUFFERDRAWBUFFERSPROC) \
+	GL_FUNCTION(glNamedFramebufferParameteri, PFNGLNAMEDFRAMEBUFFERPARAMETERIPROC) \
+	GL_FUNCTION(glNamedFramebufferReadBuffer, PFNGLNAMEDFRAMEBUFFERREADBUFFERPROC) \
+	GL_FUNCTION(glNamedFramebufferRenderbuffer, PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC) \
+	GL_FUNCTION(glNamedFramebufferTexture, PFNGLNAMEDFRAMEBUFFERTEXTUREPROC) \
+	GL_FUNCTION(glNamedFramebufferTextureLayer, PFNGLNAMEDFRAMEBUFFERTEXTURELAYERPROC) \
+	GL_FUNCTION(glNamedRenderbufferStorage, PFNGLNAMEDRENDERBUFFERSTORAGEPROC) \
+	GL_FUNCTION(glNamedRenderbufferStorageMultisample, PFNGLNAMEDRENDERBUFFERSTORAGEMULTISAMPLEPROC) \
+	GL_FUNCTION(glNormalP3ui, PFNGLNORMALP3UIPROC) \
+	GL_FUNCTION(glNormalP3uiv, PFNGLNORMALP3UIVPROC) \
+	GL_FUNCTION(glObjectLabel, PFNGLOBJECTLABELPROC) \
+	GL_FUNCTION(glObjectPtrLabel, PFNGLOBJECTPTRLABELPROC) \
+	GL_FUNCTION(glPatchParameterfv, PFNGLPATCHPARAMETERFVPROC) \
+	GL_FUNCTION(glPatchParameteri, PFNGLPATCHPARAMETERIPROC) \
+	GL_FUNCTION(glPauseTransformFeedback, PFNGLPAUSETRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glPixelStoref, PFNGLPIXELSTOREFPROC) \
+	GL_FUNCTION(glPixelStorei, PFNGLPIXELSTOREIPROC) \
+	GL_FUNCTION(glPointParameterf, PFNGLPOINTPARAMETERFPROC) \
+	GL_FUNCTION(glPointParameterfv, PFNGLPOINTPARAMETERFVPROC) \
+	GL_FUNCTION(glPointParameteri, PFNGLPOINTPARAMETERIPROC) \
+	GL_FUNCTION(glPointParameteriv, PFNGLPOINTPARAMETERIVPROC) \
+	GL_FUNCTION(glPointSize, PFNGLPOINTSIZEPROC) \
+	GL_FUNCTION(glPolygonMode, PFNGLPOLYGONMODEPROC) \
+	GL_FUNCTION(glPolygonOffset, PFNGLPOLYGONOFFSETPROC) \
+	GL_FUNCTION(glPolygonOffsetClamp, PFNGLPOLYGONOFFSETCLAMPPROC) \
+	GL_FUNCTION(glPopDebugGroup, PFNGLPOPDEBUGGROUPPROC) \
+	GL_FUNCTION(glPrimitiveRestartIndex, PFNGLPRIMITIVERESTARTINDEXPROC) \
+	GL_FUNCTION(glProgramBinary, PFNGLPROGRAMBINARYPROC) \
+	GL_FUNCTION(glProgramParameteri, PFNGLPROGRAMPARAMETERIPROC) \
+	GL_FUNCTION(glProgramUniform1d, PFNGLPROGRAMUNIFORM1DPROC) \
+	GL_FUNCTION(glProgramUniform1dv, PFNGLPROGRAMUNIFORM1DVPROC) \
+	GL_FUNCTION(glProgramUniform1f, PFNGLPROGRAMUNIFORM1FPROC) \
+	GL_FUNCTION(glProgramUniform1fv, PFNGLPROGRAMUNIFORM1FVPROC) \
+	GL_FUNCTION(glProgramUniform1i, PFNGLPROGRAMUNIFORM1IPROC) \
+	GL_FUNCTION(glProgramUniform1iv, PFNGLPROGRAMUNIFORM1IVPROC) \
+	GL_FUNCTION(glProgramUniform1ui, PFNGLPROGRAMUNIFORM1UIPROC) \
+	GL_FUNCTION(glProgramUniform1uiv, PFNGLPROGRAMUNIFORM1UIVPROC) \
+	GL_FUNCTION(glProgramUniform2d, PFNGLPROGRAMUNIFORM2DPROC) \
+	GL_FUNCTION(glProgramUniform2dv, PFNGLPROGRAMUNIFORM2DVPROC) \
+	GL_FUNCTION(glProgramUniform2f, PFNGLPROGRAMUNIFORM2FPROC) \
+	GL_FUNCTION(glProgramUniform2fv, PFNGLPROGRAMUNIFORM2FVPROC) \
+	GL_FUNCTION(glProgramUniform2i, PFNGLPROGRAMUNIFORM2IPROC) \
+	GL_FUNCTION(glProgramUniform2iv, PFNGLPROGRAMUNIFORM2IVPROC) \
+	GL_FUNCTION(glProgramUniform2ui, PFNGLPROGRAMUNIFORM2UIPROC) \
+	GL_FUNCTION(glProgramUniform2uiv, PFNGLPROGRAMUNIFORM2UIVPROC) \
+	GL_FUNCTION(glProgramUniform3d, PFNGLPROGRAMUNIFORM3DPROC) \
+	GL_FUNCTION(glProgramUniform3dv, PFNGLPROGRAMUNIFORM3DVPROC) \
+	GL_FUNCTION(glProgramUniform3f, PFNGLPROGRAMUNIFORM3FPROC) \
+	GL_FUNCTION(glProgramUniform3fv, PFNGLPROGRAMUNIFORM3FVPROC) \
+	GL_FUNCTION(glProgramUniform3i, PFNGLPROGRAMUNIFORM3IPROC) \
+	GL_FUNCTION(glProgramUniform3iv, PFNGLPROGRAMUNIFORM3IVPROC) \
+	GL_FUNCTION(glProgramUniform3ui, PFNGLPROGRAMUNIFORM3UIPROC) \
+	GL_FUNCTION(glProgramUniform3uiv, PFNGLPROGRAMUNIFORM3UIVPROC) \
+	GL_FUNCTION(glProgramUniform4d, PFNGLPROGRAMUNIFORM4DPROC) \
+	GL_FUNCTION(glProgramUniform4dv, PFNGLPROGRAMUNIFORM4DVPROC) \
+	GL_FUNCTION(glProgramUniform4f, PFNGLPROGRAMUNIFORM4FPROC) \
+	GL_FUNCTION(glProgramUniform4fv, PFNGLPROGRAMUNIFORM4FVPROC) \
+	GL_FUNCTION(glProgramUniform4i, PFNGLPROGRAMUNIFORM4IPROC) \
+	GL_FUNCTION(glProgramUniform4iv, PFNGLPROGRAMUNIFORM4IVPROC) \
+	GL_FUNCTION(glProgramUniform4ui, PFNGLPROGRAMUNIFORM4UIPROC) \
+	GL_FUNCTION(glProgramUniform4uiv, PFNGLPROGRAMUNIFORM4UIVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix2dv, PFNGLPROGRAMUNIFORMMATRIX2DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix2fv, PFNGLPROGRAMUNIFORMMATRIX2FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix2x3dv, PFNGLPROGRAMUNIFORMMATRIX2X3DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix2x3fv, PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix2x4dv, PFNGLPROGRAMUNIFORMMATRIX2X4DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix2x4fv, PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix3dv, PFNGLPROGRAMUNIFORMMATRIX3DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix3fv, PFNGLPROGRAMUNIFORMMATRIX3FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix3x2dv, PFNGLPROGRAMUNIFORMMATRIX3X2DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix3x2fv, PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix3x4dv, PFNGLPROGRAMUNIFORMMATRIX3X4DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix3x4fv, PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix4dv, PFNGLPROGRAMUNIFORMMATRIX4DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix4fv, PFNGLPROGRAMUNIFORMMATRIX4FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix4x2dv, PFNGLPROGRAMUNIFORMMATRIX4X2DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix4x2fv, PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix4x3dv, PFNGLPROGRAMUNIFORMMATRIX4X3DVPROC) \
+	GL_FUNCTION(glProgramUniformMatrix4x3fv, PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC) \
+	GL_FUNCTION(glProvokingVertex, PFNGLPROVOKINGVERTEXPROC) \
+	GL_FUNCTION(glPushDebugGroup, PFNGLPUSHDEBUGGROUPPROC) \
+	GL_FUNCTION(glQueryCounter, PFNGLQUERYCOUNTERPROC) \
+	GL_FUNCTION(glReadBuffer, PFNGLREADBUFFERPROC) \
+	GL_FUNCTION(glReadPixels, PFNGLREADPIXELSPROC) \
+	GL_FUNCTION(glReadnPixels, PFNGLREADNPIXELSPROC) \
+	GL_FUNCTION(glReleaseShaderCompiler, PFNGLRELEASESHADERCOMPILERPROC) \
+	GL_FUNCTION(glRenderbufferStorage, PFNGLRENDERBUFFERSTORAGEPROC) \
+	GL_FUNCTION(glRenderbufferStorageMultisample, PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC) \
+	GL_FUNCTION(glResumeTransformFeedback, PFNGLRESUMETRANSFORMFEEDBACKPROC) \
+	GL_FUNCTION(glSampleCoverage, PFNGLSAMPLECOVERAGEPROC) \
+	GL_FUNCTION(glSampleMaski, PFNGLSAMPLEMASKIPROC) \
+	GL_FUNCTION(glSamplerParameterIiv, PFNGLSAMPLERPARAMETERIIVPROC) \
+	GL_FUNCTION(glSamplerParameterIuiv, PFNGLSAMPLERPARAMETERIUIVPROC) \
+	GL_FUNCTION(glSamplerParameterf, PFNGLSAMPLERPARAMETERFPROC) \
+	GL_FUNCTION(glSamplerParameterfv, PFNGLSAMPLERPARAMETERFVPROC) \
+	GL_FUNCTION(glSamplerParameteri, PFNGLSAMPLERPARAMETERIPROC) \
+	GL_FUNCTION(glSamplerParameteriv, PFNGLSAMPLERPARAMETERIVPROC) \
+	GL_FUNCTION(glScissor, PFNGLSCISSORPROC) \
+	GL_FUNCTION(glScissorArrayv, PFNGLSCISSORARRAYVPROC) \
+	GL_FUNCTION(glScissorIndexed, PFNGLSCISSORINDEXEDPROC) \
+	GL_FUNCTION(glScissorIndexedv, PFNGLSCISSORINDEXEDVPROC) \
+	GL_FUNCTION(glSecondaryColorP3ui, PFNGLSECONDARYCOLORP3UIPROC) \
+	GL_FUNCTION(glSecondaryColorP3uiv, PFNGLSECONDARYCOLORP3UIVPROC) \
+	GL_FUNCTION(glShaderBinary, PFNGLSHADERBINARYPROC) \
+	GL_FUNCTION(glShaderSource, PFNGLSHADERSOURCEPROC) \
+	GL_FUNCTION(glShaderStorageBlockBinding, PFNGLSHADERSTORAGEBLOCKBINDINGPROC) \
+	GL_FUNCTION(glSpecializeShader, PFNGLSPECIALIZESHADERPROC) \
+	GL_FUNCTION(glStencilFunc, PFNGLSTENCILFUNCPROC) \
+	GL_FUNCTION(glStencilFuncSeparate, PFNGLSTENCILFUNCSEPARATEPROC) \
+	GL_FUNCTION(glStencilMask, PFNGLSTENCILMASKPROC) \
+	GL_FUNCTION(glStencilMaskSeparate, PFNGLSTENCILMASKSEPARATEPROC) \
+	GL_FUNCTION(glStencilOp, PFNGLSTENCILOPPROC) \
+	GL_FUNCTION(glStencilOpSeparate, PFNGLSTENCILOPSEPARATEPROC) \
+	GL_FUNCTION(glTexBuffer, PFNGLTEXBUFFERPROC) \
+	GL_FUNCTION(glTexBufferRange, PFNGLTEXBUFFERRANGEPROC) \
+	GL_FUNCTION(glTexCoordP1ui, PFNGLTEXCOORDP1UIPROC) \
+	GL_FUNCTION(glTexCoordP1uiv, PFNGLTEXCOORDP1UIVPROC) \
+	GL_FUNCTION(glTexCoordP2ui, PFNGLTEXCOORDP2UIPROC) \
+	GL_FUNCTION(glTexCoordP2uiv, PFNGLTEXCOORDP2UIVPROC) \
+	GL_FUNCTION(glTexCoordP3ui, PFNGLTEXCOORDP3UIPROC) \
+	GL_FUNCTION(glTexCoordP3uiv, PFNGLTEXCOORDP3UIVPROC) \
+	GL_FUNCTION(glTexCoordP4ui, PFNGLTEXCOORDP4UIPROC) \
+	GL_FUNCTION(glTexCoordP4uiv, PFNGLTEXCOORDP4UIVPROC) \
+	GL_FUNCTION(glTexImage1D, PFNGLTEXIMAGE1DPROC) \
+	GL_FUNCTION(glTexImage2D, PFNGLTEXIMAGE2DPROC) \
+	GL_FUNCTION(glTexImage2DMultisample, PFNGLTEXIMAGE2DMULTISAMPLEPROC) \
+	GL_FUNCTION(glTexImage3D, PFNGLTEXIMAGE3DPROC) \
+	GL_FUNCTION(glTexImage3DMultisample, PFNGLTEXIMAGE3DMULTISAMPLEPROC) \
+	GL_FUNCTION(glTexParameterIiv, PFNGLTEXPARAMETERIIVPROC) \
+	GL_FUNCTION(glTexParameterIuiv, PFNGLTEXPARAMETERIUIVPROC) \
+	GL_FUNCTION(glTexParameterf, PFNGLTEXPARAMETERFPROC) \
+	GL_FUNCTION(glTexParameterfv, PFNGLTEXPARAMETERFVPROC) \
+	GL_FUNCTION(glTexParameteri, PFNGLTEXPARAMETERIPROC) \
+	GL_FUNCTION(glTexParameteriv, PFNGLTEXPARAMETERIVPROC) \
+	GL_FUNCTION(glTexStorage1D, PFNGLTEXSTORAGE1DPROC) \
+	GL_FUNCTION(glTexStorage2D, PFNGLTEXSTORAGE2DPROC) \
+	GL_FUNCTION(glTexStorage2DMultisample, PFNGLTEXSTORAGE2DMULTISAMPLEPROC) \
+	GL_FUNCTION(glTexStorage3D, PFNGLTEXSTORAGE3DPROC) \
+	GL_FUNCTION(glTexStorage3DMultisample, PFNGLTEXSTORAGE3DMULTISAMPLEPROC) \
+	GL_FUNCTION(glTexSubImage1D, PFNGLTEXSUBIMAGE1DPROC) \
+	GL_FUNCTION(glTexSubImage2D, PFNGLTEXSUBIMAGE2DPROC) \
+	GL_FUNCTION(glTexSubImage3D, PFNGLTEXSUBIMAGE3DPROC) \
+	GL_FUNCTION(glTextureBarrier, PFNGLTEXTUREBARRIERPROC) \
+	GL_FUNCTION(glTextureBuffer, PFNGLTEXTUREBUFFERPROC) \
+	GL_FUNCTION(glTextureBufferRange, PFNGLTEXTUREBUFFERRANGEPROC) \
+	GL_FUNCTION(glTextureParameterIiv, PFNGLTEXTUREPARAMETERIIVPROC) \
+	GL_FUNCTION(glTextureParameterIuiv, PFNGLTEXTUREPARAMETERIUIVPROC) \
+	GL_FUNCTION(glTextureParameterf, PFNGLTEXTUREPARAMETERFPROC) \
+	GL_FUNCTION(glTextureParameterfv, PFNGLTEXTUREPARAMETERFVPROC) \
+	GL_FUNCTION(glTextureParameteri, PFNGLTEXTUREPARAMETERIPROC) \
+	GL_FUNCTION(glTextureParameteriv, PFNGLTEXTUREPARAMETERIVPROC) \
+	GL_FUNCTION(glTextureStorage1D, PFNGLTEXTURESTORAGE1DPROC) \
+	GL_FUNCTION(glTextureStorage2D, PFNGLTEXTURESTORAGE2DPROC) \
+	GL_FUNCTION(glTextureStorage2DMultisample, PFNGLTEXTURESTORAGE2DMULTISAMPLEPROC) \
+	GL_FUNCTION(glTextureStorage3D, PFNGLTEXTURESTORAGE3DPROC) \
+	GL_FUNCTION(glTextureStorage3DMultisample, PFNGLTEXTURESTORAGE3DMULTISAMPLEPROC) \
+	GL_FUNCTION(glTextureSubImage1D, PFNGLTEXTURESUBIMAGE1DPROC) \
+	GL_FUNCTION(glTextureSubImage2D, PFNGLTEXTURESUBIMAGE2DPROC) \
+	GL_FUNCTION(glTextureSubImage3D, PFNGLTEXTURESUBIMAGE3DPROC) \
+	GL_FUNCTION(glTextureView, PFNGLTEXTUREVIEWPROC) \
+	GL_FUNCTION(glTransformFeedbackBufferBase, PFNGLTRANSFORMFEEDBACKBUFFERBASEPROC) \
+	GL_FUNCTION(glTransformFeedbackBufferRange, PFNGLTRANSFORMFEEDBACKBUFFERRANGEPROC) \
+	GL_FUNCTION(glTransformFeedbackVaryings, PFNGLTRANSFORMFEEDBACKVARYINGSPROC) \
+	GL_FUNCTION(glUniform1d, PFNGLUNIFORM1DPROC) \
+	GL_FUNCTION(glUniform1dv, PFNGLUNIFORM1DVPROC) \
+	GL_FUNCTION(glUniform1f, PFNGLUNIFORM1FPROC) \
+	GL_FUNCTION(glUniform1fv, PFNGLUNIFORM1FVPROC) \
+	GL_FUNCTION(glUniform1i, PFNGLUNIFORM1IPROC) \
+	GL_FUNCTION(glUniform1iv, PFNGLUNIFORM1IVPROC) \
+	GL_FUNCTION(glUniform1ui, PFNGLUNIFORM1UIPROC) \
+	GL_FUNCTION(glUniform1uiv, PFNGLUNIFORM1UIVPROC) \
+	GL_FUNCTION(glUniform2d, PFNGLUNIFORM2DPROC) \
+	GL_FUNCTION(glUniform2dv, PFNGLUNIFORM2DVPROC) \
+	GL_FUNCTION(glUniform2f, PFNGLUNIFORM2FPROC) \
+	GL_FUNCTION(glUniform2fv, PFNGLUNIFORM2FVPROC) \
+	GL_FUNCTION(glUniform2i, PFNGLUNIFORM2IPROC) \
+	GL_FUNCTION(glUniform2iv, PFNGLUNIFORM2IVPROC) \
+	GL_FUNCTION(glUniform2ui, PFNGLUNIFORM2UIPROC) \
+	GL_FUNCTION(glUniform2uiv, PFNGLUNIFORM2UIVPROC) \
+	GL_FUNCTION(glUniform3d, PFNGLUNIFORM3DPROC) \
+	GL_FUNCTION(glUniform3dv, PFNGLUNIFORM3DVPROC) \
+	GL_FUNCTION(glUniform3f, PFNGLUNIFORM3FPROC) \
+	GL_FUNCTION(glUniform3fv, PFNGLUNIFORM3FVPROC) \
+	GL_FUNCTION(glUniform3i, PFNGLUNIFORM3IPROC) \
+	GL_FUNCTION(glUniform3iv, PFNGLUNIFORM3IVPROC) \
+	GL_FUNCTION(glUniform3ui, PFNGLUNIFORM3UIPROC) \
+	GL_FUNCTION(glUniform3uiv, PFNGLUNIFORM3UIVPROC) \
+	GL_FUNCTION(glUniform4d, PFNGLUNIFORM4DPROC) \
+	GL_FUNCTION(glUniform4dv, PFNGLUNIFORM4DVPROC) \
+	GL_FUNCTION(glUniform4f, PFNGLUNIFORM4FPROC) \
+	GL_FUNCTION(glUniform4fv, PFNGLUNIFORM4FVPROC) \
+	GL_FUNCTION(glUniform4i, PFNGLUNIFORM4IPROC) \
+	GL_FUNCTION(glUniform4iv, PFNGLUNIFORM4IVPROC) \
+	GL_FUNCTION(glUniform4ui, PFNGLUNIFORM4UIPROC) \
+	GL_FUNCTION(glUniform4uiv, PFNGLUNIFORM4UIVPROC) \
+	GL_FUNCTION(glUniformBlockBinding, PFNGLUNIFORMBLOCKBINDINGPROC) \
+	GL_FUNCTION(glUniformMatrix2dv, PFNGLUNIFORMMATRIX2DVPROC) \
+	GL_FUNCTION(glUniformMatrix2fv, PFNGLUNIFORMMATRIX2FVPROC) \
+	GL_FUNCTION(glUniformMatrix2x3dv, PFNGLUNIFORMMATRIX2X3DVPROC) \
+	GL_FUNCTION(glUniformMatrix2x3fv, PFNGLUNIFORMMATRIX2X3FVPROC) \
+	GL_FUNCTION(glUniformMatrix2x4dv, PFNGLUNIFORMMATRIX2X4DVPROC) \
+	GL_FUNCTION(glUniformMatrix2x4fv, PFNGLUNIFORMMATRIX2X4FVPROC) \
+	GL_FUNCTION(glUniformMatrix3dv, PFNGLUNIFORMMATRIX3DVPROC) \
+	GL_FUNCTION(glUniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC) \
+	GL_FUNCTION(glUniformMatrix3x2dv, PFNGLUNIFORMMATRIX3X2DVPROC) \
+	GL_FUNCTION(glUniformMatrix3x2fv, PFNGLUNIFORMMATRIX3X2FVPROC) \
+	GL_FUNCTION(glUniformMatrix3x4dv, PFNGLUNIFORMMATRIX3X4DVPROC) \
+	GL_FUNCTION(glUniformMatrix3x4fv, PFNGLUNIFORMMATRIX3X4FVPROC) \
+	GL_FUNCTION(glUniformMatrix4dv, PFNGLUNIFORMMATRIX4DVPROC) \
+	GL_FUNCTION(glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC) \
+	GL_FUNCTION(glUniformMatrix4x2dv, PFNGLUNIFORMMATRIX4X2DVPROC) \
+	GL_FUNCTION(glUniformMatrix4x2fv, PFNGLUNIFORMMATRIX4X2FVPROC) \
+	GL_FUNCTION(glUniformMatrix4x3dv, PFNGLUNIFORMMATRIX4X3DVPROC) \
+	GL_FUNCTION(glUniformMatrix4x3fv, PFNGLUNIFORMMATRIX4X3FVPROC) \
+	GL_FUNCTION(glUniformSubroutinesuiv, PFNGLUNIFORMSUBROUTINESUIVPROC) \
+	GL_FUNCTION(glUnmapBuffer, PFNGLUNMAPBUFFERPROC) \
+	GL_FUNCTION(glUnmapNamedBuffer, PFNGLUNMAPNAMEDBUFFERPROC) \
+	GL_FUNCTION(glUseProgram, PFNGLUSEPROGRAMPROC) \
+	GL_FUNCTION(glUseProgramStages, PFNGLUSEPROGRAMSTAGESPROC) \
+	GL_FUNCTION(glValidateProgram, PFNGLVALIDATEPROGRAMPROC) \
+	GL_FUNCTION(glValidateProgramPipeline, PFNGLVALIDATEPROGRAMPIPELINEPROC) \
+	GL_FUNCTION(glVertexArrayAttribBinding, PFNGLVERTEXARRAYATTRIBBINDINGPROC) \
+	GL_FUNCTION(glVertexArrayAttribFormat, PFNGLVERTEXARRAYATTRIBFORMATPROC) \
+	GL_FUNCTION(glVertexArrayAttribIFormat, PFNGLVERTEXARRAYATTRIBIFORMATPROC) \
+	GL_FUNCTION(glVertexArrayAttribLFormat, PFNGLVERTEXARRAYATTRIBLFORMATPROC) \
+	GL_FUNCTION(glVertexArrayBindingDivisor, PFNGLVERTEXARRAYBINDINGDIVISORPROC) \
+	GL_FUNCTION(glVertexArrayElementBuffer, PFNGLVERTEXARRAYELEMENTBUFFERPROC) \
+	GL_FUNCTION(glVertexArrayVertexBuffer, PFNGLVERTEXARRAYVERTEXBUFFERPROC) \
+	GL_FUNCTION(glVertexArrayVertexBuffers, PFNGLVERTEXARRAYVERTEXBUFFERSPROC) \
+	GL_FUNCTION(glVertexAttrib1d, PFNGLVERTEXATTRIB1DPROC) \
+	GL_FUNCTION(glVertexAttrib1dv, PFNGLVERTEXATTRIB1DVPROC) \
+	GL_FUNCTION(glVertexAttrib1f, PFNGLVERTEXATTRIB1FPROC) \
+	GL_FUNCTION(glVertexAttrib1fv, PFNGLVERTEXATTRIB1FVPROC) \
+	GL_FUNCTION(glVertexAttrib1s, PFNGLVERTEXATTRIB1SPROC) \
+	GL_FUNCTION(glVertexAttrib1sv, PFNGLVERTEXATTRIB1SVPROC) \
+	GL_FUNCTION(glVertexAttrib2d, PFNGLVERTEXATTRIB2DPROC) \
+	GL_FUNCTION(glVertexAttrib2dv, PFNGLVERTEXATTRIB2DVPROC) \
+	GL_FUNCTION(glVertexAttrib2f, PFNGLVERTEXATTRIB2FPROC) \
+	GL_FUNCTION(glVertexAttrib2fv, PFNGLVERTEXATTRIB2FVPROC) \
+	GL_FUNCTION(glVertexAttrib2s, PFNGLVERTEXATTRIB2SPROC) \
+	GL_FUNCTION(glVertexAttrib2sv, PFNGLVERTEXATTRIB2SVPROC) \
+	GL_FUNCTION(glVertexAttrib3d, PFNGLVERTEXATTRIB3DPROC) \
+	GL_FUNCTION(glVertexAttrib3dv, PFNGLVERTEXATTRIB3DVPROC) \
+	GL_FUNCTION(glVertexAttrib3f, PFNGLVERTEXATTRIB3FPROC) \
+	GL_FUNCTION(glVertexAttrib3fv, PFNGLVERTEXATTRIB3FVPROC) \
+	GL_FUNCTION(glVertexAttrib3s, PFNGLVERTEXATTRIB3SPROC) \
+	GL_FUNCTION(glVertexAttrib3sv, PFNGLVERTEXATTRIB3SVPROC) \
+	GL_FUNCTION(glVertexAttrib4Nbv, PFNGLVERTEXATTRIB4NBVPROC) \
+	GL_FUNCTION(glVertexAttrib4Niv, PFNGLVERTEXATTRIB4NIVPROC) \
+	GL_FUNCTION(glVertexAttrib4Nsv, PFNGLVERTEXATTRIB4NSVPROC) \
+	GL_FUNCTION(glVertexAttrib4Nub, PFNGLVERTEXATTRIB4NUBPROC) \
+	GL_FUNCTION(glVertexAttrib4Nubv, PFNGLVERTEXATTRIB4NUBVPROC) \
+	GL_FUNCTION(glVertexAttrib4Nuiv, PFNGLVERTEXATTRIB4NUIVPROC) \
+	GL_FUNCTION(glVertexAttrib4Nusv, PFNGLVERTEXATTRIB4NUSVPROC) \
+	GL_FUNCTION(glVertexAttrib4bv, PFNGLVERTEXATTRIB4BVPROC) \
+	GL_FUNCTION(glVertexAttrib4d, PFNGLVERTEXATTRIB4DPROC) \
+	GL_FUNCTION(glVertexAttrib4dv, PFNGLVERTEXATTRIB4DVPROC) \
+	GL_FUNCTION(glVertexAttrib4f, PFNGLVERTEXATTRIB4FPROC) \
+	GL_FUNCTION(glVertexAttrib4fv, PFNGLVERTEXATTRIB4FVPROC) \
+	GL_FUNCTION(glVertexAttrib4iv, PFNGLVERTEXATTRIB4IVPROC) \
+	GL_FUNCTION(glVertexAttrib4s, PFNGLVERTEXATTRIB4SPROC) \
+	GL_FUNCTION(glVertexAttrib4sv, PFNGLVERTEXATTRIB4SVPROC) \
+	GL_FUNCTION(glVertexAttrib4ubv, PFNGLVERTEXATTRIB4UBVPROC) \
+	GL_FUNCTION(glVertexAttrib4uiv, PFNGLVERTEXATTRIB4UIVPROC) \
+	GL_FUNCTION(glVertexAttrib4usv, PFNGLVERTEXATTRIB4USVPROC) \
+	GL_FUNCTION(glVertexAttribBinding, PFNGLVERTEXATTRIBBINDINGPROC) \
+	GL_FUNCTION(glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC) \
+	GL_FUNCTION(glVertexAttribFormat, PFNGLVERTEXATTRIBFORMATPROC) \
+	GL_FUNCTION(glVertexAttribI1i, PFNGLVERTEXATTRIBI1IPROC) \
+	GL_FUNCTION(glVertexAttribI1iv, PFNGLVERTEXATTRIBI1IVPROC) \
+	GL_FUNCTION(glVertexAttribI1ui, PFNGLVERTEXATTRIBI1UIPROC) \
+	GL_FUNCTION(glVertexAttribI1uiv, PFNGLVERTEXATTRIBI1UIVPROC) \
+	GL_FUNCTION(glVertexAttribI2i, PFNGLVERTEXATTRIBI2IPROC) \
+	GL_FUNCTION(glVertexAttribI2iv, PFNGLVERTEXATTRIBI2IVPROC) \
+	GL_FUNCTION(glVertexAttribI2ui, PFNGLVERTEXATTRIBI2UIPROC) \
+	GL_FUNCTION(glVertexAttribI2uiv, PFNGLVERTEXATTRIBI2UIVPROC) \
+	GL_FUNCTION(glVertexAttribI3i, PFNGLVERTEXATTRIBI3IPROC) \
+	GL_FUNCTION(glVertexAttribI3iv, PFNGLVERTEXATTRIBI3IVPROC) \
+	GL_FUNCTION(glVertexAttribI3ui, PFNGLVERTEXATTRIBI3UIPROC) \
+	GL_FUNCTION(glVertexAttribI3uiv, PFNGLVERTEXATTRIBI3UIVPROC) \
+	GL_FUNCTION(glVertexAttribI4bv, PFNGLVERTEXATTRIBI4BVPROC) \
+	GL_FUNCTION(glVertexAttribI4i, PFNGLVERTEXATTRIBI4IPROC) \
+	GL_FUNCTION(glVertexAttribI4iv, PFNGLVERTEXATTRIBI4IVPROC) \
+	GL_FUNCTION(glVertexAttribI4sv, PFNGLVERTEXATTRIBI4SVPROC) \
+	GL_FUNCTION(glVertexAttribI4ubv, PFNGLVERTEXATTRIBI4UBVPROC) \
+	GL_FUNCTION(glVertexAttribI4ui, PFNGLVERTEXATTRIBI4UIPROC) \
+	GL_FUNCTION(glVertexAttribI4uiv, PFNGLVERTEXATTRIBI4UIVPROC) \
+	GL_FUNCTION(glVertexAttribI4usv, PFNGLVERTEXATTRIBI4USVPROC) \
+	GL_FUNCTION(glVertexAttribIFormat, PFNGLVERTEXATTRIBIFORMATPROC) \
+	GL_FUNCTION(glVertexAttribIPointer, PFNGLVERTEXATTRIBIPOINTERPROC) \
+	GL_FUNCTION(glVertexAttribL1d, PFNGLVERTEXATTRIBL1DPROC) \
+	GL_FUNCTION(glVertexAttribL1dv, PFNGLVERTEXATTRIBL1DVPROC) \
+	GL_FUNCTION(glVertexAttribL2d, PFNGLVERTEXATTRIBL2DPROC) \
+	GL_FUNCTION(glVertexAttribL2dv, PFNGLVERTEXATTRIBL2DVPROC) \
+	GL_FUNCTION(glVertexAttribL3d, PFNGLVERTEXATTRIBL3DPROC) \
+	GL_FUNCTION(glVertexAttribL3dv, PFNGLVERTEXATTRIBL3DVPROC) \
+	GL_FUNCTION(glVertexAttribL4d, PFNGLVERTEXATTRIBL4DPROC) \
+	GL_FUNCTION(glVertexAttribL4dv, PFNGLVERTEXATTRIBL4DVPROC) \
+	GL_FUNCTION(glVertexAttribLFormat, PFNGLVERTEXATTRIBLFORMATPROC) \
+	GL_FUNCTION(glVertexAttribLPointer, PFNGLVERTEXATTRIBLPOINTERPROC) \
+	GL_FUNCTION(glVertexAttribP1ui, PFNGLVERTEXATTRIBP1UIPROC) \
+	GL_FUNCTION(glVertexAttribP1uiv, PFNGLVERTEXATTRIBP1UIVPROC) \
+	GL_FUNCTION(glVertexAttribP2ui, PFNGLVERTEXATTRIBP2UIPROC) \
+	GL_FUNCTION(glVertexAttribP2uiv, PFNGLVERTEXATTRIBP2UIVPROC) \
+	GL_FUNCTION(glVertexAttribP3ui, PFNGLVERTEXATTRIBP3UIPROC) \
+	GL_FUNCTION(glVertexAttribP3uiv, PFNGLVERTEXATTRIBP3UIVPROC) \
+	GL_FUNCTION(glVertexAttribP4ui, PFNGLVERTEXATTRIBP4UIPROC) \
+	GL_FUNCTION(glVertexAttribP4uiv, PFNGLVERTEXATTRIBP4UIVPROC) \
+	GL_FUNCTION(glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC) \
+	GL_FUNCTION(glVertexBindingDivisor, PFNGLVERTEXBINDINGDIVISORPROC) \
+	GL_FUNCTION(glVertexP2ui, PFNGLVERTEXP2UIPROC) \
+	GL_FUNCTION(glVertexP2uiv, PFNGLVERTEXP2UIVPROC) \
+	GL_FUNCTION(glVertexP3ui, PFNGLVERTEXP3UIPROC) \
+	GL_FUNCTION(glVertexP3uiv, PFNGLVERTEXP3UIVPROC) \
+	GL_FUNCTION(glVertexP4ui, PFNGLVERTEXP4UIPROC) \
+	GL_FUNCTION(glVertexP4uiv, PFNGLVERTEXP4UIVPROC) \
+	GL_FUNCTION(glViewport, PFNGLVIEWPORTPROC) \
+	GL_FUNCTION(glViewportArrayv, PFNGLVIEWPORTARRAYVPROC) \
+	GL_FUNCTION(glViewportIndexedf, PFNGLVIEWPORTINDEXEDFPROC) \
+	GL_FUNCTION(glViewportIndexedfv, PFNGLVIEWPORTINDEXEDFVPROC) \
+	GL_FUNCTION(glWaitSync, PFNGLWAITSYNCPROC)
+
+//index of every entry point, GLID_glDrawArrays and so on, for tables that cover all of them
+enum GLFunctionId {
+#define GL_FUNCTION(name, type) GLID_##name,
+	GL_FUNCTION_LIST
+#undef GL_FUNCTION
+	GL_FUNCTION_COUNT
+};
+
+inline const char* const glFunctionNames[GL_FUNCTION_COUNT] = {
+#define GL_FUNCTION(name, type) #name,
+	GL_FUNCTION_LIST
+#undef GL_FUNCTION
+};
+
+
+//the GL version that introduced each entry point as major * 10 + minor, in GLFunctionId order.
+//generated from the load_GL_VERSION_x_y functions of glad.c together with the list above
+inline const unsigned char glFunctionVersions[GL_FUNCTION_COUNT] = {
+	41, 13, 20, 30, 15, 40, 30, 20, 15, 30, 30, 44, 44, 30, 33, 30, 42, 44, 41, 30,
+	33, 44, 11, 45, 44, 40, 30, 43, 44, 14, 14, 20, 40, 40, 10, 14, 40, 40, 30, 45,
+	15, 44, 15, 30, 45, 30, 10, 43, 43, 30, 30, 30, 30, 10, 10, 41, 45, 45, 45, 45,
+	45, 45, 10, 44, 44, 32, 45, 10, 30, 33, 33, 33, 33, 20, 13, 13, 13, 13, 13, 13,
+	45, 45, 45, 31, 43, 45, 11, 11, 11, 11, 12, 45, 45, 45, 45, 45, 20, 45, 45, 45,
+	45, 20, 41, 45, 45, 45, 10, 43, 43, 43, 15, 30, 20, 41, 15, 30, 33, 20, 32, 11,
+	40, 30, 10, 10, 10, 41, 41, 41, 20, 10, 45, 20, 30, 43, 43, 11, 40, 31, 42, 10,
+	20, 11, 32, 40, 31, 42, 32, 42, 12, 32, 40, 42, 40, 42, 10, 45, 20, 30, 30, 15,
+	40, 30, 32, 10, 10, 30, 45, 43, 30, 32, 30, 30, 30, 30, 10, 15, 30, 41, 15, 30,
+	33, 11, 40, 30, 30, 45, 42, 20, 40, 40, 40, 20, 31, 31, 31, 31, 20, 20, 30, 10,
+	32, 15, 15, 15, 13, 45, 45, 43, 41, 10, 10, 41, 10, 33, 30, 30, 43, 45, 32, 32,
+	30, 10, 43, 42, 32, 45, 45, 45, 45, 45, 45, 45, 43, 43, 43, 41, 20, 43, 41, 41,
+	43, 43, 43, 43, 43, 40, 20, 45, 45, 45, 45, 40, 33, 15, 33, 15, 15, 30, 33, 33,
+	33, 33, 20, 41, 20, 20, 10, 30, 40, 40, 32, 10, 10, 10, 30, 30, 10, 10, 45, 45,
+	45, 45, 45, 45, 45, 45, 30, 45, 45, 45, 31, 31, 20, 40, 40, 20, 20, 30, 45, 45,
+	45, 30, 30, 41, 20, 20, 20, 20, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 10, 43, 43, 43, 45, 45, 43, 43, 43, 15, 10, 30, 30, 20,
+	41, 15, 30, 33, 20, 32, 11, 40, 30, 10, 20, 10, 15, 30, 45, 45, 42, 45, 40, 14,
+	43, 46, 14, 32, 43, 46, 33, 33, 33, 33, 33, 33, 33, 33, 45, 45, 45, 45, 45, 45,
+	45, 45, 45, 45, 45, 45, 33, 33, 43, 43, 40, 40, 40, 10, 10, 14, 14, 14, 14, 10,
+	10, 11, 46, 43, 31, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+	41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+	41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 32, 43, 33,
+	10, 10, 45, 41, 30, 30, 40, 13, 32, 33, 33, 33, 33, 33, 33, 10, 41, 41, 41, 33,
+	33, 41, 20, 43, 46, 10, 20, 10, 20, 10, 20, 31, 43, 33, 33, 33, 33, 33, 33, 33,
+	33, 10, 10, 32, 12, 32, 30, 30, 10, 10, 10, 10, 42, 42, 43, 42, 43, 11, 11, 12,
+	45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 43, 45, 45,
+	30, 40, 40, 20, 20, 20, 20, 30, 30, 40, 40, 20, 20, 20, 20, 30, 30, 40, 40, 20,
+	20, 20, 20, 30, 30, 40, 40, 20, 20, 20, 20, 30, 30, 31, 40, 20, 40, 21, 40, 21,
+	40, 20, 40, 21, 40, 21, 40, 20, 40, 21, 40, 21, 40, 15, 45, 20, 41, 20, 41, 45,
+	45, 45, 45, 45, 45, 45, 45, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+	20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+	20, 20, 20, 43, 33, 43, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+	30, 30, 30, 30, 30, 30, 43, 30, 41, 41, 41, 41, 41, 41, 41, 41, 43, 41, 33, 33,
+	33, 33, 33, 33, 33, 33, 20, 43, 33, 33, 33, 33, 33, 33, 10, 41, 41, 41, 32
+};
+
+
+//GL arguments and results as 64 bit words, for code that treats every entry point alike
+template<typename T>
+inline uint64_t glArgumentBits(T value) {
+	static_assert(sizeof(T) <= sizeof(uint64_t), "GL arguments fit in 64 bits");
+	uint64_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(T));
+	return bits;
+}
+template<typename T>
+inline T glArgumentFromBits(uint64_t bits) {
+	T value;
+	std::memcpy(&value, &bits, sizeof(T));
+	return value;
+}
+
+//parameter count of an entry point's pointer type, and a bit per parameter that is a pointer
+template<typename T>
+struct GLSignature;
+template<typename R, typename... A>
+struct GLSignature<R(APIENTRYP)(A...)> {
+	static const int argumentCount = (int)sizeof...(A);
+	static uint32_t pointerMask() {
+		//leading false keeps the array non empty for entry points without parameters
+		const bool pointers[] = { false, std::is_pointer<A>::value... };
+		uint32_t mask = 0;
+		for (int i = 0; i < argumentCount; i++) {
+			if (pointers[i + 1]) mask |= 1u << i;
+		}
+		return mask;
+	}
+};
+
+inline const int glArgumentCounts[GL_FUNCTION_COUNT] = {
+#define GL_FUNCTION(name, type) GLSignature<type>::argumentCount,
+	GL_FUNCTION_LIST
+#undef GL_FUNCTION
+};
+inline const uint32_t glPointerMasks[GL_FUNCTION_COUNT] = {
+#define GL_FUNCTION(name, type) GLSignature<type>::pointerMask(),
+	GL_FUNCTION_LIST
+#undef GL_FUNCTION
+};
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef GL_INTERCEPT_H
+#define GL_INTERCEPT_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <iostream>
+#include "GLFunctions.h"
+
+
+//opt-in instrumentation of every GL call. install() swaps each loaded glad pointer for a thunk
+//that counts the call, optionally times it, then forwards to the driver's function. nothing
+//is swapped until install(), so when it is off GL calls go straight to the driver as before.
+//call endFrame() once per frame for the per-frame report
+namespace GLIntercept {
+
+	struct Counter {
+		uint64_t calls = 0;
+		//calls that set state to the value it already had
+		uint64_t redundant = 0;
+		uint64_t nanoseconds = 0;
+	};
+
+	inline bool installed = false;
+	//timing costs two clock reads per call, counting alone is a few instructions
+	inline bool timing = false;
+	//print every this many frames, 0 only keeps totals for summary()
+	inline int reportInterval = 60;
+	//an entry point called this often in one frame is marked HOT
+	inline uint64_t hotCallsPerFrame = 1000;
+	inline size_t reportLimit = 10;
+
+	inline Counter frameCounters[GL_FUNCTION_COUNT];
+	inline Counter totalCounters[GL_FUNCTION_COUNT];
+	inline uint64_t frames = 0;
+
+	//how a call's arguments relate to state that an identical later call would not change.
+	//only entry points whose arguments are all values are tracked, a pointer argument says
+	//nothing about what it points at
+	enum StateRule : uint8_t {
+		NOT_STATE,
+		//the whole call is one piece of state, glUseProgram or glViewport
+		STATE,
+		//one piece of state per first argument, glBindBuffer per target
+		STATE_PER_TARGET,
+		//glEnable and glDisable share one piece of state per capability
+		CAPABILITY,
+		//glUniform* with values, state per location of the program in use
+		UNIFORM,
+		//glBindBufferBase and glBindBufferRange also replace the glBindBuffer binding
+		REPLACES_BUFFER_BINDING,
+		//deletes and relinks can reset bindings and uniforms behind our back
+		FORGETS_STATE
+	};
+	inline uint8_t rules[GL_FUNCTION_COUNT];
+	//state key to hash of the arguments that last set it
+	inline std::unordered_map<uint64_t, uint64_t> state;
+	inline uint64_t currentProgram = 0;
+
+	inline uint64_t firstArgument() {
+		return 0;
+	}
+	template<typename F, typename... R>
+	inline uint64_t firstArgument(F first, R...) {
+		return glArgumentBits(first);
+	}
+	template<typename... A>
+	inline uint64_t hashArguments(A... args) {
+		uint64_t hash = 14695981039346656037ull;
+		((hash = (hash ^ glArgumentBits(args)) * 1099511628211ull), ...);
+		return hash;
+	}
+	inline uint64_t combine(uint64_t a, uint64_t b) {
+		return (a ^ b) * 1099511628211ull + (a << 6);
+	}
+
+	//true when this call leaves the tracked state exactly as it was
+	inline bool redundant(int id, uint64_t first, uint64_t arguments) {
+		uint64_t key;
+		switch (rules[id]) {
+		case STATE:
+			if (id == GLID_glUseProgram) currentProgram = first;
+			key = (uint64_t)id;
+			break;
+		case STATE_PER_TARGET:
+			//the element array binding belongs to the VAO, which changes it behind our back
+			if (id == GLID_glBindBuffer && first == GL_ELEMENT_ARRAY_BUFFER) return false;
+			key = combine(id, first);
+			break;
+		case CAPABILITY:
+			key = combine(GLID_glEnable, first);
+			arguments = combine(arguments, id);
+			break;
+		case UNIFORM:
+			key = combine(combine(id, currentProgram), first);
+			break;
+		case REPLACES_BUFFER_BINDING:
+			state.erase(combine(GLID_glBindBuffer, first));
+			return false;
+		case FORGETS_STATE:
+			state.clear();
+			return false;
+		default:
+			return false;
+		}
+		auto found = state.find(key);
+		if (found != state.end() && found->second == arguments) return true;
+		state[key] = arguments;
+		return false;
+	}
+
+	//adds the elapsed time to a counter when the forwarded call returns
+	struct ScopedTimer {
+		uint64_t& nanoseconds;
+		std::chrono::high_resolution_clock::time_point start;
+		explicit ScopedTimer(uint64_t& nanoseconds) : nanoseconds(nanoseconds), start(std::chrono::high_resolution_clock::now()) {}
+		~ScopedTimer() {
+			nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+	};
+
+	//one thunk per entry point, real holds the pointer glad loaded
+	template<int Id, typename T>
+	struct Thunk;
+	template<int Id, typename R, typename... A>
+	struct Thunk<Id, R(APIENTRYP)(A...)> {
+		using Pointer = R(APIENTRYP)(A...);
+		static inline Pointer real = NULL;
+
+		static R APIENTRY call(A... args) {
+			Counter& counter = frameCounters[Id];
+			counter.calls++;
+			if (rules[Id] != NOT_STATE && redundant(Id, firstArgument(args...), hashArguments(args...))) counter.redundant++;
+			if (!timing) return real(args...);
+			ScopedTimer timer(counter.nanoseconds);
+			return real(args...);
+		}
+	};
+
+	inline bool startsWith(const char* name, const char* prefix) {
+		return std::strncmp(name, prefix, std::strlen(prefix)) == 0;
+	}
+
+	inline void classify() {
+		static const char* const whole[] = {
+			"glUseProgram", "glBindVertexArray", "glActiveTexture", "glViewport", "glScissor", "glClearColor",
+			"glClearDepth", "glClearDepthf", "glDepthFunc", "glDepthMask", "glColorMask", "glBlendFunc",
+			"glBlendEquation", "glCullFace", "glFrontFace", "glClipControl", "glLineWidth", "glPointSize"
+		};
+		static const char* const perTarget[] = { "glBindBuffer", "glPixelStorei", "glPolygonMode", "glPatchParameteri" };
+		static const char* const uniforms[] = {
+			"glUniform1f", "glUniform2f", "glUniform3f", "glUniform4f", "glUniform1i", "glUniform2i", "glUniform3i",
+			"glUniform4i", "glUniform1ui", "glUniform2ui", "glUniform3ui", "glUniform4ui"
+		};
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			const char* name = glFunctionNames[id];
+			rules[id] = NOT_STATE;
+			for (const char* w : whole) if (std::strcmp(name, w) == 0) rules[id] = STATE;
+			for (const char* t : perTarget) if (std::strcmp(name, t) == 0) rules[id] = STATE_PER_TARGET;
+			for (const char* u : uniforms) if (std::strcmp(name, u) == 0) rules[id] = UNIFORM;
+			if (std::strcmp(name, "glEnable") == 0 || std::strcmp(name, "glDisable") == 0) rules[id] = CAPABILITY;
+			if (std::strcmp(name, "glBindBufferBase") == 0 || std::strcmp(name, "glBindBufferRange") == 0) {
+				rules[id] = REPLACES_BUFFER_BINDING;
+			}
+			if (startsWith(name, "glDelete") || std::strcmp(name, "glLinkProgram") == 0) rules[id] = FORGETS_STATE;
+		}
+	}
+
+	//call after gladLoadGL. entry points the context does not have stay NULL so availability
+	//checks such as glClipControl != NULL still work
+	inline void install(bool withTiming) {
+		timing = withTiming;
+		if (installed) return;
+		classify();
+		state.clear();
+#define GL_FUNCTION(name, type) \
+		if (glad_##name != NULL) { \
+			Thunk<GLID_##name, type>::real = glad_##name; \
+			glad_##name = &Thunk<GLID_##name, type>::call; \
+		}
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+		installed = true;
+	}
+
+	inline void uninstall() {
+		if (!installed) return;
+#define GL_FUNCTION(name, type) \
+		if (glad_##name == &Thunk<GLID_##name, type>::call) glad_##name = Thunk<GLID_##name, type>::real;
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+		installed = false;
+	}
+
+	//entries of counters with any calls, most expensive first: by time when timing, else by calls
+	inline std::vector<int> ranked(const Counter* counters) {
+		std::vector<int> used;
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			if (counters[id].calls > 0) used.push_back(id);
+		}
+		std::sort(used.begin(), used.end(), [counters](int a, int b) {
+			if (timing && counters[a].nanoseconds != counters[b].nanoseconds) return counters[a].nanoseconds > counters[b].nanoseconds;
+			return counters[a].calls > counters[b].calls;
+		});
+		return used;
+	}
+
+	//divisor turns totals into per frame averages
+	inline void print(const char* title, const Counter* counters, double divisor) {
+		Counter sum;
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			sum.calls += counters[id].calls;
+			sum.redundant += counters[id].redundant;
+			sum.nanoseconds += counters[id].nanoseconds;
+		}
+		std::cout << "GL_INTERCEPT " << title << ": " << sum.calls / divisor << " calls, " << sum.redundant / divisor << " redundant";
+		if (timing) std::cout << ", " << sum.nanoseconds / divisor / 1000000.0 << " ms in GL";
+		std::cout << std::endl;
+
+		std::vector<int> used = ranked(counters);
+		for (size_t i = 0; i < used.size() && i < reportLimit; i++) {
+			const Counter& c = counters[used[i]];
+			std::cout << "  " << glFunctionNames[used[i]] << " " << c.calls / divisor << " calls";
+			if (c.redundant > 0) std::cout << ", " << c.redundant / divisor << " redundant";
+			if (timing) std::cout << ", " << c.nanoseconds / divisor / 1000000.0 << " ms";
+			if (c.calls / divisor >= hotCallsPerFrame) std::cout << " HOT";
+			std::cout << std::endl;
+		}
+	}
+
+	inline void endFrame() {
+		if (!installed) return;
+		frames++;
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) {
+			totalCounters[id].calls += frameCounters[id].calls;
+			totalCounters[id].redundant += frameCounters[id].redundant;
+			totalCounters[id].nanoseconds += frameCounters[id].nanoseconds;
+		}
+		if (reportInterval > 0 && frames % reportInterval == 0) {
+			std::string title = "frame " + std::to_string(frames);
+			print(title.c_str(), frameCounters, 1.0);
+		}
+		for (Counter& counter : frameCounters) counter = Counter();
+	}
+
+	//averages over every frame since install
+	inline void summary() {
+		if (!installed || frames == 0) return;
+		std::string title = "average of " + std::to_string(frames) + " frames";
+		print(title.c_str(), totalCounters, (double)frames);
+	}
+}
+
+#endif
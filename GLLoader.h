@@ -0,0 +1,182 @@
+#ifndef GL_LOADER_H
+#define GL_LOADER_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <unordered_set>
+#include <iostream>
+#include "GLFunctions.h"
+#include "Benchmark.h"
+
+
+//replacement for gladLoadGLLoader that resolves only the entry points of the version the app
+//asked for and leaves the rest to resolve on their first call. gladLoadGLLoader looks up all
+//699 entry points up to 4.6 and copies the extension list only to throw it away; this looks
+//up the requested tier, and reads extensions into a hash set the first time one is queried.
+//entry points above the context's version stay NULL, exactly as glad leaves them
+namespace GLLoader {
+
+	struct Stats {
+		int contextMajor = 0;
+		int contextMinor = 0;
+		//looked up during load(), and later through the first call
+		int eager = 0;
+		int lazy = 0;
+		int lazyResolved = 0;
+		double milliseconds = 0.0;
+	};
+
+	inline GLADloadproc loadProc = NULL;
+	inline Stats stats;
+	inline bool extensionsRead = false;
+	inline std::unordered_set<std::string> extensions;
+
+	//stands in for an entry point until its first call, then looks it up. the glad pointer is
+	//only replaced when nothing has been installed over the stub since, otherwise the stub
+	//stays in the chain and forwards
+	template<int Id, typename T>
+	struct Lazy;
+	template<int Id, typename R, typename... A>
+	struct Lazy<Id, R(APIENTRYP)(A...)> {
+		using Pointer = R(APIENTRYP)(A...);
+		static inline Pointer* slot = NULL;
+		static inline Pointer resolved = NULL;
+
+		static R APIENTRY call(A... args) {
+			if (resolved == NULL) {
+				resolved = (Pointer)loadProc(glFunctionNames[Id]);
+				if (resolved == NULL) {
+					std::cout << "ERROR::GL_LOADER::MISSING_ENTRY_POINT " << glFunctionNames[Id] << std::endl;
+					return R();
+				}
+				stats.lazyResolved++;
+				if (*slot == &Lazy::call) *slot = resolved;
+			}
+			return resolved(args...);
+		}
+	};
+
+	//"4.6.0 NVIDIA 550.54", or with an "OpenGL ES " style prefix on some drivers
+	inline bool parseVersion(const char* version, int& major, int& minor) {
+		if (version == NULL) return false;
+		while (*version && (*version < '0' || *version > '9')) version++;
+		return std::sscanf(version, "%d.%d", &major, &minor) == 2;
+	}
+
+	//loads for a context created as requestMajor.requestMinor. with lazy off every entry point
+	//the context has is looked up now, which is what gladLoadGLLoader does. returns false
+	//when there is no current context
+	inline bool load(GLADloadproc proc, int requestMajor, int requestMinor, bool lazy = true) {
+		auto start = std::chrono::high_resolution_clock::now();
+		loadProc = proc;
+		stats = Stats();
+		extensionsRead = false;
+		extensions.clear();
+
+		glad_glGetString = (PFNGLGETSTRINGPROC)proc("glGetString");
+		if (glad_glGetString == NULL) return false;
+		int major = 0, minor = 0;
+		if (!parseVersion((const char*)glad_glGetString(GL_VERSION), major, minor)) return false;
+		stats.contextMajor = major;
+		stats.contextMinor = minor;
+		GLVersion.major = major;
+		GLVersion.minor = minor;
+		int context = major * 10 + minor;
+		int tier = lazy ? requestMajor * 10 + requestMinor : context;
+
+		GLAD_GL_VERSION_1_0 = context >= 10; GLAD_GL_VERSION_1_1 = context >= 11; GLAD_GL_VERSION_1_2 = context >= 12;
+		GLAD_GL_VERSION_1_3 = context >= 13; GLAD_GL_VERSION_1_4 = context >= 14; GLAD_GL_VERSION_1_5 = context >= 15;
+		GLAD_GL_VERSION_2_0 = context >= 20; GLAD_GL_VERSION_2_1 = context >= 21; GLAD_GL_VERSION_3_0 = context >= 30;
+		GLAD_GL_VERSION_3_1 = context >= 31; GLAD_GL_VERSION_3_2 = context >= 32; GLAD_GL_VERSION_3_3 = context >= 33;
+		GLAD_GL_VERSION_4_0 = context >= 40; GLAD_GL_VERSION_4_1 = context >= 41; GLAD_GL_VERSION_4_2 = context >= 42;
+		GLAD_GL_VERSION_4_3 = context >= 43; GLAD_GL_VERSION_4_4 = context >= 44; GLAD_GL_VERSION_4_5 = context >= 45;
+		GLAD_GL_VERSION_4_6 = context >= 46;
+
+#define GL_FUNCTION(name, type) \
+		if (glFunctionVersions[GLID_##name] > context) { \
+			glad_##name = NULL; \
+		} \
+		else if (glFunctionVersions[GLID_##name] <= tier) { \
+			glad_##name = (type)proc(#name); \
+			stats.eager++; \
+		} \
+		else { \
+			Lazy<GLID_##name, type>::slot = &glad_##name; \
+			Lazy<GLID_##name, type>::resolved = NULL; \
+			glad_##name = &Lazy<GLID_##name, type>::call; \
+			stats.lazy++; \
+		}
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+
+		stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return true;
+	}
+
+	//constant time after the first query, which reads the context's list once
+	inline bool hasExtension(const char* name) {
+		if (!extensionsRead) {
+			extensionsRead = true;
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+			extensions.reserve((size_t)count);
+			for (GLint i = 0; i < count; i++) {
+				const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+				if (extension != NULL) extensions.insert(extension);
+			}
+		}
+		return extensions.count(name) > 0;
+	}
+
+	inline GLADloadproc countedProc = NULL;
+	inline int lookups = 0;
+	inline void* countingProc(const char* name) {
+		lookups++;
+		return countedProc(name);
+	}
+
+	inline void report() {
+		std::cout << "GL_LOADER context " << stats.contextMajor << "." << stats.contextMinor << ": " << stats.eager
+			<< " entry points looked up at load, " << stats.lazy << " deferred (" << stats.lazyResolved
+			<< " since resolved), " << stats.milliseconds << " ms" << std::endl;
+	}
+
+	//gladLoadGLLoader against load() with and without deferring, in the current context, for a
+	//context requested as requestMajor.requestMinor. ends with the lazy load so the app keeps
+	//running on it
+	inline void benchmarkLoader(GLADloadproc proc, int requestMajor, int requestMinor) {
+		countedProc = proc;
+		const int warmup = 2, repetitions = 20;
+		struct Variant {
+			const char* name;
+			int mode;
+		};
+		const Variant variants[] = { { "gladLoadGLLoader", 0 }, { "GLLoader eager", 1 }, { "GLLoader lazy", 2 } };
+		std::string requested = " (requested " + std::to_string(requestMajor) + "." + std::to_string(requestMinor) + ")";
+		for (const Variant& variant : variants) {
+			lookups = 0;
+			runBenchmark(std::string("loader ") + variant.name + requested, warmup, repetitions, [&]() {
+				if (variant.mode == 0) gladLoadGLLoader((GLADloadproc)countingProc);
+				else load((GLADloadproc)countingProc, requestMajor, requestMinor, variant.mode == 2);
+			}).report();
+			std::cout << "  " << lookups / (warmup + repetitions) << " proc lookups per load" << std::endl;
+		}
+
+		//the first query reads the list, every other one is a hash lookup
+		const int queries = 10000;
+		runBenchmark("extension query hashed" + requested, 1, 10, [&]() {
+			int found = 0;
+			for (int i = 0; i < queries; i++) found += hasExtension(i % 2 ? "GL_ARB_clip_control" : "GL_KHR_no_such_extension");
+			doNotOptimize(found);
+		}, queries).report();
+		load(proc, requestMajor, requestMinor, true);
+		report();
+	}
+}
+
+#endif
@@ -0,0 +1,386 @@
+#ifndef GL_REPLAY_H
+#define GL_REPLAY_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <iostream>
+#include "GLFunctions.h"
+#include "GLCapture.h"
+
+
+//calls an entry point with arguments held as 64 bit words
+template<typename T>
+struct GLInvoke;
+template<typename R, typename... A>
+struct GLInvoke<R(APIENTRYP)(A...)> {
+	using Pointer = R(APIENTRYP)(A...);
+
+	template<size_t... I>
+	static uint64_t call(Pointer function, const uint64_t* raw, std::index_sequence<I...>) {
+		(void)raw;
+		if constexpr (std::is_void<R>::value) {
+			function(glArgumentFromBits<A>(raw[I])...);
+			return 0;
+		}
+		else {
+			return glArgumentBits(function(glArgumentFromBits<A>(raw[I])...));
+		}
+	}
+};
+
+
+//plays back a file written by GLCapture. load() decodes the whole file up front so replaying
+//costs little more than the GL calls themselves. object names, uniform locations, syncs and
+//mapped pointers are translated from the captured run's values to this context's
+class GLReplay {
+public:
+	int glMajor = 0;
+	int glMinor = 0;
+	int width = 0;
+	int height = 0;
+	//calls to entry points this context does not have, skipped
+	uint64_t skipped = 0;
+	//calls without an argument spec that passed a pointer, skipped because the pointer is an
+	//address in the capturing process
+	uint64_t unsafe = 0;
+
+	bool load(const std::string& path) {
+		std::ifstream in(path, std::ios::binary);
+		if (!in) {
+			std::cout << "ERROR::GL_REPLAY::CANNOT_READ " << path << std::endl;
+			return false;
+		}
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		position = 0;
+		failed = false;
+		if (bytes.size() < sizeof(GLCapture::MAGIC) || std::memcmp(bytes.data(), GLCapture::MAGIC, sizeof(GLCapture::MAGIC)) != 0) {
+			std::cout << "ERROR::GL_REPLAY::NOT_A_CAPTURE " << path << std::endl;
+			return false;
+		}
+		position = sizeof(GLCapture::MAGIC);
+		if (varint() != GLCapture::VERSION) {
+			std::cout << "ERROR::GL_REPLAY::UNKNOWN_VERSION " << path << std::endl;
+			return false;
+		}
+		glMajor = (int)varint();
+		glMinor = (int)varint();
+		width = (int)varint();
+		height = (int)varint();
+
+		//the capturing build's function table, matched to ours by name
+		uint64_t functionCount = varint();
+		std::unordered_map<std::string, int> ids;
+		for (int id = 0; id < GL_FUNCTION_COUNT; id++) ids[glFunctionNames[id]] = id;
+		std::vector<int> localIds(functionCount, -1);
+		std::vector<std::vector<GLCapture::ArgSpec>> specs(functionCount);
+		std::vector<char> results(functionCount, 0);
+		for (uint64_t k = 0; k < functionCount && !failed; k++) {
+			std::string name = text();
+			std::string spec = text();
+			auto found = ids.find(name);
+			if (found != ids.end()) localIds[k] = found->second;
+			if (!GLCapture::parseSpec(spec.c_str(), specs[k], results[k])) {
+				std::cout << "ERROR::GL_REPLAY::BAD_SPEC " << name << std::endl;
+				return false;
+			}
+			if (found != ids.end() && !spec.empty() && !GLCapture::matchesSignature(found->second, specs[k])) {
+				std::cout << "ERROR::GL_REPLAY::SIGNATURE_MISMATCH " << name << std::endl;
+				return false;
+			}
+		}
+
+		commands.clear();
+		args.clear();
+		frameEnds.clear();
+		while (!failed) {
+			uint64_t k = varint();
+			if (k == functionCount) {
+				frameEnds.push_back(commands.size());
+				continue;
+			}
+			if (k == functionCount + 1) break;
+			if (k == functionCount + 2) {
+				decodeMappedWrite();
+				continue;
+			}
+			if (k > functionCount || localIds[k] < 0) {
+				std::cout << "ERROR::GL_REPLAY::UNKNOWN_FUNCTION " << k << std::endl;
+				return false;
+			}
+			decode(localIds[k], specs[k], results[k]);
+		}
+		if (failed) {
+			std::cout << "ERROR::GL_REPLAY::TRUNCATED " << path << std::endl;
+			return false;
+		}
+		std::cout << "GL_REPLAY " << path << ": " << commands.size() << " commands, " << frameCount()
+			<< " frames including setup, captured on GL " << glMajor << "." << glMinor << std::endl;
+		return true;
+	}
+
+	//frame 0 is setup, 1 to frameCount() - 1 are the captured frames
+	size_t frameCount() const { return frameEnds.size(); }
+
+	//needs the context current with glad loaded
+	void replayFrame(size_t frame) {
+		if (available.empty()) prepare();
+		size_t begin = frame == 0 ? 0 : frameEnds[frame - 1];
+		for (size_t i = begin; i < frameEnds[frame]; i++) execute(commands[i]);
+	}
+
+private:
+	struct Arg {
+		GLCapture::ArgSpec spec;
+		unsigned char tag;
+		uint64_t value;
+		const unsigned char* data;
+		size_t count;
+	};
+	struct Command {
+		int id;
+		char result;
+		size_t firstArg;
+		size_t argCount;
+		uint64_t capturedResult;
+		const unsigned char* payload;
+		size_t payloadSize;
+		//where a mapped write goes in its mapping
+		uint64_t offset = 0;
+	};
+	//id of a write through a persistent mapping, capturedResult is the mapping's index
+	static const int MAPPED_WRITE = -1;
+	using Invoker = uint64_t(*)(const uint64_t*);
+
+	std::vector<unsigned char> bytes;
+	size_t position = 0;
+	bool failed = false;
+	std::vector<Command> commands;
+	std::vector<Arg> args;
+	//names read and created by A and G arguments, and the strings of S arguments
+	std::vector<uint64_t> arrays;
+	std::vector<const char*> strings;
+	std::vector<size_t> frameEnds;
+
+	std::vector<Invoker> invokers;
+	std::vector<bool> available;
+	std::unordered_map<uint64_t, uint64_t> names[8];
+	std::unordered_map<uint64_t, uint64_t> locations;
+	std::unordered_map<uint64_t, uint64_t> syncs;
+	std::unordered_map<uint64_t, void*> mapped;
+	//in the order they were mapped, the index a mapped write refers to
+	std::vector<void*> persistentMapped;
+	uint64_t currentProgram = 0;
+	std::vector<GLuint> nameScratch;
+	std::vector<unsigned char> scratch[16];
+
+	uint64_t varint() {
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			if (position >= bytes.size()) {
+				failed = true;
+				return 0;
+			}
+			unsigned char b = bytes[position++];
+			value |= (uint64_t)(b & 0x7f) << shift;
+			if (!(b & 0x80)) return value;
+		}
+		failed = true;
+		return 0;
+	}
+	//length prefixed bytes, left in the file buffer
+	const unsigned char* block(size_t& size) {
+		size = (size_t)varint();
+		if (failed || size > bytes.size() - position) {
+			failed = true;
+			size = 0;
+			return NULL;
+		}
+		const unsigned char* data = bytes.data() + position;
+		position += size;
+		return data;
+	}
+	std::string text() {
+		size_t size;
+		const unsigned char* data = block(size);
+		return data != NULL ? std::string((const char*)data, size) : std::string();
+	}
+
+	void decode(int id, const std::vector<GLCapture::ArgSpec>& spec, char result) {
+		Command command = { id, result, args.size(), 0, 0, NULL, 0 };
+		std::vector<GLCapture::ArgSpec> kinds = spec;
+		//entry points without a spec were written as plain values, their pointers are marked P
+		if (kinds.empty()) {
+			kinds.assign(glArgumentCounts[id], { 'v', -1 });
+			for (size_t i = 0; i < kinds.size(); i++) {
+				if (glPointerMasks[id] & (1u << i)) kinds[i].kind = 'P';
+			}
+		}
+		for (size_t i = 0; i < kinds.size(); i++) {
+			Arg arg = { kinds[i], 0, 0, NULL, 0 };
+			uint64_t previous = i > 0 ? args.back().value : 0;
+			switch (arg.spec.kind) {
+			case 'd': case 'x':
+				if (position >= bytes.size()) {
+					failed = true;
+					break;
+				}
+				arg.tag = bytes[position++];
+				if (arg.tag == GLCapture::POINTER_OFFSET) arg.value = varint();
+				else if (arg.tag == GLCapture::POINTER_DATA && arg.spec.kind == 'd') arg.data = block(arg.count);
+				else if (arg.tag == GLCapture::POINTER_DATA) arg.count = (size_t)varint();
+				break;
+			case 'z':
+				arg.data = block(arg.count);
+				break;
+			case 'S':
+				arg.value = strings.size();
+				arg.count = (size_t)previous;
+				for (size_t s = 0; s < arg.count && !failed; s++) {
+					size_t size;
+					strings.push_back((const char*)block(size));
+				}
+				break;
+			case 'A': case 'G':
+				arg.value = arrays.size();
+				arg.count = (size_t)previous;
+				for (size_t n = 0; n < arg.count && !failed; n++) arrays.push_back(varint());
+				break;
+			case 'n':
+				break;
+			default:
+				arg.value = varint();
+			}
+			args.push_back(arg);
+		}
+		command.argCount = kinds.size();
+		if (result == 'y' || result == 'u' || GLCapture::nameSpace(result) >= 0) command.capturedResult = varint();
+		if (id == GLID_glUnmapBuffer) command.payload = block(command.payloadSize);
+		commands.push_back(command);
+	}
+
+	void decodeMappedWrite() {
+		Command command = { MAPPED_WRITE, 0, args.size(), 0, 0, NULL, 0 };
+		command.capturedResult = varint();
+		command.offset = varint();
+		command.payload = block(command.payloadSize);
+		commands.push_back(command);
+	}
+
+	void prepare() {
+		invokers.assign(GL_FUNCTION_COUNT, NULL);
+		available.assign(GL_FUNCTION_COUNT, false);
+#define GL_FUNCTION(name, type) \
+		invokers[GLID_##name] = [](const uint64_t* raw) -> uint64_t { \
+			return GLInvoke<type>::call(glad_##name, raw, std::make_index_sequence<GLSignature<type>::argumentCount>()); \
+		}; \
+		available[GLID_##name] = glad_##name != NULL;
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+	}
+
+	//names the capture never saw created, such as 0 or the default framebuffer, pass through
+	uint64_t translate(const std::unordered_map<uint64_t, uint64_t>& map, uint64_t captured) const {
+		auto found = map.find(captured);
+		return found != map.end() ? found->second : captured;
+	}
+
+	void execute(const Command& command) {
+		if (command.id == MAPPED_WRITE) {
+			void* pointer = command.capturedResult < persistentMapped.size() ? persistentMapped[command.capturedResult] : NULL;
+			if (pointer != NULL && command.payloadSize > 0) {
+				std::memcpy((unsigned char*)pointer + command.offset, command.payload, command.payloadSize);
+			}
+			return;
+		}
+		if (!available[command.id]) {
+			skipped++;
+			return;
+		}
+		//a captured address means nothing here, and an output pointer would let the driver
+		//write anywhere. only NULL is safe to pass on
+		for (size_t j = 0; j < command.argCount; j++) {
+			const Arg& arg = args[command.firstArg + j];
+			if (arg.spec.kind == 'P' && arg.value != 0) {
+				unsafe++;
+				return;
+			}
+		}
+		uint64_t raw[16] = {};
+		for (size_t j = 0; j < command.argCount; j++) {
+			const Arg& arg = args[command.firstArg + j];
+			switch (arg.spec.kind) {
+			case 'N':
+				raw[j] = translate(names[arg.spec.space], arg.value);
+				break;
+			case 'u':
+				raw[j] = (uint32_t)translate(locations, (currentProgram << 32) | arg.value);
+				break;
+			case 'y':
+				raw[j] = translate(syncs, arg.value);
+				break;
+			case 'd': case 'x':
+				if (arg.tag == GLCapture::POINTER_OFFSET) raw[j] = arg.value;
+				else if (arg.tag == GLCapture::POINTER_NULL) raw[j] = 0;
+				else if (arg.spec.kind == 'd') raw[j] = (uintptr_t)arg.data;
+				else {
+					//queries whose size the capture does not know still get room for a few values
+					scratch[j].resize(std::max<size_t>(arg.count, 64));
+					raw[j] = (uintptr_t)scratch[j].data();
+				}
+				break;
+			case 'z':
+				raw[j] = (uintptr_t)arg.data;
+				break;
+			case 'S':
+				raw[j] = (uintptr_t)(strings.data() + arg.value);
+				break;
+			case 'n':
+				raw[j] = 0;
+				break;
+			case 'A': case 'G':
+				nameScratch.resize(arg.count);
+				for (size_t n = 0; n < arg.count; n++) {
+					nameScratch[n] = arg.spec.kind == 'A' ? (GLuint)translate(names[arg.spec.space], arrays[arg.value + n]) : 0;
+				}
+				raw[j] = (uintptr_t)nameScratch.data();
+				break;
+			default:
+				raw[j] = arg.value;
+			}
+		}
+
+		if (command.id == GLID_glUnmapBuffer) {
+			auto found = mapped.find(raw[0]);
+			if (found != mapped.end()) {
+				if (found->second != NULL && command.payloadSize > 0) std::memcpy(found->second, command.payload, command.payloadSize);
+				mapped.erase(found);
+			}
+		}
+
+		uint64_t result = invokers[command.id](raw);
+
+		for (size_t j = 0; j < command.argCount; j++) {
+			const Arg& arg = args[command.firstArg + j];
+			if (arg.spec.kind != 'G') continue;
+			for (size_t n = 0; n < arg.count; n++) names[arg.spec.space][arrays[arg.value + n]] = nameScratch[n];
+		}
+		int space = GLCapture::nameSpace(command.result);
+		if (space >= 0) names[space][command.capturedResult] = (uint32_t)result;
+		else if (command.result == 'u') locations[(raw[0] << 32) | command.capturedResult] = (uint32_t)result;
+		else if (command.result == 'y') syncs[command.capturedResult] = result;
+		else if (command.result == 'm' && (raw[3] & GL_MAP_PERSISTENT_BIT)) persistentMapped.push_back((void*)(uintptr_t)result);
+		else if (command.result == 'm') mapped[raw[0]] = (void*)(uintptr_t)result;
+		if (command.id == GLID_glUseProgram) currentProgram = raw[0];
+	}
+};
+
+#endif
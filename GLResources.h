@@ -0,0 +1,151 @@
+#ifndef GL_RESOURCES_H
+#define GL_RESOURCES_H
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <iostream>
+#include "VertexFormat.h"
+#include "GpuMemory.h"
+
+
+//creates buffers and vertex arrays through Direct State Access when the context has it
+//(4.5 or ARB_direct_state_access) and through the classic bind-to-edit path otherwise.
+//DSA never touches the current bindings, so setup leaves no state behind for draws to trip over
+class GLResources {
+public:
+	//number of GL calls issued by each part of the layer
+	struct CallCounts {
+		int setup = 0;
+		int frame = 0;
+	};
+	bool useDSA;
+	CallCounts calls;
+
+	GLResources() : useDSA(dsaAvailable()) {}
+	GLResources(bool forceBindPath) : useDSA(!forceBindPath && dsaAvailable()) {}
+
+	//glad only fills in the 4.5 pointers when the context version has them
+	static bool dsaAvailable() {
+		return glCreateBuffers != NULL && glNamedBufferStorage != NULL && glNamedBufferSubData != NULL
+			&& glCreateVertexArrays != NULL && glVertexArrayVertexBuffer != NULL && glVertexArrayAttribFormat != NULL
+			&& glVertexArrayAttribBinding != NULL && glEnableVertexArrayAttrib != NULL && glVertexArrayElementBuffer != NULL;
+	}
+
+	//immutable storage on the DSA path, dynamic buffers may be updated with updateBuffer.
+	//tag groups the buffer in GpuMemory's totals
+	unsigned int createBuffer(GLsizeiptr size, const void* data, bool dynamic = false, const char* tag = "buffer") {
+		unsigned int buffer;
+		if (useDSA) {
+			glCreateBuffers(1, &buffer);
+			glNamedBufferStorage(buffer, size, data, dynamic ? GL_DYNAMIC_STORAGE_BIT : 0);
+			calls.setup += 2;
+		}
+		else {
+			glGenBuffers(1, &buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, buffer);
+			glBufferData(GL_ARRAY_BUFFER, size, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			calls.setup += 4;
+		}
+		GpuMemory::track(GpuMemory::BUFFER, buffer, (size_t)size, tag);
+		return buffer;
+	}
+
+	//vertex array reading every attribute of format from binding 0, indexBuffer may be 0
+	unsigned int createVertexArray(const VertexFormat& format, unsigned int vertexBuffer, unsigned int indexBuffer = 0) {
+		unsigned int vao;
+		if (useDSA) {
+			glCreateVertexArrays(1, &vao);
+			glVertexArrayVertexBuffer(vao, 0, vertexBuffer, 0, format.stride);
+			calls.setup += 2;
+			for (const VertexFormat::Attribute& a : format.attributes) {
+				glVertexArrayAttribFormat(vao, a.index, a.size, a.type, a.normalized, a.offset);
+				glVertexArrayAttribBinding(vao, a.index, 0);
+				glEnableVertexArrayAttrib(vao, a.index);
+				calls.setup += 3;
+			}
+			if (indexBuffer != 0) {
+				glVertexArrayElementBuffer(vao, indexBuffer);
+				calls.setup++;
+			}
+		}
+		else {
+			glGenVertexArrays(1, &vao);
+			glBindVertexArray(vao);
+			glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+			calls.setup += 3;
+			for (const VertexFormat::Attribute& a : format.attributes) {
+				glVertexAttribPointer(a.index, a.size, a.type, a.normalized, format.stride, (void*)(size_t)a.offset);
+				glEnableVertexAttribArray(a.index);
+				calls.setup += 2;
+			}
+			if (indexBuffer != 0) {
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+				calls.setup++;
+			}
+			//unbind the VAO first so the element buffer binding stays attached to it
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			calls.setup += 2;
+		}
+		GpuMemory::track(GpuMemory::VERTEX_ARRAY, vao, 0, "vertex array");
+		return vao;
+	}
+
+	//per frame buffer update, the bind path has to bind and restore around the write
+	void updateBuffer(unsigned int buffer, GLintptr offset, GLsizeiptr size, const void* data) {
+		if (useDSA) {
+			glNamedBufferSubData(buffer, offset, size, data);
+			calls.frame++;
+		}
+		else {
+			glBindBuffer(GL_ARRAY_BUFFER, buffer);
+			glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			calls.frame += 3;
+		}
+	}
+
+	void deleteBuffer(unsigned int buffer) {
+		GpuMemory::destroy(GpuMemory::BUFFER, buffer);
+	}
+	void deleteVertexArray(unsigned int vao) {
+		GpuMemory::destroy(GpuMemory::VERTEX_ARRAY, vao);
+	}
+
+	void report() const {
+		std::cout << "GL_RESOURCES " << (useDSA ? "DSA" : "bind-to-edit") << " path: "
+			<< calls.setup << " setup calls, " << calls.frame << " frame calls" << std::endl;
+	}
+
+	//builds the same vertex array through both paths and prints calls and CPU time for each
+	static void compare(const VertexFormat& format, const void* vertices, GLsizeiptr size, int frames = 100) {
+		for (int pass = 0; pass < 2; pass++) {
+			bool bindPath = pass == 0;
+			if (!bindPath && !dsaAvailable()) {
+				std::cout << "GL_RESOURCES DSA not available on this context" << std::endl;
+				break;
+			}
+			GLResources resources(bindPath);
+			auto start = std::chrono::high_resolution_clock::now();
+			unsigned int buffer = resources.createBuffer(size, vertices, true);
+			unsigned int vao = resources.createVertexArray(format, buffer);
+			auto setupEnd = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < frames; i++) {
+				resources.updateBuffer(buffer, 0, size, vertices);
+			}
+			glFinish();
+			auto end = std::chrono::high_resolution_clock::now();
+
+			std::cout << "GL_RESOURCES::COMPARE " << (bindPath ? "bind-to-edit" : "DSA") << ": setup "
+				<< resources.calls.setup << " calls " << std::chrono::duration<double, std::micro>(setupEnd - start).count()
+				<< " us, per frame " << (double)resources.calls.frame / frames << " calls "
+				<< std::chrono::duration<double, std::micro>(end - setupEnd).count() / frames << " us" << std::endl;
+			resources.deleteVertexArray(vao);
+			resources.deleteBuffer(buffer);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include "Shader.h"
+#include "Framebuffer.h"
+#include "Depth.h"
+#include "VertexPulling.h"
+#include "Png.h"
+
+
+//golden image regression: every scene of the catalogue renders one frame offscreen, is read
+//back and compared with Golden/<scene>.png. the suite runs each scene in its own process so
+//scenes cannot leak GL state into each other and run in parallel; a child exits non zero on
+//failure and leaves <scene>_actual.png and <scene>_diff.png in Golden/failures. the references
+//are checked in, made with --golden-update on llvmpipe; a missing one fails the scene unless
+//--golden-allow-missing is given, which is for adding a scene before its reference exists
+namespace Golden {
+	const int WIDTH = 256;
+	const int HEIGHT = 256;
+	const char* const DIRECTORY = "Golden";
+	//a pixel differs when its perceptual distance (0 to 255) is above this
+	const double PIXEL_TOLERANCE = 6.0;
+	//a scene fails when more than this fraction of its pixels differ
+	const double FAILING_FRACTION = 0.001;
+
+	struct Scene {
+		const char* name;
+		//renders into the bound target; false when the context cannot run the scene
+		bool (*render)(Framebuffer& target);
+	};
+
+	//six floats per vertex, two triangles
+	inline unsigned int makeQuadVAO(unsigned int& VBO) {
+		float quad[] = {
+			-1.0f, -1.0f, 0.0f,  1.0f, 0.5f, 0.2f,
+			 1.0f, -1.0f, 0.0f,  0.2f, 1.0f, 0.5f,
+			 1.0f,  1.0f, 0.0f,  0.5f, 0.2f, 1.0f,
+			-1.0f, -1.0f, 0.0f,  1.0f, 0.5f, 0.2f,
+			 1.0f,  1.0f, 0.0f,  0.5f, 0.2f, 1.0f,
+			-1.0f,  1.0f, 0.0f,  0.2f, 0.5f, 1.0f
+		};
+		unsigned int VAO;
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &VBO);
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+		glBindVertexArray(0);
+		return VAO;
+	}
+
+	//the same 40 overlapping quads for every depth scene, back to front as added
+	inline void fillQuads(OpaqueQueue& queue, unsigned int VAO) {
+		srand(21);
+		for (int i = 0; i < 40; i++) {
+			Vec3 position((rand() % 1200) / 100.0f - 6.0f, (rand() % 1200) / 100.0f - 6.0f, -30.0f + 25.0f * i / 40);
+			float size = 1.0f + (rand() % 300) / 100.0f;
+			queue.add(VAO, 0, 6, Mat4::translation(position) * Mat4::scale(Vec3(size, size, 1.0f)));
+		}
+	}
+
+	inline bool renderQuads(Framebuffer& target, const DepthSettings& settings, bool overdraw) {
+		if (settings.reversedZ && !DepthSettings::reversedZAvailable()) return false;
+		Shader shader("Shaders/vertexShader.vs", overdraw ? "Shaders/overdraw.fs" : "Shaders/fragmentShader.fs");
+		unsigned int VBO;
+		unsigned int VAO = makeQuadVAO(VBO);
+		OpaqueQueue queue;
+		fillQuads(queue, VAO);
+		Mat4 view = Mat4::lookAt(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0));
+		Mat4 projection = settings.projection(1.047f, (float)WIDTH / HEIGHT, 0.1f, 100.0f);
+		if (overdraw) {
+			captureOverdraw(target, queue, shader, view, projection, settings);
+			target.bind();
+		}
+		else {
+			glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+			renderOpaque(queue, shader, view, projection, settings);
+		}
+		DepthSettings().apply();
+		glDeleteVertexArrays(1, &VAO);
+		glDeleteBuffers(1, &VBO);
+		return true;
+	}
+
+	inline bool renderTriangle(Framebuffer&) {
+		Shader shader("Shaders/vertexShader.vs", "Shaders/fragmentShader.fs");
+		float vertices[] = {
+			 -0.4f,  0.2f, 0.0f,  1.0f, 0.0f, 0.0f,
+			 -0.6f, -0.2f, 0.0f,  0.0f, 1.0f, 0.0f,
+			 -0.2f, -0.2f, 0.0f,  0.0f, 0.0f, 1.0f
+		};
+		unsigned int VAO, VBO;
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &VBO);
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+		glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		shader.use();
+		shader.setMat4("transform", Mat4::identity());
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glDeleteVertexArrays(1, &VAO);
+		glDeleteBuffers(1, &VBO);
+		return true;
+	}
+
+	inline bool renderVertexPulling(Framebuffer&) {
+		if (!VertexPullingBatch::available()) return false;
+		Shader shader("Shaders/vertexPulling.vs", "Shaders/fragmentShader.fs");
+		VertexPullingBatch batch;
+		srand(4);
+		for (int i = 0; i < 200; i++) {
+			std::vector<float> mesh = makeRandomMesh();
+			uint32_t id = batch.addMesh(mesh.data(), (uint32_t)mesh.size() / 6);
+			batch.addObject(id, (rand() % 100) / 50.0f - 1.0f, (rand() % 100) / 50.0f - 1.0f, 0.0f);
+		}
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		batch.draw(shader);
+		return true;
+	}
+
+	inline bool renderDepthSorted(Framebuffer& target) {
+		return renderQuads(target, DepthSettings(), false);
+	}
+	inline bool renderDepthPrePass(Framebuffer& target) {
+		DepthSettings settings;
+		settings.prePass = true;
+		return renderQuads(target, settings, false);
+	}
+	inline bool renderReversedZ(Framebuffer& target) {
+		DepthSettings settings;
+		settings.reversedZ = true;
+		return renderQuads(target, settings, false);
+	}
+	inline bool renderOverdraw(Framebuffer& target) {
+		DepthSettings settings;
+		settings.sortFrontToBack = false;
+		return renderQuads(target, settings, true);
+	}
+
+	inline const std::vector<Scene>& catalogue() {
+		static const std::vector<Scene> scenes = {
+			{ "triangle", renderTriangle },
+			{ "vertex-pulling", renderVertexPulling },
+			{ "depth-sorted", renderDepthSorted },
+			{ "depth-prepass", renderDepthPrePass },
+			{ "reversed-z", renderReversedZ },
+			{ "overdraw", renderOverdraw },
+		};
+		return scenes;
+	}
+
+	inline bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+		FILE* file = fopen(path.c_str(), "rb");
+		if (file == NULL) return false;
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		data.resize(size > 0 ? size : 0);
+		size_t read = fread(data.data(), 1, data.size(), file);
+		fclose(file);
+		return read == data.size();
+	}
+	inline bool writePng(const std::string& path, const std::vector<uint8_t>& rgba) {
+		std::vector<uint8_t> encoded;
+		Png::encode(rgba.data(), WIDTH, HEIGHT, encoded);
+		FILE* file = fopen(path.c_str(), "wb");
+		if (file == NULL) {
+			std::cout << "ERROR::GOLDEN::FILE_NOT_WRITTEN " << path << std::endl;
+			return false;
+		}
+		fwrite(encoded.data(), 1, encoded.size(), file);
+		fclose(file);
+		return true;
+	}
+
+	//difference of two pixels in YCbCr with chroma at half weight, since the eye is less
+	//sensitive to it, scaled so pure black against pure white is 255
+	inline double perceptualDistance(const uint8_t* a, const uint8_t* b) {
+		double dr = (double)a[0] - b[0], dg = (double)a[1] - b[1], db = (double)a[2] - b[2];
+		double dy = 0.299 * dr + 0.587 * dg + 0.114 * db;
+		double dcb = -0.1687 * dr - 0.3313 * dg + 0.5 * db;
+		double dcr = 0.5 * dr - 0.4187 * dg - 0.0813 * db;
+		return std::sqrt(dy * dy + 0.5 * (dcb * dcb + dcr * dcr));
+	}
+
+	//compares and fills diff: the actual image darkened, with differing pixels in red
+	//scaled by how far off they are
+	inline size_t compare(const std::vector<uint8_t>& actual, const std::vector<uint8_t>& reference,
+		std::vector<uint8_t>& diff, double& worst) {
+		size_t differing = 0;
+		worst = 0.0;
+		diff.resize(actual.size());
+		for (size_t i = 0; i < actual.size(); i += 4) {
+			double d = perceptualDistance(&actual[i], &reference[i]);
+			worst = std::max(worst, d);
+			uint8_t gray = (uint8_t)((actual[i] * 77 + actual[i + 1] * 150 + actual[i + 2] * 29) >> 10);
+			diff[i] = diff[i + 1] = diff[i + 2] = gray;
+			diff[i + 3] = 255;
+			if (d > PIXEL_TOLERANCE) {
+				differing++;
+				diff[i] = (uint8_t)std::min(255.0, 128.0 + d * 4.0);
+				diff[i + 1] = diff[i + 2] = 0;
+			}
+		}
+		return differing;
+	}
+
+	//renders one scene and checks it against its reference, or writes the reference on update
+	inline bool runScene(const std::string& name, bool update, bool allowMissing = false) {
+		const Scene* scene = NULL;
+		for (const Scene& s : catalogue()) {
+			if (name == s.name) scene = &s;
+		}
+		if (scene == NULL) {
+			std::cout << "GOLDEN " << name << ": unknown scene" << std::endl;
+			return false;
+		}
+		Framebuffer target(WIDTH, HEIGHT);
+		target.bind();
+		DepthSettings().apply();
+		if (!scene->render(target)) {
+			std::cout << "GOLDEN " << name << ": SKIPPED, needs a newer context" << std::endl;
+			Framebuffer::unbind();
+			return true;
+		}
+		std::vector<uint8_t> actual((size_t)WIDTH * HEIGHT * 4);
+		target.bind();
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, actual.data());
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		Framebuffer::unbind();
+
+		std::string referencePath = std::string(DIRECTORY) + "/" + name + ".png";
+		if (update) {
+			std::filesystem::create_directories(DIRECTORY);
+			bool written = writePng(referencePath, actual);
+			std::cout << "GOLDEN " << name << ": reference " << (written ? "written" : "NOT written") << std::endl;
+			return written;
+		}
+
+		if (allowMissing && !std::filesystem::exists(referencePath)) {
+			std::cout << "GOLDEN " << name << ": SKIPPED, no reference at " << referencePath << std::endl;
+			return true;
+		}
+		std::vector<uint8_t> file, reference;
+		int width = 0, height = 0;
+		bool loaded = readFile(referencePath, file) && Png::decode(file, width, height, reference);
+		size_t differing = actual.size() / 4;
+		double worst = 255.0;
+		std::vector<uint8_t> diff;
+		if (loaded && width == WIDTH && height == HEIGHT) {
+			differing = compare(actual, reference, diff, worst);
+		}
+		size_t allowed = (size_t)(FAILING_FRACTION * WIDTH * HEIGHT);
+		bool passed = loaded && width == WIDTH && height == HEIGHT && differing <= allowed;
+		if (!passed) {
+			std::string failures = std::string(DIRECTORY) + "/failures";
+			std::filesystem::create_directories(failures);
+			writePng(failures + "/" + name + "_actual.png", actual);
+			if (!diff.empty()) writePng(failures + "/" + name + "_diff.png", diff);
+		}
+		if (!loaded) {
+			std::cout << "GOLDEN " << name << ": FAILED, no readable reference at " << referencePath
+				<< " (run with --golden-update to create it)" << std::endl;
+		}
+		else {
+			std::cout << "GOLDEN " << name << ": " << (passed ? "passed" : "FAILED") << ", " << differing
+				<< " pixels differ (" << allowed << " allowed), worst distance " << worst << std::endl;
+		}
+		return passed;
+	}
+
+	//launches one child process per matching scene, all at once, and waits for them. children
+	//use Mesa's llvmpipe unless the environment already picked a driver, so results do not
+	//depend on the machine's GPU
+	inline bool runSuite(const char* executable, const std::string& filter, bool update, bool allowMissing = false) {
+#ifdef _WIN32
+		if (getenv("LIBGL_ALWAYS_SOFTWARE") == NULL) _putenv_s("LIBGL_ALWAYS_SOFTWARE", "1");
+		if (getenv("GALLIUM_DRIVER") == NULL) _putenv_s("GALLIUM_DRIVER", "llvmpipe");
+#else
+		setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+		setenv("GALLIUM_DRIVER", "llvmpipe", 0);
+#endif
+		auto start = std::chrono::high_resolution_clock::now();
+		std::vector<std::string> names;
+		for (const Scene& scene : catalogue()) {
+			if (filter == "all" || filter == scene.name) names.push_back(scene.name);
+		}
+		if (names.empty()) {
+			std::cout << "GOLDEN no scene matches " << filter << std::endl;
+			return false;
+		}
+
+		std::vector<int> results(names.size(), 0);
+		std::vector<std::thread> children;
+		for (size_t i = 0; i < names.size(); i++) {
+			std::string command = std::string("\"") + executable + "\" --golden-scene " + names[i]
+				+ (update ? " --golden-update" : "") + (allowMissing ? " --golden-allow-missing" : "");
+#ifdef _WIN32
+			//cmd strips one pair of quotes around the whole line
+			command = "\"" + command + "\"";
+#endif
+			children.emplace_back([&results, i, command]() {
+				results[i] = system(command.c_str());
+			});
+		}
+		for (std::thread& child : children) child.join();
+
+		int failed = 0;
+		int skipped = 0;
+		for (size_t i = 0; i < names.size(); i++) {
+			if (results[i] != 0) {
+				failed++;
+				std::cout << "GOLDEN " << names[i] << ": process failed with status " << results[i] << std::endl;
+			}
+			else if (allowMissing && !update && !std::filesystem::exists(std::string(DIRECTORY) + "/" + names[i] + ".png")) {
+				skipped++;
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		std::cout << "GOLDEN " << names.size() - failed - skipped << " of " << names.size() << " scenes passed";
+		if (skipped > 0) std::cout << ", " << skipped << " skipped without a reference";
+		std::cout << " in " << seconds << " s" << std::endl;
+		return failed == 0;
+	}
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef GPU_CULLING_H
+#define GPU_CULLING_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <iostream>
+#include "Shader.h"
+#include "VertexFormat.h"
+#include "Culling.h"
+
+
+//layout the GL reads for glMultiDrawArraysIndirect
+struct DrawArraysIndirectCommand {
+	uint32_t count;
+	uint32_t instanceCount;
+	uint32_t first;
+	uint32_t baseInstance;
+};
+
+//frustum culls instance bounding spheres in Shaders/cullInstances.cs and writes one indirect
+//draw per survivor, so visibility never round trips through the CPU. with 4.6 the draw count
+//comes straight from the atomic counter via glMultiDrawArraysIndirectCount, otherwise every
+//slot is drawn and the slots past the count are zeroed commands that draw nothing
+class GpuCuller {
+public:
+	uint32_t maxInstances;
+	uint32_t instanceCount = 0;
+
+	static bool available() {
+		return GLAD_GL_VERSION_4_3 != 0;
+	}
+
+	//vertexBuffer holds every mesh the instances refer to, laid out as format
+	GpuCuller(uint32_t maxInstances, const VertexFormat& format, unsigned int vertexBuffer)
+		: maxInstances(maxInstances), cullShader("Shaders/cullInstances.cs")
+	{
+		glGenBuffers(BUFFER_COUNT, buffers);
+		allocate(BOUNDS, maxInstances * 4 * sizeof(float), GL_SHADER_STORAGE_BUFFER);
+		allocate(INSTANCE_MESHES, maxInstances * 2 * sizeof(uint32_t), GL_SHADER_STORAGE_BUFFER);
+		allocate(COMMANDS, maxInstances * sizeof(DrawArraysIndirectCommand), GL_DRAW_INDIRECT_BUFFER);
+		allocate(VISIBLE, maxInstances * sizeof(uint32_t), GL_SHADER_STORAGE_BUFFER);
+		allocate(COUNTER, sizeof(uint32_t), GL_ATOMIC_COUNTER_BUFFER);
+
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+		for (const VertexFormat::Attribute& a : format.attributes) {
+			glVertexAttribPointer(a.index, a.size, a.type, a.normalized, format.stride, (void*)(size_t)a.offset);
+			glEnableVertexAttribArray(a.index);
+		}
+		//one value per instance, indirect draws start reading at their baseInstance
+		glBindBuffer(GL_ARRAY_BUFFER, buffers[VISIBLE]);
+		glVertexAttribIPointer(INSTANCE_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+		glVertexAttribDivisor(INSTANCE_ATTRIBUTE, 1);
+		glEnableVertexAttribArray(INSTANCE_ATTRIBUTE);
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+	~GpuCuller() {
+		glDeleteBuffers(BUFFER_COUNT, buffers);
+		glDeleteVertexArrays(1, &VAO);
+	}
+	GpuCuller(const GpuCuller&) = delete;
+	GpuCuller& operator=(const GpuCuller&) = delete;
+
+	//spheres packed as x, y, z, radius; meshes as first vertex, vertex count per instance
+	void setInstances(const float* spheres, const uint32_t* meshRanges, uint32_t count) {
+		instanceCount = std::min(count, maxInstances);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[BOUNDS]);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, instanceCount * 4 * sizeof(float), spheres);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[INSTANCE_MESHES]);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, instanceCount * 2 * sizeof(uint32_t), meshRanges);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	//resets the counter, runs the cull dispatch and fences the results for the indirect draw
+	void cull(const Frustum& frustum) {
+		uint32_t zero = 0;
+		glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, buffers[COUNTER]);
+		glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(uint32_t), &zero);
+		if (!hasDrawCount()) {
+			//without a GPU side draw count the unused tail must hold empty draws
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffers[COMMANDS]);
+			glClearBufferData(GL_DRAW_INDIRECT_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		}
+
+		cullShader.use();
+		glUniform4fv(glGetUniformLocation(cullShader.ID, "planes"), 6, &frustum.planes[0].x);
+		glUniform1ui(glGetUniformLocation(cullShader.ID, "instanceCount"), instanceCount);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffers[BOUNDS]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, buffers[INSTANCE_MESHES]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, buffers[COMMANDS]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, buffers[VISIBLE]);
+		glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 0, buffers[COUNTER]);
+		glDispatchCompute((instanceCount + 63) / 64, 1, 1);
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT
+			| GL_ATOMIC_COUNTER_BARRIER_BIT);
+	}
+
+	//draws the survivors of the last cull, shader must read instance bounds from SSBO binding 0
+	void draw(Shader& shader) {
+		shader.use();
+		glBindVertexArray(VAO);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffers[BOUNDS]);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffers[COMMANDS]);
+		if (hasDrawCount()) {
+			glBindBuffer(GL_PARAMETER_BUFFER, buffers[COUNTER]);
+			glMultiDrawArraysIndirectCount(GL_TRIANGLES, (void*)0, 0, instanceCount, 0);
+			glBindBuffer(GL_PARAMETER_BUFFER, 0);
+		}
+		else {
+			glMultiDrawArraysIndirect(GL_TRIANGLES, (void*)0, instanceCount, 0);
+		}
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	//reads back the visible list, for tests and debugging only since it stalls the pipeline
+	std::vector<uint32_t> readVisible() {
+		//glGetBufferSubData is a buffer update read, which the barrier in cull() does not cover
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		uint32_t count = 0;
+		glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, buffers[COUNTER]);
+		glGetBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(uint32_t), &count);
+		std::vector<uint32_t> visible(std::min(count, instanceCount));
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[VISIBLE]);
+		glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, visible.size() * sizeof(uint32_t), visible.data());
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		return visible;
+	}
+
+	unsigned int boundsBuffer() const { return buffers[BOUNDS]; }
+
+private:
+	enum { BOUNDS, INSTANCE_MESHES, COMMANDS, VISIBLE, COUNTER, BUFFER_COUNT };
+	static const unsigned int INSTANCE_ATTRIBUTE = 2;
+	unsigned int buffers[BUFFER_COUNT];
+	unsigned int VAO;
+	Shader cullShader;
+
+	static bool hasDrawCount() {
+		return glMultiDrawArraysIndirectCount != NULL;
+	}
+	void allocate(int buffer, size_t size, GLenum target) {
+		glBindBuffer(target, buffers[buffer]);
+		glBufferData(target, size, NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(target, 0);
+	}
+};
+
+
+//compares the GPU visible set with cullSpheresScalar on random spheres. instances that
+//differ are accepted only when they sit on a plane within float rounding of the boundary
+inline bool selfTestGpuCulling(uint32_t count = 100000) {
+	if (!GpuCuller::available()) {
+		std::cout << "SELFTEST gpu-culling needs GL 4.3" << std::endl;
+		return false;
+	}
+	std::vector<float> spheres(count * 4), xs(count), ys(count), zs(count), radii(count);
+	std::vector<uint32_t> meshRanges(count * 2);
+	srand(11);
+	for (uint32_t i = 0; i < count; i++) {
+		xs[i] = spheres[i * 4] = (rand() % 20000) / 100.0f - 100.0f;
+		ys[i] = spheres[i * 4 + 1] = (rand() % 20000) / 100.0f - 100.0f;
+		zs[i] = spheres[i * 4 + 2] = (rand() % 20000) / 100.0f - 100.0f;
+		radii[i] = spheres[i * 4 + 3] = 0.5f + (rand() % 100) / 100.0f;
+		meshRanges[i * 2] = 0;
+		meshRanges[i * 2 + 1] = 3;
+	}
+	Frustum frustum = Frustum::fromMatrix(Mat4::perspective(1.047f, 16.0f / 9.0f, 0.1f, 150.0f)
+		* Mat4::lookAt(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0)));
+
+	std::vector<uint32_t> expected;
+	cullSpheresScalar(frustum, xs.data(), ys.data(), zs.data(), radii.data(), 0, count, expected);
+
+	float triangle[] = { 0.0f, 0.0f, 0.0f, 1, 0, 0,  1.0f, 0.0f, 0.0f, 0, 1, 0,  0.0f, 1.0f, 0.0f, 0, 0, 1 };
+	unsigned int vertexBuffer;
+	glGenBuffers(1, &vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(triangle), triangle, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	VertexFormat format(6 * sizeof(float));
+	format.add(0, 3, GL_FLOAT, 0).add(1, 3, GL_FLOAT, 3 * sizeof(float));
+
+	std::vector<uint32_t> actual;
+	{
+		GpuCuller culler(count, format, vertexBuffer);
+		culler.setInstances(spheres.data(), meshRanges.data(), count);
+		culler.cull(frustum);
+		//exercise the indirect draw path too, its output is not inspected
+		Shader drawShader("Shaders/gpuCulled.vs", "Shaders/fragmentShader.fs");
+		drawShader.use();
+		drawShader.setMat4("viewProjection", Mat4::identity());
+		culler.draw(drawShader);
+		actual = culler.readVisible();
+	}
+	glDeleteBuffers(1, &vertexBuffer);
+	std::sort(actual.begin(), actual.end());
+
+	std::vector<uint32_t> difference;
+	std::set_symmetric_difference(expected.begin(), expected.end(), actual.begin(), actual.end(),
+		std::back_inserter(difference));
+	int failures = 0;
+	for (uint32_t i : difference) {
+		float margin = 1e30f;
+		for (const Vec4& p : frustum.planes) {
+			margin = std::min(margin, std::fabs(p.x * xs[i] + p.y * ys[i] + p.z * zs[i] + p.w + radii[i]));
+		}
+		if (margin > 1e-3f) failures++;
+	}
+	bool duplicates = std::adjacent_find(actual.begin(), actual.end()) != actual.end();
+	std::cout << "SELFTEST gpu-culling: " << expected.size() << " expected, " << actual.size() << " from GPU, "
+		<< difference.size() << " differ, " << failures << " outside tolerance"
+		<< (duplicates ? ", duplicate instances" : "") << std::endl;
+	return failures == 0 && !duplicates;
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef GPU_MEMORY_H
+#define GPU_MEMORY_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <iostream>
+
+
+//registry of the GL objects the app owns and the bytes each was allocated with, totalled per
+//type and per tag. drivers do not report per object sizes, so the bytes are what was asked for.
+//streamable resources are ones their owner can stream in again: they are kept in least
+//recently used order and deleted from the front while the total is over budgetBytes, skipping
+//anything used this frame. checkLeaks() at shutdown lists whatever is still registered
+namespace GpuMemory {
+
+	enum Type { BUFFER, TEXTURE, VERTEX_ARRAY, PROGRAM, TYPE_COUNT };
+
+	inline const char* typeName(Type type) {
+		switch (type) {
+		case BUFFER: return "buffer";
+		case TEXTURE: return "texture";
+		case VERTEX_ARRAY: return "vertex array";
+		case PROGRAM: return "program";
+		default: return "unknown";
+		}
+	}
+
+	struct Resource {
+		Type type;
+		unsigned int name;
+		size_t bytes;
+		std::string tag;
+		//set for streamable resources, called after eviction deleted the object
+		std::function<void()> onEvict;
+		uint64_t lastUsedFrame;
+		std::list<uint64_t>::iterator lruPosition;
+	};
+
+	struct Totals {
+		size_t bytes = 0;
+		size_t peakBytes = 0;
+		int count = 0;
+	};
+
+	inline std::unordered_map<uint64_t, Resource> resources;
+	//streamable resources only, least recently used first
+	inline std::list<uint64_t> lru;
+	inline Totals types[TYPE_COUNT];
+	inline std::map<std::string, Totals> tags;
+	inline Totals total;
+	//0 is no budget
+	inline size_t budgetBytes = 0;
+	inline uint64_t frame = 0;
+	inline uint64_t evictions = 0;
+	inline uint64_t evictedBytes = 0;
+	inline bool overBudget = false;
+
+	inline uint64_t key(Type type, unsigned int name) {
+		return ((uint64_t)type << 32) | name;
+	}
+
+	inline void add(Totals& totals, size_t bytes) {
+		totals.bytes += bytes;
+		totals.peakBytes = std::max(totals.peakBytes, totals.bytes);
+		totals.count++;
+	}
+	inline void remove(Totals& totals, size_t bytes) {
+		totals.bytes -= bytes;
+		totals.count--;
+	}
+
+	inline void untrack(Type type, unsigned int name) {
+		auto it = resources.find(key(type, name));
+		if (it == resources.end()) return;
+		Resource& r = it->second;
+		remove(types[type], r.bytes);
+		remove(tags[r.tag], r.bytes);
+		remove(total, r.bytes);
+		if (r.onEvict) lru.erase(r.lruPosition);
+		resources.erase(it);
+	}
+
+	//deletes the GL object and forgets it
+	inline void destroy(Type type, unsigned int name) {
+		if (name == 0) return;
+		untrack(type, name);
+		switch (type) {
+		case BUFFER: glDeleteBuffers(1, &name); break;
+		case TEXTURE: glDeleteTextures(1, &name); break;
+		case VERTEX_ARRAY: glDeleteVertexArrays(1, &name); break;
+		case PROGRAM: glDeleteProgram(name); break;
+		default: break;
+		}
+	}
+
+	//deletes streamable resources not used this frame, oldest first, until the total fits
+	inline void enforceBudget() {
+		if (budgetBytes == 0) return;
+		while (total.bytes > budgetBytes && !lru.empty()) {
+			Resource& r = resources[lru.front()];
+			//the list is in use order, so everything behind this one was used this frame too
+			if (r.lastUsedFrame >= frame) break;
+			std::function<void()> onEvict = r.onEvict;
+			Type type = r.type;
+			unsigned int name = r.name;
+			evictions++;
+			evictedBytes += r.bytes;
+			destroy(type, name);
+			onEvict();
+		}
+		bool over = total.bytes > budgetBytes;
+		if (over && !overBudget) {
+			std::cout << "ERROR::GPU_MEMORY::OVER_BUDGET " << total.bytes / 1024 << " KiB of " << budgetBytes / 1024
+				<< " KiB and nothing left to evict" << std::endl;
+		}
+		overBudget = over;
+	}
+
+	//registers a freshly allocated object, tracking it again replaces the old size
+	inline void track(Type type, unsigned int name, size_t bytes, const std::string& tag) {
+		if (name == 0) return;
+		untrack(type, name);
+		Resource& r = resources[key(type, name)];
+		r.type = type;
+		r.name = name;
+		r.bytes = bytes;
+		r.tag = tag;
+		r.lastUsedFrame = frame;
+		add(types[type], bytes);
+		add(tags[tag], bytes);
+		add(total, bytes);
+		enforceBudget();
+	}
+
+	//lets the budget evict the object. onEvict runs after it was deleted, the owner drops its
+	//name there and streams the data in again when it next needs it
+	inline void makeStreamable(Type type, unsigned int name, std::function<void()> onEvict) {
+		auto it = resources.find(key(type, name));
+		if (it == resources.end() || !onEvict) return;
+		Resource& r = it->second;
+		if (r.onEvict) lru.erase(r.lruPosition);
+		r.onEvict = std::move(onEvict);
+		r.lastUsedFrame = frame;
+		r.lruPosition = lru.insert(lru.end(), it->first);
+	}
+
+	//marks the object as used this frame, streamable ones move to the back of the eviction order
+	inline void touch(Type type, unsigned int name) {
+		auto it = resources.find(key(type, name));
+		if (it == resources.end()) return;
+		Resource& r = it->second;
+		r.lastUsedFrame = frame;
+		if (r.onEvict) lru.splice(lru.end(), lru, r.lruPosition);
+	}
+
+	//call once per frame after the swap, what was used in the frame that ended may now be evicted
+	inline void endFrame() {
+		frame++;
+		enforceBudget();
+	}
+
+	inline void report() {
+		std::cout << "GPU_MEMORY " << total.count << " objects, " << total.bytes / 1024 << " KiB live, "
+			<< total.peakBytes / 1024 << " KiB peak";
+		if (budgetBytes != 0) {
+			std::cout << ", budget " << budgetBytes / 1024 << " KiB, " << evictions << " evictions of "
+				<< evictedBytes / 1024 << " KiB, " << lru.size() << " streamable";
+		}
+		std::cout << std::endl;
+		for (int t = 0; t < TYPE_COUNT; t++) {
+			if (types[t].count == 0 && types[t].peakBytes == 0) continue;
+			std::cout << "  " << typeName((Type)t) << ": " << types[t].count << " live, " << types[t].bytes / 1024
+				<< " KiB, " << types[t].peakBytes / 1024 << " KiB peak" << std::endl;
+		}
+		for (auto& tag : tags) {
+			if (tag.second.count == 0) continue;
+			std::cout << "  [" << tag.first << "] " << tag.second.count << " live, " << tag.second.bytes / 1024
+				<< " KiB" << std::endl;
+		}
+	}
+
+	//call after the owners are gone and before the context is, returns the number of leaks
+	inline size_t checkLeaks() {
+		if (resources.empty()) {
+			std::cout << "GPU_MEMORY no leaks, peak " << total.peakBytes / 1024 << " KiB" << std::endl;
+			return 0;
+		}
+		std::map<uint64_t, const Resource*> sorted;
+		for (auto& entry : resources) sorted[entry.first] = &entry.second;
+		for (auto& entry : sorted) {
+			const Resource& r = *entry.second;
+			std::cout << "ERROR::GPU_MEMORY::LEAK " << typeName(r.type) << " " << r.name << " [" << r.tag << "] "
+				<< r.bytes << " bytes" << std::endl;
+		}
+		return resources.size();
+	}
+}
+
+
+//owns one GL object of a tracked type, deleting it and its registry entry on destruction
+template<GpuMemory::Type T>
+class GpuObject {
+public:
+	unsigned int ID = 0;
+
+	GpuObject() = default;
+	explicit GpuObject(unsigned int ID) : ID(ID) {}
+	~GpuObject() {
+		reset();
+	}
+	GpuObject(const GpuObject&) = delete;
+	GpuObject& operator=(const GpuObject&) = delete;
+	GpuObject(GpuObject&& other) noexcept : ID(other.ID) {
+		other.ID = 0;
+	}
+	GpuObject& operator=(GpuObject&& other) noexcept {
+		if (this != &other) {
+			reset(other.ID);
+			other.ID = 0;
+		}
+		return *this;
+	}
+
+	void reset(unsigned int newID = 0) {
+		GpuMemory::destroy(T, ID);
+		ID = newID;
+	}
+	operator unsigned int() const {
+		return ID;
+	}
+};
+
+typedef GpuObject<GpuMemory::BUFFER> GpuBuffer;
+typedef GpuObject<GpuMemory::TEXTURE> GpuTexture;
+typedef GpuObject<GpuMemory::VERTEX_ARRAY> GpuVertexArray;
+
+
+//streamable buffers under a budget of half their total: each frame uses a sliding window of
+//them, what falls out of the window must be evicted oldest first and streamed back on reuse
+inline bool selfTestGpuMemory() {
+	const int count = 8;
+	const size_t bytes = 256 << 10;
+	std::vector<char> data(bytes, 1);
+	size_t savedBudget = GpuMemory::budgetBytes;
+	uint64_t savedEvictions = GpuMemory::evictions;
+	GpuMemory::budgetBytes = bytes * count / 2;
+
+	std::vector<GpuBuffer> buffers(count);
+	int streamedIn = 0;
+	auto streamIn = [&](int i) {
+		unsigned int buffer;
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		glBufferData(GL_ARRAY_BUFFER, bytes, data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GpuMemory::track(GpuMemory::BUFFER, buffer, bytes, "selftest stream");
+		//the registry already deleted the object, only the name is dropped here
+		GpuMemory::makeStreamable(GpuMemory::BUFFER, buffer, [&buffers, i]() { buffers[i].ID = 0; });
+		buffers[i].reset(buffer);
+		streamedIn++;
+	};
+
+	bool passed = true;
+	for (int f = 0; f < count * 2; f++) {
+		for (int i = f % count, n = 0; n < 3; i = (i + 1) % count, n++) {
+			if (buffers[i].ID == 0) streamIn(i);
+			GpuMemory::touch(GpuMemory::BUFFER, buffers[i]);
+		}
+		GpuMemory::endFrame();
+		if (GpuMemory::total.bytes > GpuMemory::budgetBytes) passed = false;
+	}
+	uint64_t evicted = GpuMemory::evictions - savedEvictions;
+	buffers.clear();
+	GpuMemory::budgetBytes = savedBudget;
+	if (GpuMemory::tags["selftest stream"].count != 0) passed = false;
+	//each frame brings in one buffer after the first, so the budget has to push one out
+	if (evicted < (uint64_t)count) passed = false;
+
+	std::cout << "SELFTEST gpu-memory: " << streamedIn << " stream ins, " << evicted << " evictions, "
+		<< (passed ? "passed" : "FAILED") << std::endl;
+	return passed;
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef HI_Z_H
+#define HI_Z_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include "Shader.h"
+#include "Framebuffer.h"
+#include "Culling.h"
+#include "GpuMemory.h"
+
+
+//farthest depth mip chain of a depth texture, max normally and min with reversed-Z. level 0
+//is the largest power of two that fits in the depth buffer so every later level is an exact
+//2x2 reduction; anything nearer than a texel's value may still be visible under it
+class HiZPyramid {
+public:
+	unsigned int texture = 0;
+	int width = 0;
+	int height = 0;
+	int levels = 0;
+	//false until build has run once, nothing may be culled against an empty pyramid
+	bool valid = false;
+	//set when the depth buffer uses reversed-Z, the pyramid then keeps minimums
+	bool reversedZ = false;
+
+	static bool available() {
+		return GLAD_GL_VERSION_4_3 != 0;
+	}
+
+	HiZPyramid(int depthWidth, int depthHeight)
+		: downsampleShader("Shaders/hiZDownsample.cs")
+	{
+		resize(depthWidth, depthHeight);
+	}
+	~HiZPyramid() {
+		GpuMemory::destroy(GpuMemory::TEXTURE, texture);
+	}
+	HiZPyramid(const HiZPyramid&) = delete;
+	HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+	void resize(int newDepthWidth, int newDepthHeight) {
+		if (texture != 0 && newDepthWidth == depthWidth && newDepthHeight == depthHeight) return;
+		depthWidth = newDepthWidth;
+		depthHeight = newDepthHeight;
+		width = floorPowerOfTwo(depthWidth);
+		height = floorPowerOfTwo(depthHeight);
+		levels = 1;
+		while ((width >> levels) > 0 || (height >> levels) > 0) levels++;
+
+		GpuMemory::destroy(GpuMemory::TEXTURE, texture);
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexStorage2D(GL_TEXTURE_2D, levels, GL_R32F, width, height);
+		GpuMemory::track(GpuMemory::TEXTURE, texture, textureStorageBytes(width, height, 1, levels, GL_R32F), "hi-z pyramid");
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		valid = false;
+	}
+
+	//one dispatch per level, each waits on the image writes of the one before
+	void build(unsigned int depthTexture) {
+		downsampleShader.use();
+		downsampleShader.setInt("depth", 0);
+		downsampleShader.setBool("fromDepth", true);
+		downsampleShader.setBool("reversedZ", reversedZ);
+		glUniform2i(glGetUniformLocation(downsampleShader.ID, "depthSize"), depthWidth, depthHeight);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, depthTexture);
+		for (int level = 0; level < levels; level++) {
+			int w = std::max(1, width >> level), h = std::max(1, height >> level);
+			if (level == 1) downsampleShader.setBool("fromDepth", false);
+			if (level > 0) glBindImageTexture(0, texture, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			glBindImageTexture(1, texture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+			glUniform2i(glGetUniformLocation(downsampleShader.ID, "destinationSize"), w, h);
+			glDispatchCompute((w + 7) / 8, (h + 7) / 8, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		valid = true;
+	}
+
+private:
+	int depthWidth = 0;
+	int depthHeight = 0;
+	Shader downsampleShader;
+
+	static int floorPowerOfTwo(int value) {
+		int p = 1;
+		while (p * 2 <= value) p *= 2;
+		return p;
+	}
+};
+
+
+//tests bounding spheres against the pyramid of the previous frame's depth. results come back
+//through a ring of fenced readback buffers so the CPU never waits on the GPU: visible always
+//holds the newest finished test, and every object, hidden or not, is tested again each frame
+class OcclusionCuller {
+public:
+	//one flag per object, 1 = submit, 0 = hidden last time it was tested
+	std::vector<uint32_t> visible;
+	uint32_t maxObjects;
+	//objects tested and found hidden in the newest collected result
+	size_t lastOccluded = 0;
+
+	OcclusionCuller(uint32_t maxObjects)
+		: maxObjects(maxObjects), testShader("Shaders/occlusionTest.cs")
+	{
+		visible.assign(maxObjects, 1);
+		glGenBuffers(1, &visibilityBuffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibilityBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, maxObjects * sizeof(uint32_t), NULL, GL_DYNAMIC_COPY);
+		GpuMemory::track(GpuMemory::BUFFER, visibilityBuffer, maxObjects * sizeof(uint32_t), "occlusion visibility");
+		glGenBuffers(READBACK_SLOTS, readback);
+		for (int i = 0; i < READBACK_SLOTS; i++) {
+			glBindBuffer(GL_COPY_WRITE_BUFFER, readback[i]);
+			glBufferData(GL_COPY_WRITE_BUFFER, maxObjects * sizeof(uint32_t), NULL, GL_STREAM_READ);
+			GpuMemory::track(GpuMemory::BUFFER, readback[i], maxObjects * sizeof(uint32_t), "occlusion readback");
+			fences[i] = NULL;
+			counts[i] = 0;
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	~OcclusionCuller() {
+		for (int i = 0; i < READBACK_SLOTS; i++) {
+			if (fences[i] != NULL) glDeleteSync(fences[i]);
+		}
+		for (unsigned int buffer : readback) GpuMemory::destroy(GpuMemory::BUFFER, buffer);
+		GpuMemory::destroy(GpuMemory::BUFFER, visibilityBuffer);
+	}
+	OcclusionCuller(const OcclusionCuller&) = delete;
+	OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+	//boundsBuffer holds count vec4 spheres, e.g. GpuCuller::boundsBuffer(). an invalid pyramid
+	//marks everything visible, and with every readback slot still in flight the test is skipped
+	void test(const HiZPyramid& pyramid, const Mat4& viewProjection, unsigned int boundsBuffer, uint32_t count) {
+		count = std::min(count, maxObjects);
+		if (!pyramid.valid) {
+			std::fill(visible.begin(), visible.begin() + count, 1u);
+			return;
+		}
+		int slot = next % READBACK_SLOTS;
+		if (fences[slot] != NULL) return;
+
+		testShader.use();
+		testShader.setInt("hiZ", 0);
+		testShader.setMat4("viewProjection", viewProjection);
+		glUniform2i(glGetUniformLocation(testShader.ID, "hiZSize"), pyramid.width, pyramid.height);
+		testShader.setInt("hiZLevels", pyramid.levels);
+		testShader.setBool("reversedZ", pyramid.reversedZ);
+		glUniform1ui(glGetUniformLocation(testShader.ID, "objectCount"), count);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, pyramid.texture);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, boundsBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, visibilityBuffer);
+		glDispatchCompute((count + 63) / 64, 1, 1);
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glBindBuffer(GL_COPY_READ_BUFFER, visibilityBuffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, readback[slot]);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, count * sizeof(uint32_t));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		counts[slot] = count;
+		next++;
+	}
+
+	//copies every finished test into visible, oldest first. wait blocks on the newest, for tests
+	bool collect(bool wait = false) {
+		bool updated = false;
+		for (int i = 0; i < READBACK_SLOTS; i++) {
+			int slot = (next + i) % READBACK_SLOTS;
+			if (fences[slot] == NULL) continue;
+			GLbitfield flags = wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0;
+			GLuint64 timeout = wait ? 1000000000ull : 0;
+			GLenum state = glClientWaitSync(fences[slot], flags, timeout);
+			if (state != GL_ALREADY_SIGNALED && state != GL_CONDITION_SATISFIED) continue;
+			glDeleteSync(fences[slot]);
+			fences[slot] = NULL;
+			glBindBuffer(GL_COPY_READ_BUFFER, readback[slot]);
+			glGetBufferSubData(GL_COPY_READ_BUFFER, 0, counts[slot] * sizeof(uint32_t), visible.data());
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			lastOccluded = std::count(visible.begin(), visible.begin() + counts[slot], 0u);
+			updated = true;
+		}
+		return updated;
+	}
+
+	//GPU side flags for consumers that never come back to the CPU
+	unsigned int visibilityBufferID() const { return visibilityBuffer; }
+
+private:
+	static const int READBACK_SLOTS = 3;
+	unsigned int visibilityBuffer;
+	unsigned int readback[READBACK_SLOTS];
+	GLsync fences[READBACK_SLOTS];
+	uint32_t counts[READBACK_SLOTS];
+	unsigned int next = 0;
+	Shader testShader;
+};
+
+
+//clears the left half of an offscreen depth buffer to the depth of a wall 10 units away and
+//checks spheres behind it are reported hidden while spheres in front of it or beside it are not
+inline bool selfTestHiZ() {
+	if (!HiZPyramid::available()) {
+		std::cout << "SELFTEST hi-z needs GL 4.3" << std::endl;
+		return false;
+	}
+	//odd size so the power of two fit of level 0 is exercised
+	const int width = 301, height = 203;
+	Mat4 viewProjection = Mat4::perspective(1.047f, (float)width / height, 0.1f, 100.0f)
+		* Mat4::lookAt(Vec3(0, 0, 0), Vec3(0, 0, -1), Vec3(0, 1, 0));
+	Vec4 wall = viewProjection * Vec4(0.0f, 0.0f, -10.0f, 1.0f);
+	float wallDepth = wall.z / wall.w * 0.5f + 0.5f;
+
+	Framebuffer target(width, height);
+	target.bind();
+	glClearDepth(1.0);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(0, 0, width / 2, height);
+	glClearDepth(wallDepth);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glDisable(GL_SCISSOR_TEST);
+	glClearDepth(1.0);
+	Framebuffer::unbind();
+
+	struct Case { Vec4 sphere; uint32_t expected; const char* name; };
+	const Case cases[] = {
+		{ Vec4(-8.0f, 0.0f, -30.0f, 1.0f), 0, "behind the wall" },
+		{ Vec4(8.0f, 0.0f, -30.0f, 1.0f), 1, "beside the wall" },
+		{ Vec4(-2.0f, 0.0f, -5.0f, 0.5f), 1, "in front of the wall" },
+		{ Vec4(0.0f, 0.0f, -30.0f, 2.0f), 1, "across the wall's edge" },
+		{ Vec4(-1.0f, 0.0f, -0.05f, 0.5f), 1, "through the near plane" },
+	};
+	const uint32_t count = sizeof(cases) / sizeof(cases[0]);
+	std::vector<Vec4> spheres;
+	for (const Case& c : cases) spheres.push_back(c.sphere);
+	unsigned int boundsBuffer;
+	glGenBuffers(1, &boundsBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, boundsBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, count * sizeof(Vec4), spheres.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	int failures = 0;
+	{
+		HiZPyramid pyramid(width, height);
+		OcclusionCuller culler(count);
+		pyramid.build(target.depthTexture);
+		culler.test(pyramid, viewProjection, boundsBuffer, count);
+		culler.collect(true);
+		for (uint32_t i = 0; i < count; i++) {
+			if (culler.visible[i] != cases[i].expected) {
+				std::cout << "SELFTEST hi-z: sphere " << cases[i].name << " reported "
+					<< (culler.visible[i] ? "visible" : "hidden") << std::endl;
+				failures++;
+			}
+		}
+		std::cout << "SELFTEST hi-z: " << pyramid.width << "x" << pyramid.height << " pyramid, " << pyramid.levels
+			<< " levels, " << culler.lastOccluded << " of " << count << " hidden, " << failures << " wrong" << std::endl;
+	}
+	glDeleteBuffers(1, &boundsBuffer);
+	return failures == 0;
+}
+
+#endif
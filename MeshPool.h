@@ -0,0 +1,350 @@
+#ifndef MESH_POOL_H
+#define MESH_POOL_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include "OffsetAllocator.h"
+#include "VertexFormat.h"
+#include "GpuMemory.h"
+
+
+//a mesh placed inside one of the pool's pages
+struct MeshHandle {
+	uint32_t id = OffsetAllocator::INVALID;
+	bool valid() const { return id != OffsetAllocator::INVALID; }
+};
+
+//packs many meshes of one vertex format into a few large vertex/index buffers.
+//all pages share one VAO: on 4.3+ switching page only rebinds the vertex buffer with
+//glBindVertexBuffer, older contexts re-point the attributes with glVertexAttribPointer
+class MeshPool {
+public:
+	//bind and draw statistics, reset with resetStats each frame
+	int vaoBinds = 0;
+	int bufferBinds = 0;
+	int draws = 0;
+
+	MeshPool(const VertexFormat& format, uint32_t verticesPerPage = 1 << 20, uint32_t indicesPerPage = 3 << 20)
+		: format(format), verticesPerPage(verticesPerPage), indicesPerPage(indicesPerPage)
+	{
+		separateFormat = glBindVertexBuffer != NULL && glVertexAttribFormat != NULL;
+		glGenVertexArrays(1, &VAO);
+		GpuMemory::track(GpuMemory::VERTEX_ARRAY, VAO, 0, "mesh pool");
+		if (separateFormat) {
+			glBindVertexArray(VAO);
+			for (const VertexFormat::Attribute& a : format.attributes) {
+				glVertexAttribFormat(a.index, a.size, a.type, a.normalized, a.offset);
+				glVertexAttribBinding(a.index, 0);
+				glEnableVertexAttribArray(a.index);
+			}
+			glBindVertexArray(0);
+		}
+	}
+	~MeshPool() {
+		for (Page& page : pages) {
+			GpuMemory::destroy(GpuMemory::BUFFER, page.vertexBuffer);
+			GpuMemory::destroy(GpuMemory::BUFFER, page.indexBuffer);
+		}
+		GpuMemory::destroy(GpuMemory::VERTEX_ARRAY, VAO);
+	}
+	MeshPool(const MeshPool&) = delete;
+	MeshPool& operator=(const MeshPool&) = delete;
+
+	//copies a mesh into the first page with room, indices may be NULL for non indexed meshes
+	MeshHandle add(const void* vertices, uint32_t vertexCount, const uint32_t* indices = NULL, uint32_t indexCount = 0) {
+		MeshHandle handle;
+		//the allocators never hand out an empty block, so no page would ever take it
+		if (vertexCount == 0) {
+			std::cout << "ERROR::MESH_POOL::EMPTY_MESH" << std::endl;
+			return handle;
+		}
+		if (vertexCount > verticesPerPage || indexCount > indicesPerPage) {
+			std::cout << "ERROR::MESH_POOL::MESH_LARGER_THAN_PAGE" << std::endl;
+			return handle;
+		}
+		Mesh mesh;
+		for (size_t i = 0; i <= pages.size(); i++) {
+			if (i == pages.size()) createPage();
+			Page& page = pages[i];
+			mesh.vertices = page.vertexAllocator.allocate(vertexCount);
+			if (!mesh.vertices.valid()) continue;
+			if (indexCount > 0) {
+				mesh.indices = page.indexAllocator.allocate(indexCount);
+				if (!mesh.indices.valid()) {
+					page.vertexAllocator.free(mesh.vertices);
+					continue;
+				}
+			}
+			mesh.page = (uint32_t)i;
+			break;
+		}
+		mesh.vertexCount = vertexCount;
+		mesh.indexCount = indexCount;
+		mesh.live = true;
+
+		Page& page = pages[mesh.page];
+		glBindBuffer(GL_COPY_WRITE_BUFFER, page.vertexBuffer);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)mesh.vertices.offset * format.stride,
+			(GLsizeiptr)vertexCount * format.stride, vertices);
+		if (indexCount > 0) {
+			glBindBuffer(GL_COPY_WRITE_BUFFER, page.indexBuffer);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)mesh.indices.offset * sizeof(uint32_t),
+				(GLsizeiptr)indexCount * sizeof(uint32_t), indices);
+		}
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		if (!freeIds.empty()) {
+			handle.id = freeIds.back();
+			freeIds.pop_back();
+			meshes[handle.id] = mesh;
+		}
+		else {
+			handle.id = (uint32_t)meshes.size();
+			meshes.push_back(mesh);
+		}
+		return handle;
+	}
+
+	void remove(MeshHandle handle) {
+		if (!handle.valid() || !meshes[handle.id].live) return;
+		Mesh& mesh = meshes[handle.id];
+		pages[mesh.page].vertexAllocator.free(mesh.vertices);
+		pages[mesh.page].indexAllocator.free(mesh.indices);
+		mesh.live = false;
+		freeIds.push_back(handle.id);
+	}
+
+	//binds the shared VAO, call once before a run of draw calls
+	void bind() {
+		glBindVertexArray(VAO);
+		vaoBinds++;
+		currentPage = OffsetAllocator::INVALID;
+	}
+
+	//draws one mesh, only touches buffer bindings when the mesh lives in a different page
+	void draw(MeshHandle handle, GLenum mode = GL_TRIANGLES) {
+		const Mesh& mesh = meshes[handle.id];
+		if (mesh.page != currentPage) bindPage(mesh.page);
+		if (mesh.indexCount > 0) {
+			glDrawElementsBaseVertex(mode, mesh.indexCount, GL_UNSIGNED_INT,
+				(void*)((size_t)mesh.indices.offset * sizeof(uint32_t)), (GLint)mesh.vertices.offset);
+		}
+		else {
+			glDrawArrays(mode, (GLint)mesh.vertices.offset, mesh.vertexCount);
+		}
+		draws++;
+	}
+
+	//first vertex and count of a mesh inside its page, for building indirect draws
+	uint32_t firstVertex(MeshHandle handle) const { return meshes[handle.id].vertices.offset; }
+	uint32_t vertexCount(MeshHandle handle) const { return meshes[handle.id].vertexCount; }
+	uint32_t pageOf(MeshHandle handle) const { return meshes[handle.id].page; }
+	unsigned int vertexBufferOf(uint32_t page) const { return pages[page].vertexBuffer; }
+
+	//packs every page's live meshes to the front so freed holes merge into one block, pages
+	//that are already packed are left alone
+	void defragment() {
+		for (uint32_t p = 0; p < pages.size(); p++) {
+			Page& page = pages[p];
+			std::vector<uint32_t> live;
+			for (uint32_t i = 0; i < meshes.size(); i++) {
+				if (meshes[i].live && meshes[i].page == p) live.push_back(i);
+			}
+			std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b) {
+				return meshes[a].vertices.offset < meshes[b].vertices.offset;
+			});
+			if (isPacked(live)) continue;
+
+			unsigned int newVertices, newIndices;
+			glGenBuffers(1, &newVertices);
+			glGenBuffers(1, &newIndices);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, newVertices);
+			glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)verticesPerPage * format.stride, NULL, GL_STATIC_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, newIndices);
+			glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)indicesPerPage * sizeof(uint32_t), NULL, GL_STATIC_DRAW);
+			trackPage(newVertices, newIndices);
+
+			//a fresh allocator hands out blocks front to back so the copies end up contiguous
+			page.vertexAllocator.reset();
+			page.indexAllocator.reset();
+			for (uint32_t i : live) {
+				Mesh& mesh = meshes[i];
+				OffsetAllocator::Allocation vertices = page.vertexAllocator.allocate(mesh.vertexCount);
+				glBindBuffer(GL_COPY_READ_BUFFER, page.vertexBuffer);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, newVertices);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)mesh.vertices.offset * format.stride,
+					(GLintptr)vertices.offset * format.stride, (GLsizeiptr)mesh.vertexCount * format.stride);
+				mesh.vertices = vertices;
+				if (mesh.indexCount > 0) {
+					OffsetAllocator::Allocation indices = page.indexAllocator.allocate(mesh.indexCount);
+					glBindBuffer(GL_COPY_READ_BUFFER, page.indexBuffer);
+					glBindBuffer(GL_COPY_WRITE_BUFFER, newIndices);
+					glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)mesh.indices.offset * sizeof(uint32_t),
+						(GLintptr)indices.offset * sizeof(uint32_t), (GLsizeiptr)mesh.indexCount * sizeof(uint32_t));
+					mesh.indices = indices;
+				}
+			}
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			GpuMemory::destroy(GpuMemory::BUFFER, page.vertexBuffer);
+			GpuMemory::destroy(GpuMemory::BUFFER, page.indexBuffer);
+			page.vertexBuffer = newVertices;
+			page.indexBuffer = newIndices;
+		}
+		currentPage = OffsetAllocator::INVALID;
+	}
+
+	//true when the meshes, sorted by vertex offset, fill their page's vertices and indices from
+	//the front with no holes between them
+	bool isPacked(const std::vector<uint32_t>& live) const {
+		uint32_t nextVertex = 0;
+		std::vector<std::pair<uint32_t, uint32_t>> indexRanges;
+		for (uint32_t i : live) {
+			const Mesh& mesh = meshes[i];
+			if (mesh.vertices.offset != nextVertex) return false;
+			nextVertex += mesh.vertexCount;
+			if (mesh.indexCount > 0) indexRanges.push_back({ mesh.indices.offset, mesh.indexCount });
+		}
+		std::sort(indexRanges.begin(), indexRanges.end());
+		uint32_t nextIndex = 0;
+		for (const std::pair<uint32_t, uint32_t>& range : indexRanges) {
+			if (range.first != nextIndex) return false;
+			nextIndex += range.second;
+		}
+		return true;
+	}
+
+	//worst vertex fragmentation over all pages, see OffsetAllocator::fragmentation
+	float fragmentation() const {
+		float worst = 0.0f;
+		for (const Page& page : pages) worst = std::max(worst, page.vertexAllocator.fragmentation());
+		return worst;
+	}
+	size_t pageCount() const { return pages.size(); }
+
+	void resetStats() {
+		vaoBinds = 0;
+		bufferBinds = 0;
+		draws = 0;
+	}
+	void report() const {
+		std::cout << "MESH_POOL " << pages.size() << " pages, " << draws << " draws, " << vaoBinds << " VAO binds, "
+			<< bufferBinds << " buffer binds, fragmentation " << fragmentation() << std::endl;
+	}
+
+private:
+	struct Page {
+		unsigned int vertexBuffer = 0;
+		unsigned int indexBuffer = 0;
+		OffsetAllocator vertexAllocator;
+		OffsetAllocator indexAllocator;
+		Page(uint32_t vertices, uint32_t indices) : vertexAllocator(vertices), indexAllocator(indices) {}
+	};
+	struct Mesh {
+		OffsetAllocator::Allocation vertices;
+		OffsetAllocator::Allocation indices;
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;
+		uint32_t page = 0;
+		bool live = false;
+	};
+
+	VertexFormat format;
+	uint32_t verticesPerPage;
+	uint32_t indicesPerPage;
+	bool separateFormat;
+	unsigned int VAO = 0;
+	std::vector<Page> pages;
+	std::vector<Mesh> meshes;
+	std::vector<uint32_t> freeIds;
+	uint32_t currentPage = OffsetAllocator::INVALID;
+
+	void createPage() {
+		pages.emplace_back(verticesPerPage, indicesPerPage);
+		Page& page = pages.back();
+		glGenBuffers(1, &page.vertexBuffer);
+		glGenBuffers(1, &page.indexBuffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, page.vertexBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)verticesPerPage * format.stride, NULL, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, page.indexBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)indicesPerPage * sizeof(uint32_t), NULL, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		trackPage(page.vertexBuffer, page.indexBuffer);
+	}
+	void trackPage(unsigned int vertexBuffer, unsigned int indexBuffer) {
+		GpuMemory::track(GpuMemory::BUFFER, vertexBuffer, (size_t)verticesPerPage * format.stride, "mesh pool");
+		GpuMemory::track(GpuMemory::BUFFER, indexBuffer, (size_t)indicesPerPage * sizeof(uint32_t), "mesh pool");
+	}
+
+	//expects the pool's VAO to be bound
+	void bindPage(uint32_t index) {
+		const Page& page = pages[index];
+		if (separateFormat) {
+			glBindVertexBuffer(0, page.vertexBuffer, 0, format.stride);
+		}
+		else {
+			glBindBuffer(GL_ARRAY_BUFFER, page.vertexBuffer);
+			for (const VertexFormat::Attribute& a : format.attributes) {
+				glVertexAttribPointer(a.index, a.size, a.type, a.normalized, format.stride, (void*)(size_t)a.offset);
+				glEnableVertexAttribArray(a.index);
+			}
+		}
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.indexBuffer);
+		bufferBinds++;
+		currentPage = index;
+	}
+};
+
+
+//three meshes in a 64 vertex page, the middle one removed: defragment has to move the last
+//one into the hole with its data, and a mesh too big for what is left opens a second page
+inline bool selfTestMeshPool() {
+	VertexFormat format(sizeof(float));
+	format.add(0, 1, GL_FLOAT, 0);
+	MeshPool pool(format, 64, 64);
+	bool passed = true;
+	auto check = [&passed](bool condition, const char* what) {
+		if (!condition) {
+			std::cout << "ERROR::MESH_POOL::SELFTEST " << what << std::endl;
+			passed = false;
+		}
+	};
+	//every vertex holds the id of its mesh, so moved data can be recognised
+	auto mesh = [](uint32_t count, float id) { return std::vector<float>(count, id); };
+
+	MeshHandle a = pool.add(mesh(10, 1.0f).data(), 10);
+	MeshHandle b = pool.add(mesh(20, 2.0f).data(), 20);
+	MeshHandle c = pool.add(mesh(10, 3.0f).data(), 10);
+	check(pool.firstVertex(a) == 0 && pool.firstVertex(b) == 10 && pool.firstVertex(c) == 30, "offsets");
+	check(!pool.add(NULL, 0).valid(), "empty mesh rejected");
+
+	pool.remove(b);
+	check(pool.fragmentation() > 0.0f, "hole after remove");
+	pool.defragment();
+	check(pool.firstVertex(a) == 0 && pool.firstVertex(c) == 10, "offsets after defragment");
+	check(pool.fragmentation() == 0.0f, "no fragmentation after defragment");
+
+	std::vector<float> contents(20);
+	glBindBuffer(GL_COPY_READ_BUFFER, pool.vertexBufferOf(0));
+	glGetBufferSubData(GL_COPY_READ_BUFFER, 0, contents.size() * sizeof(float), contents.data());
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	std::vector<float> expected = mesh(10, 1.0f);
+	expected.resize(20, 3.0f);
+	check(contents == expected, "data moved with the mesh");
+
+	//the freed id is handed out again, 44 vertices are left so 50 need a page of their own
+	MeshHandle d = pool.add(mesh(50, 4.0f).data(), 50);
+	check(d.id == b.id, "id reused");
+	check(pool.pageOf(d) == 1 && pool.firstVertex(d) == 0 && pool.pageCount() == 2, "second page");
+	check(!pool.add(mesh(65, 5.0f).data(), 65).valid(), "mesh larger than a page rejected");
+	pool.report();
+
+	std::cout << "SELFTEST mesh-pool: " << (passed ? "passed" : "FAILED") << std::endl;
+	return passed;
+}
+
+#endif
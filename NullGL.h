@@ -0,0 +1,156 @@
+#ifndef NULL_GL_H
+#define NULL_GL_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include "GLFunctions.h"
+
+
+//a GL backend that does nothing but count. install() points every glad function pointer at a
+//stub, so engine code runs without a context or a driver and only our own CPU cost is left to
+//measure. stubs return zero, except the few entry points below that have to hand back names,
+//success or memory for the calling code to keep going
+namespace NullGL {
+
+	//calls per entry point since the last reset, the engine only calls GL from one thread
+	inline uint64_t calls[GL_FUNCTION_COUNT];
+
+	inline void resetCounts() {
+		std::memset(calls, 0, sizeof(calls));
+	}
+	inline uint64_t totalCalls() {
+		uint64_t total = 0;
+		for (int i = 0; i < GL_FUNCTION_COUNT; i++) total += calls[i];
+		return total;
+	}
+
+	//one counting stub per entry point, the Id keeps every instantiation a distinct function
+	template<int Id, typename T>
+	struct Stub;
+	template<int Id, typename R, typename... A>
+	struct Stub<Id, R(APIENTRYP)(A...)> {
+		static R APIENTRY call(A...) {
+			calls[Id]++;
+			return R();
+		}
+	};
+
+	//names handed out by glGen*, glCreate* and glFenceSync, never reused
+	inline GLuint nextName = 1;
+	//memory glMapBufferRange returns, grown to the largest range asked for
+	inline std::vector<unsigned char> mapped;
+
+	inline void generate(GLsizei n, GLuint* ids) {
+		for (GLsizei i = 0; i < n; i++) ids[i] = nextName++;
+	}
+
+	inline void APIENTRY genBuffers(GLsizei n, GLuint* ids) { calls[GLID_glGenBuffers]++; generate(n, ids); }
+	inline void APIENTRY genVertexArrays(GLsizei n, GLuint* ids) { calls[GLID_glGenVertexArrays]++; generate(n, ids); }
+	inline void APIENTRY genTextures(GLsizei n, GLuint* ids) { calls[GLID_glGenTextures]++; generate(n, ids); }
+	inline void APIENTRY genFramebuffers(GLsizei n, GLuint* ids) { calls[GLID_glGenFramebuffers]++; generate(n, ids); }
+	inline void APIENTRY genRenderbuffers(GLsizei n, GLuint* ids) { calls[GLID_glGenRenderbuffers]++; generate(n, ids); }
+	inline void APIENTRY genQueries(GLsizei n, GLuint* ids) { calls[GLID_glGenQueries]++; generate(n, ids); }
+	inline void APIENTRY createBuffers(GLsizei n, GLuint* ids) { calls[GLID_glCreateBuffers]++; generate(n, ids); }
+	inline void APIENTRY createVertexArrays(GLsizei n, GLuint* ids) { calls[GLID_glCreateVertexArrays]++; generate(n, ids); }
+	inline void APIENTRY createTextures(GLenum, GLsizei n, GLuint* ids) { calls[GLID_glCreateTextures]++; generate(n, ids); }
+	inline void APIENTRY createFramebuffers(GLsizei n, GLuint* ids) { calls[GLID_glCreateFramebuffers]++; generate(n, ids); }
+	inline GLuint APIENTRY createShader(GLenum) { calls[GLID_glCreateShader]++; return nextName++; }
+	inline GLuint APIENTRY createProgram() { calls[GLID_glCreateProgram]++; return nextName++; }
+
+	//every compile and link succeeds, and the version queries report 4.6
+	inline void APIENTRY getShaderiv(GLuint, GLenum, GLint* value) { calls[GLID_glGetShaderiv]++; *value = GL_TRUE; }
+	inline void APIENTRY getProgramiv(GLuint, GLenum, GLint* value) { calls[GLID_glGetProgramiv]++; *value = GL_TRUE; }
+	inline void APIENTRY getIntegerv(GLenum pname, GLint* value) {
+		calls[GLID_glGetIntegerv]++;
+		*value = pname == GL_MAJOR_VERSION ? 4 : pname == GL_MINOR_VERSION ? 6 : 0;
+	}
+	inline const GLubyte* APIENTRY getString(GLenum) {
+		calls[GLID_glGetString]++;
+		return (const GLubyte*)"NullGL";
+	}
+	inline GLenum APIENTRY checkFramebufferStatus(GLenum) {
+		calls[GLID_glCheckFramebufferStatus]++;
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	//fences are signalled as soon as they exist and queries are always ready
+	inline GLsync APIENTRY fenceSync(GLenum, GLbitfield) {
+		calls[GLID_glFenceSync]++;
+		return (GLsync)(uintptr_t)nextName++;
+	}
+	inline GLenum APIENTRY clientWaitSync(GLsync, GLbitfield, GLuint64) {
+		calls[GLID_glClientWaitSync]++;
+		return GL_ALREADY_SIGNALED;
+	}
+	inline void APIENTRY getQueryObjectiv(GLuint, GLenum, GLint* value) { calls[GLID_glGetQueryObjectiv]++; *value = 1; }
+
+	inline void* APIENTRY mapBufferRange(GLenum, GLintptr, GLsizeiptr length, GLbitfield) {
+		calls[GLID_glMapBufferRange]++;
+		if (mapped.size() < (size_t)length) mapped.resize((size_t)length);
+		return mapped.data();
+	}
+	inline GLboolean APIENTRY unmapBuffer(GLenum) {
+		calls[GLID_glUnmapBuffer]++;
+		return GL_TRUE;
+	}
+
+	//replaces whatever glad loaded, including NULL when there is no context at all
+	inline void install() {
+#define GL_FUNCTION(name, type) glad_##name = &Stub<GLID_##name, type>::call;
+		GL_FUNCTION_LIST
+#undef GL_FUNCTION
+
+		glad_glGenBuffers = genBuffers;
+		glad_glGenVertexArrays = genVertexArrays;
+		glad_glGenTextures = genTextures;
+		glad_glGenFramebuffers = genFramebuffers;
+		glad_glGenRenderbuffers = genRenderbuffers;
+		glad_glGenQueries = genQueries;
+		glad_glCreateBuffers = createBuffers;
+		glad_glCreateVertexArrays = createVertexArrays;
+		glad_glCreateTextures = createTextures;
+		glad_glCreateFramebuffers = createFramebuffers;
+		glad_glCreateShader = createShader;
+		glad_glCreateProgram = createProgram;
+		glad_glGetShaderiv = getShaderiv;
+		glad_glGetProgramiv = getProgramiv;
+		glad_glGetIntegerv = getIntegerv;
+		glad_glGetString = getString;
+		glad_glCheckFramebufferStatus = checkFramebufferStatus;
+		glad_glFenceSync = fenceSync;
+		glad_glClientWaitSync = clientWaitSync;
+		glad_glGetQueryObjectiv = getQueryObjectiv;
+		glad_glMapBufferRange = mapBufferRange;
+		glad_glUnmapBuffer = unmapBuffer;
+
+		//code that checks the version before taking a path sees a full 4.6 context
+		GLAD_GL_VERSION_1_0 = GLAD_GL_VERSION_1_1 = GLAD_GL_VERSION_1_2 = GLAD_GL_VERSION_1_3 = 1;
+		GLAD_GL_VERSION_1_4 = GLAD_GL_VERSION_1_5 = GLAD_GL_VERSION_2_0 = GLAD_GL_VERSION_2_1 = 1;
+		GLAD_GL_VERSION_3_0 = GLAD_GL_VERSION_3_1 = GLAD_GL_VERSION_3_2 = GLAD_GL_VERSION_3_3 = 1;
+		GLAD_GL_VERSION_4_0 = GLAD_GL_VERSION_4_1 = GLAD_GL_VERSION_4_2 = GLAD_GL_VERSION_4_3 = 1;
+		GLAD_GL_VERSION_4_4 = GLAD_GL_VERSION_4_5 = GLAD_GL_VERSION_4_6 = 1;
+		GLVersion.major = 4;
+		GLVersion.minor = 6;
+		resetCounts();
+	}
+
+	//the entry points called since the last reset, most called first
+	inline void report(size_t limit = 10) {
+		std::vector<int> used;
+		for (int i = 0; i < GL_FUNCTION_COUNT; i++) {
+			if (calls[i] > 0) used.push_back(i);
+		}
+		std::sort(used.begin(), used.end(), [](int a, int b) { return calls[a] > calls[b]; });
+		std::cout << "NULL_GL " << totalCalls() << " calls to " << used.size() << " entry points" << std::endl;
+		for (size_t i = 0; i < used.size() && i < limit; i++) {
+			std::cout << "  " << glFunctionNames[used[i]] << " " << calls[used[i]] << std::endl;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef OFFSET_ALLOCATOR_H
+#define OFFSET_ALLOCATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+//two level segregated fit allocator over a range of offsets, it never touches the memory
+//it manages so the same allocator hands out ranges inside a GL buffer.
+//allocate and free are O(1): free blocks live in size class lists found with two bitmap scans
+class OffsetAllocator {
+public:
+	static const uint32_t INVALID = 0xffffffff;
+
+	struct Allocation {
+		uint32_t offset = INVALID;
+		uint32_t node = INVALID;
+		bool valid() const { return offset != INVALID; }
+	};
+
+	OffsetAllocator(uint32_t size, uint32_t maxAllocations = 64 * 1024) : size(size) {
+		//every allocation can leave one free block behind it
+		nodes.resize(maxAllocations * 2 + 1);
+		freeNodes.reserve(nodes.size());
+		reset();
+	}
+
+	//throws every allocation away and turns the whole range back into one free block
+	void reset() {
+		freeNodes.clear();
+		for (uint32_t i = (uint32_t)nodes.size(); i > 0; i--) {
+			freeNodes.push_back(i - 1);
+		}
+		flMap = 0;
+		for (int i = 0; i < FL_COUNT; i++) {
+			slMap[i] = 0;
+			for (int j = 0; j < SL_COUNT; j++) bins[i][j] = INVALID;
+		}
+		freeSpace = 0;
+		allocationCount = 0;
+		if (size > 0) insertFree(size, 0, INVALID, INVALID);
+	}
+
+	//returns an invalid allocation when no free block is large enough
+	Allocation allocate(uint32_t count) {
+		Allocation result;
+		if (count == 0 || freeNodes.size() < 2) return result;
+
+		int fl, sl;
+		mappingSearch(count, fl, sl);
+		if (!findSuitable(fl, sl)) return result;
+
+		uint32_t index = bins[fl][sl];
+		removeFree(index);
+		Node& node = nodes[index];
+		node.used = true;
+
+		//split the tail off into a new free block
+		uint32_t remainder = node.size - count;
+		if (remainder > 0) {
+			node.size = count;
+			uint32_t tail = insertFree(remainder, node.offset + count, index, node.physNext);
+			if (nodes[tail].physNext != INVALID) nodes[nodes[tail].physNext].physPrev = tail;
+			nodes[index].physNext = tail;
+		}
+
+		allocationCount++;
+		result.offset = nodes[index].offset;
+		result.node = index;
+		return result;
+	}
+
+	//returns the block and merges it with free physical neighbours
+	void free(Allocation allocation) {
+		if (!allocation.valid()) return;
+		uint32_t index = allocation.node;
+		Node node = nodes[index];
+		uint32_t offset = node.offset;
+		uint32_t blockSize = node.size;
+		uint32_t prev = node.physPrev;
+		uint32_t next = node.physNext;
+
+		if (prev != INVALID && !nodes[prev].used) {
+			offset = nodes[prev].offset;
+			blockSize += nodes[prev].size;
+			uint32_t prevPrev = nodes[prev].physPrev;
+			removeFree(prev);
+			freeNodes.push_back(prev);
+			prev = prevPrev;
+		}
+		if (next != INVALID && !nodes[next].used) {
+			blockSize += nodes[next].size;
+			uint32_t nextNext = nodes[next].physNext;
+			removeFree(next);
+			freeNodes.push_back(next);
+			next = nextNext;
+		}
+		freeNodes.push_back(index);
+		allocationCount--;
+
+		uint32_t merged = insertFree(blockSize, offset, prev, next);
+		if (prev != INVALID) nodes[prev].physNext = merged;
+		if (next != INVALID) nodes[next].physPrev = merged;
+	}
+
+	uint32_t capacity() const { return size; }
+	uint32_t freeCount() const { return freeSpace; }
+	uint32_t liveAllocations() const { return allocationCount; }
+
+	//size of the biggest free block, found from the highest non empty bin
+	uint32_t largestFree() const {
+		if (flMap == 0) return 0;
+		int fl = 31 - countLeadingZeros(flMap);
+		int sl = 31 - countLeadingZeros(slMap[fl]);
+		uint32_t largest = 0;
+		for (uint32_t i = bins[fl][sl]; i != INVALID; i = nodes[i].binNext) {
+			largest = std::max(largest, nodes[i].size);
+		}
+		return largest;
+	}
+
+	//0 when all free space is one block, approaching 1 as it splinters
+	float fragmentation() const {
+		if (freeSpace == 0) return 0.0f;
+		return 1.0f - (float)largestFree() / (float)freeSpace;
+	}
+
+private:
+	static const int SL_BITS = 3;
+	static const int SL_COUNT = 1 << SL_BITS;
+	static const int FL_COUNT = 32 - SL_BITS + 1;
+
+	struct Node {
+		uint32_t offset = 0;
+		uint32_t size = 0;
+		uint32_t binPrev = INVALID;
+		uint32_t binNext = INVALID;
+		uint32_t physPrev = INVALID;
+		uint32_t physNext = INVALID;
+		bool used = false;
+	};
+
+	uint32_t size;
+	std::vector<Node> nodes;
+	std::vector<uint32_t> freeNodes;
+	uint32_t flMap = 0;
+	uint32_t slMap[FL_COUNT];
+	uint32_t bins[FL_COUNT][SL_COUNT];
+	uint32_t freeSpace = 0;
+	uint32_t allocationCount = 0;
+
+	static int countLeadingZeros(uint32_t v) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse(&index, v);
+		return 31 - (int)index;
+#else
+		return __builtin_clz(v);
+#endif
+	}
+	static int countTrailingZeros(uint32_t v) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, v);
+		return (int)index;
+#else
+		return __builtin_ctz(v);
+#endif
+	}
+
+	//size class a block of this size is filed under
+	static void mapping(uint32_t count, int& fl, int& sl) {
+		if (count < (uint32_t)SL_COUNT) {
+			fl = 0;
+			sl = (int)count;
+		}
+		else {
+			int msb = 31 - countLeadingZeros(count);
+			fl = msb - SL_BITS + 1;
+			sl = (int)((count >> (msb - SL_BITS)) ^ SL_COUNT);
+		}
+	}
+	//size class whose every block is guaranteed to fit the request
+	static void mappingSearch(uint32_t count, int& fl, int& sl) {
+		if (count >= (uint32_t)SL_COUNT) {
+			int msb = 31 - countLeadingZeros(count);
+			uint64_t rounded = (uint64_t)count + ((1u << (msb - SL_BITS)) - 1);
+			count = (uint32_t)std::min<uint64_t>(rounded, 0xffffffffu);
+		}
+		mapping(count, fl, sl);
+	}
+	bool findSuitable(int& fl, int& sl) const {
+		uint32_t slBits = sl < 32 ? slMap[fl] & (~0u << sl) : 0;
+		if (slBits == 0) {
+			uint32_t flBits = fl + 1 < 32 ? flMap & (~0u << (fl + 1)) : 0;
+			if (flBits == 0) return false;
+			fl = countTrailingZeros(flBits);
+			slBits = slMap[fl];
+		}
+		sl = countTrailingZeros(slBits);
+		return true;
+	}
+
+	uint32_t insertFree(uint32_t blockSize, uint32_t offset, uint32_t physPrev, uint32_t physNext) {
+		uint32_t index = freeNodes.back();
+		freeNodes.pop_back();
+		int fl, sl;
+		mapping(blockSize, fl, sl);
+
+		Node& node = nodes[index];
+		node.offset = offset;
+		node.size = blockSize;
+		node.used = false;
+		node.physPrev = physPrev;
+		node.physNext = physNext;
+		node.binPrev = INVALID;
+		node.binNext = bins[fl][sl];
+		if (node.binNext != INVALID) nodes[node.binNext].binPrev = index;
+		bins[fl][sl] = index;
+		slMap[fl] |= 1u << sl;
+		flMap |= 1u << fl;
+		freeSpace += blockSize;
+		return index;
+	}
+	void removeFree(uint32_t index) {
+		Node& node = nodes[index];
+		int fl, sl;
+		mapping(node.size, fl, sl);
+		if (node.binPrev != INVALID) nodes[node.binPrev].binNext = node.binNext;
+		else bins[fl][sl] = node.binNext;
+		if (node.binNext != INVALID) nodes[node.binNext].binPrev = node.binPrev;
+		if (bins[fl][sl] == INVALID) {
+			slMap[fl] &= ~(1u << sl);
+			if (slMap[fl] == 0) flMap &= ~(1u << fl);
+		}
+		freeSpace -= node.size;
+	}
+};
+
+
+//known offsets through allocation, reuse of a freed hole, coalescing back into one block and
+//exhaustion, checked against the numbers the front to back split must produce
+inline bool selfTestOffsetAllocator() {
+	//a power of two, so the whole range is a size class of its own and can be handed out in one piece
+	const uint32_t size = 1024;
+	OffsetAllocator allocator(size, 16);
+	bool passed = true;
+	auto check = [&passed](bool condition, const char* what) {
+		if (!condition) {
+			std::cout << "ERROR::OFFSET_ALLOCATOR::SELFTEST " << what << std::endl;
+			passed = false;
+		}
+	};
+
+	OffsetAllocator::Allocation a = allocator.allocate(100);
+	OffsetAllocator::Allocation b = allocator.allocate(50);
+	OffsetAllocator::Allocation c = allocator.allocate(200);
+	check(a.offset == 0 && b.offset == 100 && c.offset == 150, "front to back offsets");
+	check(allocator.freeCount() == size - 350 && allocator.liveAllocations() == 3, "free count after allocation");
+	check(allocator.largestFree() == size - 350 && allocator.fragmentation() == 0.0f, "one tail block");
+	check(!allocator.allocate(0).valid(), "empty allocation");
+
+	//the hole left by b is the smallest class that fits, so it is reused before the tail
+	allocator.free(b);
+	check(allocator.freeCount() == size - 300 && allocator.fragmentation() > 0.0f, "hole after free");
+	OffsetAllocator::Allocation d = allocator.allocate(40);
+	check(d.offset == 100, "hole reused");
+	allocator.free(d);
+
+	//a merges with the hole behind it, c then with both neighbours
+	allocator.free(a);
+	check(allocator.liveAllocations() == 1 && allocator.largestFree() == size - 350, "merge with next");
+	OffsetAllocator::Allocation e = allocator.allocate(128);
+	check(e.offset == 0, "merged block starts at 0");
+	allocator.free(e);
+	allocator.free(c);
+	check(allocator.freeCount() == size && allocator.largestFree() == size && allocator.fragmentation() == 0.0f,
+		"everything coalesced");
+
+	OffsetAllocator::Allocation all = allocator.allocate(size);
+	check(all.offset == 0 && !allocator.allocate(1).valid() && allocator.freeCount() == 0, "exhaustion");
+	allocator.reset();
+	check(allocator.freeCount() == size && allocator.liveAllocations() == 0, "reset");
+
+	std::cout << "SELFTEST offset-allocator: " << (passed ? "passed" : "FAILED") << std::endl;
+	return passed;
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef PNG_H
+#define PNG_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+
+//minimal PNG support: RGBA8, zlib stream of stored (uncompressed) deflate blocks. files are
+//as large as the raw pixels but encoding is a copy plus two checksums, so a capture writer
+//thread keeps up at 4K, which a real deflate would not. decode reads back only what encode
+//writes, which is all the golden image references need
+namespace Png {
+	inline uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+		//function local static, so the table is built once even with several writer threads
+		struct Table {
+			uint32_t entries[256];
+			Table() {
+				for (uint32_t i = 0; i < 256; i++) {
+					uint32_t c = i;
+					for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					entries[i] = c;
+				}
+			}
+		};
+		static const Table table;
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++) crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	inline void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+		out.push_back((uint8_t)(value >> 24));
+		out.push_back((uint8_t)(value >> 16));
+		out.push_back((uint8_t)(value >> 8));
+		out.push_back((uint8_t)value);
+	}
+
+	inline void putChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size) {
+		putBigEndian(out, (uint32_t)size);
+		size_t start = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data, data + size);
+		putBigEndian(out, crc32(out.data() + start, size + 4));
+	}
+
+	//rows are given bottom up, as glReadPixels returns them, and written top down
+	inline void encode(const uint8_t* rgba, int width, int height, std::vector<uint8_t>& out) {
+		out.clear();
+		const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		out.insert(out.end(), signature, signature + 8);
+		uint8_t header[13] = {};
+		for (int i = 0; i < 4; i++) {
+			header[i] = (uint8_t)(width >> (24 - i * 8));
+			header[4 + i] = (uint8_t)(height >> (24 - i * 8));
+		}
+		header[8] = 8; //bit depth
+		header[9] = 6; //RGBA
+		putChunk(out, "IHDR", header, sizeof(header));
+
+		//filter byte 0 before each row, then split into stored blocks of at most 65535 bytes
+		size_t rowBytes = (size_t)width * 4;
+		std::vector<uint8_t> raw((rowBytes + 1) * height);
+		for (int y = 0; y < height; y++) {
+			uint8_t* row = raw.data() + (rowBytes + 1) * y;
+			row[0] = 0;
+			std::memcpy(row + 1, rgba + rowBytes * (height - 1 - y), rowBytes);
+		}
+		std::vector<uint8_t> zlib;
+		zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+		zlib.push_back(0x78);
+		zlib.push_back(0x01);
+		uint32_t a = 1, b = 0;
+		for (size_t offset = 0; offset < raw.size(); ) {
+			size_t block = std::min<size_t>(65535, raw.size() - offset);
+			bool last = offset + block == raw.size();
+			zlib.push_back(last ? 1 : 0);
+			zlib.push_back((uint8_t)block);
+			zlib.push_back((uint8_t)(block >> 8));
+			zlib.push_back((uint8_t)~block);
+			zlib.push_back((uint8_t)(~block >> 8));
+			zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + block);
+			//adler32, sums reduced often enough that they cannot overflow
+			for (size_t i = offset; i < offset + block; ) {
+				size_t end = std::min(offset + block, i + 5552);
+				for (; i < end; i++) {
+					a += raw[i];
+					b += a;
+				}
+				a %= 65521;
+				b %= 65521;
+			}
+			offset += block;
+		}
+		putBigEndian(zlib, (b << 16) | a);
+		putChunk(out, "IDAT", zlib.data(), zlib.size());
+		putChunk(out, "IEND", NULL, 0);
+	}
+
+	inline uint32_t getBigEndian(const uint8_t* p) {
+		return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+	}
+
+	//returns rows bottom up like encode takes them, false for anything encode does not produce
+	inline bool decode(const std::vector<uint8_t>& file, int& width, int& height, std::vector<uint8_t>& rgba) {
+		const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		if (file.size() < 8 || std::memcmp(file.data(), signature, 8) != 0) return false;
+		std::vector<uint8_t> zlib;
+		width = height = 0;
+		for (size_t pos = 8; pos + 12 <= file.size(); ) {
+			uint32_t size = getBigEndian(file.data() + pos);
+			if (pos + 12 + size > file.size()) return false;
+			const uint8_t* type = file.data() + pos + 4;
+			const uint8_t* data = type + 4;
+			if (crc32(type, size + 4) != getBigEndian(data + size)) return false;
+			if (std::memcmp(type, "IHDR", 4) == 0) {
+				width = (int)getBigEndian(data);
+				height = (int)getBigEndian(data + 4);
+				//8 bit RGBA, no interlacing
+				if (data[8] != 8 || data[9] != 6 || data[12] != 0) return false;
+			}
+			else if (std::memcmp(type, "IDAT", 4) == 0) {
+				zlib.insert(zlib.end(), data, data + size);
+			}
+			pos += 12 + size;
+		}
+		if (width <= 0 || height <= 0 || zlib.size() < 2) return false;
+
+		std::vector<uint8_t> raw;
+		size_t rowBytes = (size_t)width * 4;
+		raw.reserve((rowBytes + 1) * height);
+		size_t pos = 2;
+		bool last = false;
+		while (!last) {
+			if (pos + 5 > zlib.size()) return false;
+			uint8_t blockHeader = zlib[pos];
+			last = (blockHeader & 1) != 0;
+			//only stored blocks, compressed ones come from other encoders
+			if ((blockHeader >> 1) != 0) return false;
+			size_t length = zlib[pos + 1] | (zlib[pos + 2] << 8);
+			pos += 5;
+			if (pos + length > zlib.size()) return false;
+			raw.insert(raw.end(), zlib.begin() + pos, zlib.begin() + pos + length);
+			pos += length;
+		}
+		if (raw.size() != (rowBytes + 1) * height) return false;
+		rgba.resize(rowBytes * height);
+		for (int y = 0; y < height; y++) {
+			const uint8_t* row = raw.data() + (rowBytes + 1) * y;
+			if (row[0] != 0) return false;
+			std::memcpy(rgba.data() + rowBytes * (height - 1 - y), row + 1, rowBytes);
+		}
+		return true;
+	}
+}
+
+#endif
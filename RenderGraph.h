@@ -0,0 +1,454 @@
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include "Texture.h"
+#include "Trace.h"
+
+
+//size and format of a graph texture. width and height of 0 mean the size follows the window
+//times scale, and only those textures are rebuilt when the window is resized
+struct RenderTextureDesc {
+	GLenum format = GL_RGBA8;
+	float scale = 1.0f;
+	int width = 0;
+	int height = 0;
+
+	static RenderTextureDesc windowRelative(GLenum format, float scale = 1.0f) {
+		RenderTextureDesc desc;
+		desc.format = format;
+		desc.scale = scale;
+		return desc;
+	}
+	static RenderTextureDesc fixed(GLenum format, int width, int height) {
+		RenderTextureDesc desc;
+		desc.format = format;
+		desc.width = width;
+		desc.height = height;
+		return desc;
+	}
+	bool isWindowRelative() const { return width == 0 || height == 0; }
+	//two textures may share one allocation only when this matches
+	bool compatible(const RenderTextureDesc& o) const {
+		return format == o.format && scale == o.scale && width == o.width && height == o.height;
+	}
+};
+
+//passes declare the textures they read and write and the graph works out the rest: passes
+//whose results nobody reads are culled, the rest run in dependency order, and transient
+//textures whose lifetimes do not overlap share one allocation. GL has no memory aliasing
+//between different resources, so sharing means reusing the same texture object, which
+//requires a matching format and size. imported textures (the window, or a target owned
+//elsewhere) are the graph's outputs and are never allocated or culled
+class RenderGraph {
+public:
+	typedef int Resource;
+
+	//what an executing pass gets to see
+	struct PassContext {
+		const RenderGraph* graph;
+		int width;
+		int height;
+		unsigned int texture(Resource resource) const { return graph->textureID(resource); }
+	};
+	typedef std::function<void(const PassContext&)> ExecuteFunction;
+
+	//share compatible transient textures, off allocates one texture per declared resource
+	bool aliasing = true;
+
+	RenderGraph(int windowWidth, int windowHeight) : windowWidth(windowWidth), windowHeight(windowHeight) {}
+	~RenderGraph() {
+		releaseFramebuffers();
+	}
+	RenderGraph(const RenderGraph&) = delete;
+	RenderGraph& operator=(const RenderGraph&) = delete;
+
+	Resource createTexture(const std::string& name, const RenderTextureDesc& desc) {
+		TextureNode node;
+		node.name = name;
+		node.desc = desc;
+		textures.push_back(node);
+		compiled = false;
+		return (Resource)textures.size() - 1;
+	}
+	//a texture owned outside the graph, 0 stands for the window's framebuffer
+	Resource importTexture(const std::string& name, unsigned int texture = 0) {
+		TextureNode node;
+		node.name = name;
+		node.imported = true;
+		node.importedID = texture;
+		textures.push_back(node);
+		compiled = false;
+		return (Resource)textures.size() - 1;
+	}
+	//points an imported resource at a new texture, for targets owned elsewhere that were
+	//recreated, such as a Framebuffer after resize. passes reach imported textures only
+	//through PassContext::texture and framebuffers never attach them, so nothing is rebuilt
+	void setImportedTexture(Resource resource, unsigned int texture) {
+		TextureNode& node = textures[resource];
+		if (!node.imported) {
+			std::cout << "ERROR::RENDER_GRAPH::NOT_IMPORTED " << node.name << std::endl;
+			return;
+		}
+		node.importedID = texture;
+	}
+
+	//passes that only write imported textures bind their own target, every other pass gets
+	//a framebuffer with its transient writes attached and the viewport set to their size
+	int addPass(const std::string& name, const std::vector<Resource>& reads, const std::vector<Resource>& writes,
+		ExecuteFunction execute) {
+		PassNode pass;
+		pass.name = name;
+		pass.traceName = Trace::intern(name);
+		pass.reads = reads;
+		pass.writes = writes;
+		pass.execute = execute;
+		passes.push_back(pass);
+		for (Resource r : writes) textures[r].writers.push_back((int)passes.size() - 1);
+		compiled = false;
+		return (int)passes.size() - 1;
+	}
+
+	//culls, orders, assigns allocations and creates textures and framebuffers
+	bool compile() {
+		TRACE_SCOPE("render graph compile");
+		releaseFramebuffers();
+		cull();
+		if (!sortPasses()) return false;
+		computeLifetimes();
+		assignAllocations();
+		for (Allocation& allocation : allocations) createTexture(allocation);
+		for (int p : order) createFramebuffer(passes[p]);
+		compiled = true;
+		return true;
+	}
+
+	void execute() {
+		if (!compiled && !compile()) return;
+		for (int p : order) {
+			PassNode& pass = passes[p];
+			TRACE_GPU_SCOPE(pass.traceName);
+			PassContext context = { this, windowWidth, windowHeight };
+			if (pass.framebuffer != 0) {
+				glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+				context.width = pass.width;
+				context.height = pass.height;
+				glViewport(0, 0, pass.width, pass.height);
+			}
+			pass.execute(context);
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, windowWidth, windowHeight);
+	}
+
+	//rebuilds window relative textures and the framebuffers they are attached to, nothing else
+	void resize(int width, int height) {
+		if (width <= 0 || height <= 0 || (width == windowWidth && height == windowHeight)) return;
+		windowWidth = width;
+		windowHeight = height;
+		if (!compiled) return;
+		size_t rebuiltTextures = 0, rebuiltFramebuffers = 0;
+		for (Allocation& allocation : allocations) {
+			if (!allocation.desc.isWindowRelative()) continue;
+			createTexture(allocation);
+			allocation.rebuilt = true;
+			rebuiltTextures++;
+		}
+		for (int p : order) {
+			PassNode& pass = passes[p];
+			bool affected = false;
+			for (Resource r : pass.writes) {
+				if (!textures[r].imported && allocations[textures[r].allocation].rebuilt) affected = true;
+			}
+			if (!affected) continue;
+			glDeleteFramebuffers(1, &pass.framebuffer);
+			pass.framebuffer = 0;
+			createFramebuffer(pass);
+			rebuiltFramebuffers++;
+		}
+		for (Allocation& allocation : allocations) allocation.rebuilt = false;
+		std::cout << "RENDER_GRAPH resize " << width << "x" << height << ": rebuilt " << rebuiltTextures << " of "
+			<< allocations.size() << " textures, " << rebuiltFramebuffers << " framebuffers" << std::endl;
+	}
+
+	unsigned int textureID(Resource resource) const {
+		const TextureNode& node = textures[resource];
+		if (node.imported) return node.importedID;
+		if (node.allocation < 0) return 0;
+		return allocations[node.allocation].texture ? allocations[node.allocation].texture->ID : 0;
+	}
+	//the framebuffer a pass renders into, 0 for passes that bind their own
+	unsigned int framebufferOf(int pass) const {
+		return passes[pass].framebuffer;
+	}
+	bool isCulled(int pass) const {
+		return passes[pass].culled;
+	}
+
+	//bytes the current allocations hold, and what the same graph needs with aliasing on and off
+	size_t allocatedBytes() const {
+		size_t total = 0;
+		for (const Allocation& allocation : allocations) total += allocation.bytes();
+		return total;
+	}
+	size_t peakBytes(bool withAliasing) const {
+		std::vector<RenderTextureDesc> descs;
+		planAllocations(withAliasing, descs);
+		size_t total = 0;
+		for (const RenderTextureDesc& desc : descs) total += allocationBytes(desc);
+		return total;
+	}
+
+	void report() const {
+		size_t culled = 0, transient = 0;
+		for (const PassNode& pass : passes) culled += pass.culled ? 1 : 0;
+		for (const TextureNode& node : textures) transient += !node.imported && node.firstUse >= 0 ? 1 : 0;
+		std::cout << "RENDER_GRAPH " << order.size() << " passes (" << culled << " culled), " << transient
+			<< " transient textures in " << allocations.size() << " allocations, peak "
+			<< peakBytes(true) / 1024 << " KiB aliased, " << peakBytes(false) / 1024 << " KiB without aliasing" << std::endl;
+		std::cout << "RENDER_GRAPH order:";
+		for (int p : order) std::cout << " " << passes[p].name;
+		std::cout << std::endl;
+	}
+
+private:
+	struct TextureNode {
+		std::string name;
+		RenderTextureDesc desc;
+		bool imported = false;
+		unsigned int importedID = 0;
+		std::vector<int> writers;
+		int readers = 0;
+		//positions in the execution order, -1 when unused
+		int firstUse = -1;
+		int lastUse = -1;
+		int allocation = -1;
+	};
+	struct PassNode {
+		std::string name;
+		const char* traceName = NULL;
+		std::vector<Resource> reads;
+		std::vector<Resource> writes;
+		ExecuteFunction execute;
+		bool culled = false;
+		int references = 0;
+		unsigned int framebuffer = 0;
+		int width = 0;
+		int height = 0;
+	};
+	//one real texture, shared by every transient resource assigned to it
+	struct Allocation {
+		RenderTextureDesc desc;
+		bool rebuilt = false;
+		std::unique_ptr<Texture2D> texture;
+		size_t bytes() const { return texture ? texture->bytes : 0; }
+	};
+
+	std::vector<TextureNode> textures;
+	std::vector<PassNode> passes;
+	std::vector<int> order;
+	std::vector<Allocation> allocations;
+	int windowWidth;
+	int windowHeight;
+	bool compiled = false;
+
+	//reference counting from the outputs backwards: a texture nobody reads lets its writers
+	//go, and a culled pass in turn stops referencing the textures it read
+	void cull() {
+		for (TextureNode& node : textures) node.readers = node.imported ? 1 : 0;
+		for (PassNode& pass : passes) {
+			pass.culled = false;
+			pass.references = (int)pass.writes.size();
+			for (Resource r : pass.reads) textures[r].readers++;
+		}
+		std::vector<Resource> unused;
+		for (int r = 0; r < (int)textures.size(); r++) {
+			if (textures[r].readers == 0) unused.push_back(r);
+		}
+		while (!unused.empty()) {
+			Resource r = unused.back();
+			unused.pop_back();
+			for (int w : textures[r].writers) {
+				PassNode& writer = passes[w];
+				if (writer.culled || --writer.references > 0) continue;
+				writer.culled = true;
+				for (Resource read : writer.reads) {
+					if (--textures[read].readers == 0) unused.push_back(read);
+				}
+			}
+		}
+	}
+
+	//declaration order is the program order the dependencies are read from. a pass runs
+	//after the writers declared before it of what it reads or writes, and before the writers
+	//declared after it of what it reads, so they cannot overwrite its input first. a pass
+	//reading a texture no earlier pass writes either reads the previous frame's contents,
+	//for imported textures, or waits for the later declared writers, for transient ones,
+	//which lets producers be declared after their consumers. among the passes that are
+	//ready the earliest declared goes first
+	bool sortPasses() {
+		const int count = (int)passes.size();
+		std::vector<std::vector<int>> dependents(count);
+		for (int r = 0; r < (int)textures.size(); r++) {
+			std::vector<int> writers;
+			for (int w : textures[r].writers) {
+				if (!passes[w].culled) writers.push_back(w);
+			}
+			std::sort(writers.begin(), writers.end());
+			for (size_t i = 1; i < writers.size(); i++) dependents[writers[i - 1]].push_back(writers[i]);
+			for (int p = 0; p < count; p++) {
+				const PassNode& pass = passes[p];
+				if (pass.culled || std::find(pass.reads.begin(), pass.reads.end(), r) == pass.reads.end()) continue;
+				bool writtenBefore = !writers.empty() && writers.front() < p;
+				for (int w : writers) {
+					if (w < p) dependents[w].push_back(p);
+					else if (w > p && (writtenBefore || textures[r].imported)) dependents[p].push_back(w);
+					else if (w > p) dependents[w].push_back(p);
+				}
+			}
+		}
+		std::vector<int> waiting(count, 0);
+		for (std::vector<int>& list : dependents) {
+			std::sort(list.begin(), list.end());
+			list.erase(std::unique(list.begin(), list.end()), list.end());
+			for (int d : list) waiting[d]++;
+		}
+		order.clear();
+		std::vector<bool> done(count, false);
+		while (true) {
+			int next = -1;
+			for (int p = 0; p < count && next < 0; p++) {
+				if (!passes[p].culled && !done[p] && waiting[p] == 0) next = p;
+			}
+			if (next < 0) break;
+			done[next] = true;
+			order.push_back(next);
+			for (int d : dependents[next]) waiting[d]--;
+		}
+		int live = 0;
+		for (const PassNode& pass : passes) live += pass.culled ? 0 : 1;
+		if ((int)order.size() != live) {
+			std::cout << "ERROR::RENDER_GRAPH::CYCLE" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	void computeLifetimes() {
+		for (TextureNode& node : textures) {
+			node.firstUse = node.lastUse = -1;
+		}
+		for (int i = 0; i < (int)order.size(); i++) {
+			const PassNode& pass = passes[order[i]];
+			for (const std::vector<Resource>* list : { &pass.reads, &pass.writes }) {
+				for (Resource r : *list) {
+					TextureNode& node = textures[r];
+					if (node.firstUse < 0) node.firstUse = i;
+					node.lastUse = i;
+				}
+			}
+		}
+	}
+
+	//greedy interval assignment in order of first use: reuse any compatible allocation whose
+	//last user has already run, otherwise start a new one. returns the allocation per texture
+	std::vector<int> planAllocations(bool withAliasing, std::vector<RenderTextureDesc>& descs) const {
+		std::vector<int> assignment(textures.size(), -1);
+		std::vector<int> lastUses;
+		std::vector<Resource> transient;
+		for (int r = 0; r < (int)textures.size(); r++) {
+			if (!textures[r].imported && textures[r].firstUse >= 0) transient.push_back(r);
+		}
+		std::sort(transient.begin(), transient.end(), [&](Resource a, Resource b) {
+			return textures[a].firstUse < textures[b].firstUse;
+		});
+		for (Resource r : transient) {
+			const TextureNode& node = textures[r];
+			int chosen = -1;
+			for (int a = 0; withAliasing && a < (int)descs.size() && chosen < 0; a++) {
+				if (lastUses[a] < node.firstUse && descs[a].compatible(node.desc)) chosen = a;
+			}
+			if (chosen < 0) {
+				descs.push_back(node.desc);
+				lastUses.push_back(-1);
+				chosen = (int)descs.size() - 1;
+			}
+			lastUses[chosen] = node.lastUse;
+			assignment[r] = chosen;
+		}
+		return assignment;
+	}
+	void assignAllocations() {
+		std::vector<RenderTextureDesc> descs;
+		std::vector<int> assignment = planAllocations(aliasing, descs);
+		allocations.clear();
+		allocations.resize(descs.size());
+		for (size_t a = 0; a < descs.size(); a++) allocations[a].desc = descs[a];
+		for (size_t r = 0; r < textures.size(); r++) textures[r].allocation = assignment[r];
+	}
+
+	int resolvedWidth(const RenderTextureDesc& desc) const {
+		return desc.isWindowRelative() ? std::max(1, (int)(windowWidth * desc.scale)) : desc.width;
+	}
+	int resolvedHeight(const RenderTextureDesc& desc) const {
+		return desc.isWindowRelative() ? std::max(1, (int)(windowHeight * desc.scale)) : desc.height;
+	}
+	size_t allocationBytes(const RenderTextureDesc& desc) const {
+		return textureStorageBytes(resolvedWidth(desc), resolvedHeight(desc), 1, 1, desc.format);
+	}
+
+	void createTexture(Allocation& allocation) {
+		allocation.texture.reset(new Texture2D(resolvedWidth(allocation.desc), resolvedHeight(allocation.desc), 1,
+			allocation.desc.format, "render graph"));
+		glBindTexture(GL_TEXTURE_2D, allocation.texture->ID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	static bool isDepthFormat(GLenum format) {
+		return format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F || format == GL_DEPTH24_STENCIL8;
+	}
+
+	void createFramebuffer(PassNode& pass) {
+		std::vector<GLenum> drawBuffers;
+		for (Resource r : pass.writes) {
+			const TextureNode& node = textures[r];
+			if (node.imported) continue;
+			if (pass.framebuffer == 0) {
+				glGenFramebuffers(1, &pass.framebuffer);
+				glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+				pass.width = resolvedWidth(node.desc);
+				pass.height = resolvedHeight(node.desc);
+			}
+			GLenum attachment = GL_COLOR_ATTACHMENT0 + (GLenum)drawBuffers.size();
+			if (node.desc.format == GL_DEPTH24_STENCIL8) attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+			else if (isDepthFormat(node.desc.format)) attachment = GL_DEPTH_ATTACHMENT;
+			else drawBuffers.push_back(attachment);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, textureID(r), 0);
+		}
+		if (pass.framebuffer == 0) return;
+		if (drawBuffers.empty()) glDrawBuffer(GL_NONE);
+		else glDrawBuffers((GLsizei)drawBuffers.size(), drawBuffers.data());
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+			std::cout << "ERROR::RENDER_GRAPH::FRAMEBUFFER_NOT_COMPLETE " << pass.name << std::endl;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void releaseFramebuffers() {
+		for (PassNode& pass : passes) {
+			if (pass.framebuffer != 0) glDeleteFramebuffers(1, &pass.framebuffer);
+			pass.framebuffer = 0;
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,105 @@
+//plays back a GL command stream recorded with FirstGLFWProject --gl-capture, in a hidden
+//window and as fast as the driver goes. the app's own CPU work is gone from the timings, so
+//they compare drivers, for instance two Mesa versions on the same capture
+//	FirstGLFWReplay frames.glcap --loops 20 --json mesa-new.json --baseline mesa-old.json
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+
+#include "GLReplay.h"
+#include "Benchmark.h"
+
+
+int main(int argc, char** argv) {
+	std::string capturePath;
+	int loops = 10;
+	std::string jsonPath;
+	std::string baselinePath;
+	double tolerance = 0.10;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--loops" && hasValue) loops = std::max(1, atoi(argv[++i]));
+		else if (arg == "--json" && hasValue) jsonPath = argv[++i];
+		else if (arg == "--baseline" && hasValue) baselinePath = argv[++i];
+		else if (arg == "--tolerance" && hasValue) tolerance = atof(argv[++i]) / 100.0;
+		else if (capturePath.empty() && arg[0] != '-') capturePath = arg;
+		else {
+			capturePath.clear();
+			break;
+		}
+	}
+	if (capturePath.empty()) {
+		std::cout << "usage: FirstGLFWReplay <capture.glcap> [--loops n] [--json out.json] [--baseline old.json]"
+			" [--tolerance percent]" << std::endl;
+		return 1;
+	}
+
+	GLReplay replay;
+	if (!replay.load(capturePath) || replay.frameCount() == 0) return 1;
+
+	//a context of the captured version, entry points it lacks are skipped and counted
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, std::max(3, replay.glMajor));
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, replay.glMajor > 3 ? replay.glMinor : std::max(3, replay.glMinor));
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	glfwWindowHint(GLFW_DEPTH_BITS, 24);
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+	GLFWwindow* window = glfwCreateWindow(std::max(1, replay.width), std::max(1, replay.height), "GL replay", NULL, NULL);
+	if (window == NULL) {
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+		std::cout << "Failed to initialize GLAD" << std::endl;
+		return -1;
+	}
+	std::cout << "GL_REPLAY renderer " << glGetString(GL_RENDERER) << ", " << glGetString(GL_VERSION) << std::endl;
+
+	//setup creates every object the frames use, it runs once and is timed on its own
+	std::vector<BenchmarkResult> results;
+	std::string name = capturePath.substr(capturePath.find_last_of("/\\") + 1);
+	results.push_back(runBenchmark("replay " + name + " setup", 0, 1, [&]() {
+		replay.replayFrame(0);
+		glFinish();
+	}));
+	results.back().report();
+
+	size_t frames = replay.frameCount() - 1;
+	if (frames > 0) {
+		//glFinish per frame keeps one frame's work from overlapping the next one's timing
+		results.push_back(runBenchmark("replay " + name + " frames", 1, loops, [&]() {
+			for (size_t frame = 1; frame <= frames; frame++) {
+				replay.replayFrame(frame);
+				glFinish();
+			}
+		}, (double)frames));
+		results.back().report();
+	}
+	if (replay.skipped > 0) {
+		std::cout << "GL_REPLAY " << replay.skipped << " calls skipped, this context lacks their entry points" << std::endl;
+	}
+	if (replay.unsafe > 0) {
+		std::cout << "GL_REPLAY " << replay.unsafe << " calls skipped, they pass pointers of entry points without an argument spec" << std::endl;
+	}
+	glfwTerminate();
+
+	if (!jsonPath.empty() && !writeBenchmarkJson(jsonPath, results)) return 1;
+	if (!baselinePath.empty()) {
+		std::map<std::string, double> baseline = readBenchmarkBaseline(baselinePath);
+		if (baseline.empty()) return 1;
+		int regressions = compareWithBaseline(results, baseline, tolerance);
+		std::cout << "BASELINE " << regressions << " regressions over " << tolerance * 100.0 << "%" << std::endl;
+		return regressions > 0 ? 2 : 0;
+	}
+	return 0;
+}
@@ -0,0 +1,198 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <cassert>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include "VectorMath.h"
+
+
+//transform hierarchy kept as parallel arrays indexed by node. nodes are stored so that every
+//parent comes before its children, which lets updateWorld resolve the whole hierarchy in one
+//forward pass with no recursion. only nodes that are dirty, or below a dirty node, are recomputed
+class Scene {
+public:
+	static constexpr int32_t NO_PARENT = -1;
+
+	//local transform
+	std::vector<Vec3> positions;
+	std::vector<Quat> rotations;
+	std::vector<Vec3> scales;
+	std::vector<int32_t> parents;
+	//results of updateWorld
+	std::vector<Mat4> worlds;
+	//bounding sphere in node space
+	std::vector<Vec3> localCenters;
+	std::vector<float> localRadii;
+	//world space bounding spheres as separate arrays so culling can load 4 or 8 at once
+	std::vector<float> boundsX, boundsY, boundsZ, boundsRadius;
+	//set by updateWorld for every node whose world transform changed this update
+	std::vector<uint8_t> changed;
+
+	size_t size() const { return parents.size(); }
+
+	void reserve(size_t count) {
+		positions.reserve(count); rotations.reserve(count); scales.reserve(count); parents.reserve(count);
+		worlds.reserve(count); localCenters.reserve(count); localRadii.reserve(count);
+		boundsX.reserve(count); boundsY.reserve(count); boundsZ.reserve(count); boundsRadius.reserve(count);
+		dirty.reserve(count); changed.reserve(count);
+	}
+
+	//appends a node, the parent must already exist so ordering holds by construction
+	int32_t addNode(int32_t parent, const Vec3& position = Vec3(), const Quat& rotation = Quat(),
+		const Vec3& scale = Vec3(1, 1, 1), const Vec3& boundsCenter = Vec3(), float radius = 1.0f) {
+		int32_t index = (int32_t)parents.size();
+		if (parent >= index) {
+			std::cout << "ERROR::SCENE::PARENT_MUST_PRECEDE_CHILD" << std::endl;
+			parent = NO_PARENT;
+		}
+		positions.push_back(position);
+		rotations.push_back(rotation);
+		scales.push_back(scale);
+		parents.push_back(parent);
+		worlds.push_back(Mat4::identity());
+		localCenters.push_back(boundsCenter);
+		localRadii.push_back(radius);
+		boundsX.push_back(0.0f);
+		boundsY.push_back(0.0f);
+		boundsZ.push_back(0.0f);
+		boundsRadius.push_back(0.0f);
+		dirty.push_back(1);
+		changed.push_back(0);
+		return index;
+	}
+
+	void setLocal(int32_t node, const Vec3& position, const Quat& rotation, const Vec3& scale) {
+		positions[node] = position;
+		rotations[node] = rotation;
+		scales[node] = scale;
+		dirty[node] = 1;
+	}
+	void setPosition(int32_t node, const Vec3& position) {
+		positions[node] = position;
+		dirty[node] = 1;
+	}
+
+	//reparenting may break parent-before-child order, then sorted() turns false and the caller
+	//must run sortHierarchy and move any node indices it holds through the returned remap before
+	//the next update. a parent that is the node itself or one of its descendants would make a
+	//cycle, which no order can put parents first in, so it is rejected and false returned
+	bool setParent(int32_t node, int32_t parent) {
+		for (int32_t ancestor = parent; ancestor != NO_PARENT; ancestor = parents[ancestor]) {
+			if (ancestor == node) {
+				std::cout << "ERROR::SCENE::PARENT_CYCLE " << node << " under " << parent << std::endl;
+				return false;
+			}
+		}
+		parents[node] = parent;
+		dirty[node] = 1;
+		if (parent > node) needsSort = true;
+		return true;
+	}
+
+	//false after a reparent put a child before its parent, until sortHierarchy runs
+	bool sorted() const { return !needsSort; }
+
+	//one forward pass: a node is recomputed when it is dirty itself or its parent changed. never
+	//sorts on its own, that would move nodes under callers still holding their old indices
+	void updateWorld() {
+		assert(!needsSort);
+		if (needsSort) {
+			std::cout << "ERROR::SCENE::UPDATE_BEFORE_SORT" << std::endl;
+			return;
+		}
+		const size_t count = parents.size();
+		for (size_t i = 0; i < count; i++) {
+			int32_t parent = parents[i];
+			uint8_t update = dirty[i] | (parent != NO_PARENT ? changed[parent] : 0);
+			changed[i] = update;
+			if (!update) continue;
+			dirty[i] = 0;
+
+			Mat4 local = Mat4::trs(positions[i], rotations[i], scales[i]);
+			if (parent == NO_PARENT) worlds[i] = local;
+			else multiplyInto(worlds[parent], local, worlds[i]);
+
+			//sphere radius scales by the largest axis scale of the world matrix
+			const Mat4& w = worlds[i];
+			Vec3 c = w.transformPoint(localCenters[i]);
+			float sx = w.m[0] * w.m[0] + w.m[1] * w.m[1] + w.m[2] * w.m[2];
+			float sy = w.m[4] * w.m[4] + w.m[5] * w.m[5] + w.m[6] * w.m[6];
+			float sz = w.m[8] * w.m[8] + w.m[9] * w.m[9] + w.m[10] * w.m[10];
+			boundsX[i] = c.x;
+			boundsY[i] = c.y;
+			boundsZ[i] = c.z;
+			boundsRadius[i] = localRadii[i] * std::sqrt(std::max(sx, std::max(sy, sz)));
+		}
+	}
+
+	//reorders every array depth first so parents precede children again, returns old index -> new index
+	std::vector<int32_t> sortHierarchy() {
+		const int32_t count = (int32_t)parents.size();
+		std::vector<int32_t> firstChild(count, NO_PARENT), nextSibling(count, NO_PARENT);
+		std::vector<int32_t> roots;
+		for (int32_t i = count - 1; i >= 0; i--) {
+			if (parents[i] == NO_PARENT) roots.push_back(i);
+			else {
+				nextSibling[i] = firstChild[parents[i]];
+				firstChild[parents[i]] = i;
+			}
+		}
+		std::vector<int32_t> order;
+		order.reserve(count);
+		std::vector<int32_t> stack(roots.begin(), roots.end());
+		while (!stack.empty()) {
+			int32_t node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+			for (int32_t child = firstChild[node]; child != NO_PARENT; child = nextSibling[child]) {
+				stack.push_back(child);
+			}
+		}
+		//setParent keeps the hierarchy acyclic, so the walk from the roots reaches every node
+		assert(order.size() == (size_t)count);
+		std::vector<int32_t> remap(count);
+		for (int32_t i = 0; i < (int32_t)order.size(); i++) remap[order[i]] = i;
+
+		permute(positions, order);
+		permute(rotations, order);
+		permute(scales, order);
+		permute(worlds, order);
+		permute(localCenters, order);
+		permute(localRadii, order);
+		permute(boundsX, order);
+		permute(boundsY, order);
+		permute(boundsZ, order);
+		permute(boundsRadius, order);
+		permute(changed, order);
+		std::vector<int32_t> newParents(order.size());
+		for (size_t i = 0; i < order.size(); i++) {
+			int32_t parent = parents[order[i]];
+			newParents[i] = parent == NO_PARENT ? NO_PARENT : remap[parent];
+		}
+		parents.swap(newParents);
+		//every world matrix is rebuilt after a reorder
+		dirty.assign(order.size(), 1);
+		needsSort = false;
+		return remap;
+	}
+
+private:
+	std::vector<uint8_t> dirty;
+	bool needsSort = false;
+
+	template<typename T>
+	static void permute(std::vector<T>& values, const std::vector<int32_t>& order) {
+		std::vector<T> sorted;
+		sorted.reserve(order.size());
+		for (int32_t i : order) sorted.push_back(values[i]);
+		values.swap(sorted);
+	}
+};
+
+#endif
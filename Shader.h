@@ -7,42 +7,92 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <cstring>
+#include <mutex>
+#include <future>
+#include <unordered_map>
+
+#include "VectorMath.h"
+#include "Trace.h"
+#include "Startup.h"
+#include "EmbeddedShaders.h"
+#include "GpuMemory.h"
+
+
+//where Shader gets its sources, before falling back to reading the path itself:
+//  1. the file under overrideDirectory (--shader-dir), so shaders can be edited without a rebuild
+//  2. a copy compiled into the executable by EmbedShaders.ps1, no file I/O and no dependency
+//     on the working directory
+//override files can be read ahead on worker threads, before there is a context to compile in
+namespace ShaderSources {
+	inline std::string overrideDirectory;
+	inline std::mutex mutex;
+	inline std::unordered_map<std::string, std::shared_future<std::string>> pending;
+
+	//empty when the file cannot be read
+	inline std::string readFile(const std::string& path) {
+		std::ifstream file(path);
+		std::stringstream stream;
+		stream << file.rdbuf();
+		return file ? stream.str() : std::string();
+	}
+
+	inline std::string overridePath(const std::string& path) {
+		return overrideDirectory + "/" + path;
+	}
+
+	inline const char* embedded(const char* path) {
+		for (const EmbeddedShader& shader : embeddedShaders) {
+			if (std::strcmp(shader.path, path) == 0) return shader.source;
+		}
+		return NULL;
+	}
+
+	inline void preload(const std::string& path) {
+		if (overrideDirectory.empty()) return;
+		std::lock_guard<std::mutex> lock(mutex);
+		if (pending.count(path) > 0) return;
+		pending[path] = std::async(std::launch::async, [path]() {
+			Startup::Phase phase("read " + path, true);
+			return readFile(overridePath(path));
+		}).share();
+	}
+
+	//waits for a read ahead when it is still running, which is only taken once
+	inline bool take(const char* path, std::string& code) {
+		std::shared_future<std::string> source;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto found = pending.find(path);
+			if (found != pending.end()) {
+				source = found->second;
+				pending.erase(found);
+			}
+		}
+		if (source.valid()) code = source.get();
+		else if (!overrideDirectory.empty()) code = readFile(overridePath(path));
+		if (!code.empty()) return true;
+
+		const char* compiled = embedded(path);
+		if (compiled == NULL) return false;
+		code = compiled;
+		return true;
+	}
+}
 
 
 class Shader {
 public:
 	//program ID
-	unsigned int ID;
+	unsigned int ID = 0;
 
 	//reads and builds shader
 	Shader(const char* vertexPath, const char* fragmentPath)
 	{
+		TRACE_SCOPE("shader build");
 		//1. retrive vertex/fragment source code from respective file path
-		std::string vertexCode;
-		std::string fragmentCode;
-		std::ifstream vShaderFile;
-		std::ifstream fShaderFile;
-		//ifstream objects can throw exceptions:
-		vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-		fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-		try {
-			//open files
-			vShaderFile.open(vertexPath);
-			fShaderFile.open(fragmentPath);
-			std::stringstream vShaderStream, fShaderStream;
-			//read file's buffer contents into streams
-			vShaderStream << vShaderFile.rdbuf();
-			fShaderStream << fShaderFile.rdbuf();
-			//close file handlers
-			vShaderFile.close();
-			fShaderFile.close();
-			//convert stream into string
-			vertexCode = vShaderStream.str();
-			fragmentCode = fShaderStream.str();
-		}
-		catch (std::ifstream::failure e) {
-			std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << std::endl;
-		}
+		std::string vertexCode = readSource(vertexPath);
+		std::string fragmentCode = readSource(fragmentPath);
 		const char* vShaderCode = vertexCode.c_str();
 		const char* fShaderCode = fragmentCode.c_str();
 
@@ -88,20 +138,106 @@ public:
 		//Delete shaders
 		glDeleteShader(vertex);
 		glDeleteShader(fragment);
+		GpuMemory::track(GpuMemory::PROGRAM, ID, 0, fragmentPath);
+	}
+	//reads and builds a compute shader
+	Shader(const char* computePath)
+	{
+		TRACE_SCOPE("compute shader build");
+		//1. retrive compute source code from file path
+		std::string computeCode = readSource(computePath);
+		const char* cShaderCode = computeCode.c_str();
+
+		//2. compile shader
+		unsigned int compute;
+		int success;
+		char infoLog[512];
+
+		compute = glCreateShader(GL_COMPUTE_SHADER);
+		glShaderSource(compute, 1, &cShaderCode, NULL);
+		glCompileShader(compute);
+		glGetShaderiv(compute, GL_COMPILE_STATUS, &success);
+		if (!success) {
+			glGetShaderInfoLog(compute, 512, NULL, infoLog);
+			std::cout << "ERROR::SHADER::COMPUTE::COMPILATION_FAILED\n" << infoLog << std::endl;
+		}
+
+		//Link program
+		ID = glCreateProgram();
+		glAttachShader(ID, compute);
+		glLinkProgram(ID);
+		glGetProgramiv(ID, GL_LINK_STATUS, &success);
+		if (!success) {
+			glGetProgramInfoLog(ID, 512, NULL, infoLog);
+			std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+		}
+
+		glDeleteShader(compute);
+		GpuMemory::track(GpuMemory::PROGRAM, ID, 0, computePath);
+	}
+	~Shader() {
+		GpuMemory::destroy(GpuMemory::PROGRAM, ID);
+	}
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+	Shader(Shader&& other) noexcept : ID(other.ID) {
+		other.ID = 0;
 	}
 	//use/activate the shader
 	void use() {
 		glUseProgram(ID);
 	}
-	//utility uniform functions
-	void setBool(const std::string& name, bool value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+	//utility uniform functions. string literals take the const char* versions, so no
+	//std::string is built per call
+	void setBool(const char* name, bool value) const {
+		glUniform1i(glGetUniformLocation(ID, name), (int)value);
+	}
+	void setInt(const char* name, int value) const {
+		glUniform1i(glGetUniformLocation(ID, name), value);
+	}
+	void setFloat(const char* name, float value) const {
+		glUniform1f(glGetUniformLocation(ID, name), value);
+	}
+	void setVec3(const char* name, const Vec3& value) const {
+		glUniform3f(glGetUniformLocation(ID, name), value.x, value.y, value.z);
+	}
+	void setVec3(const char* name, float x, float y, float z) const {
+		glUniform3f(glGetUniformLocation(ID, name), x, y, z);
 	}
-	void setInt(const std::string &name, int value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+	void setVec4(const char* name, const Vec4& value) const {
+		glUniform4f(glGetUniformLocation(ID, name), value.x, value.y, value.z, value.w);
 	}
-	void setFloat(const std::string &name, float value) const {
-		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+	//Mat4 is column major so no transpose is needed
+	void setMat4(const char* name, const Mat4& mat) const {
+		glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, mat.m);
+	}
+	void setBool(const std::string& name, bool value) const { setBool(name.c_str(), value); }
+	void setInt(const std::string &name, int value) const { setInt(name.c_str(), value); }
+	void setFloat(const std::string &name, float value) const { setFloat(name.c_str(), value); }
+	void setVec3(const std::string &name, const Vec3& value) const { setVec3(name.c_str(), value); }
+	void setVec3(const std::string &name, float x, float y, float z) const { setVec3(name.c_str(), x, y, z); }
+	void setVec4(const std::string &name, const Vec4& value) const { setVec4(name.c_str(), value); }
+	void setMat4(const std::string &name, const Mat4& mat) const { setMat4(name.c_str(), mat); }
+
+private:
+	//the source from ShaderSources, or read from the path itself when it has none
+	static std::string readSource(const char* path) {
+		std::string code;
+		if (ShaderSources::take(path, code)) return code;
+		std::ifstream file;
+		//ifstream objects can throw exceptions:
+		file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+		try {
+			file.open(path);
+			std::stringstream stream;
+			stream << file.rdbuf();
+			file.close();
+			code = stream.str();
+		}
+		catch (const std::ifstream::failure&) {
+			std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ " << path << std::endl;
+		}
+		return code;
 	}
 };
 
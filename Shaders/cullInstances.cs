@@ -0,0 +1,50 @@
+#version 430 core
+
+layout(local_size_x = 64) in;
+
+//matches DrawArraysIndirectCommand in GpuCulling.h
+struct DrawArraysIndirectCommand {
+	uint count;
+	uint instanceCount;
+	uint first;
+	uint baseInstance;
+};
+
+//world space bounding sphere per instance: xyz center, w radius
+layout(std430, binding = 0) readonly buffer Bounds {
+	vec4 bounds[];
+};
+//per instance mesh range: x first vertex, y vertex count
+layout(std430, binding = 1) readonly buffer InstanceMeshes {
+	uvec2 instanceMeshes[];
+};
+layout(std430, binding = 2) writeonly buffer Commands {
+	DrawArraysIndirectCommand commands[];
+};
+//compacted list of surviving instance indices, read back by the vertex shader through baseInstance
+layout(std430, binding = 3) writeonly buffer VisibleInstances {
+	uint visibleInstances[];
+};
+
+layout(binding = 0) uniform atomic_uint drawCount;
+
+uniform vec4 planes[6];
+uniform uint instanceCount;
+
+void main()
+{
+	uint instance = gl_GlobalInvocationID.x;
+	if (instance >= instanceCount) {
+		return;
+	}
+	vec4 sphere = bounds[instance];
+	for (int i = 0; i < 6; i++) {
+		if (dot(planes[i].xyz, sphere.xyz) + planes[i].w < -sphere.w) {
+			return;
+		}
+	}
+	uint slot = atomicCounterIncrement(drawCount);
+	uvec2 mesh = instanceMeshes[instance];
+	commands[slot] = DrawArraysIndirectCommand(mesh.y, 1u, mesh.x, slot);
+	visibleInstances[slot] = instance;
+}
@@ -0,0 +1,20 @@
+#version 430 core
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aColor;
+//instanced attribute over the compacted visible list, baseInstance selects this draw's entry
+layout(location = 2) in uint instanceIndex;
+
+layout(std430, binding = 0) readonly buffer Bounds {
+	vec4 bounds[];
+};
+
+uniform mat4 viewProjection;
+
+out vec3 ourColor;
+
+void main()
+{
+	gl_Position = viewProjection * vec4(aPos + bounds[instanceIndex].xyz, 1.0);
+	ourColor = aColor;
+}
@@ -0,0 +1,48 @@
+#version 430 core
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+//level 0 is built from the depth texture, every later level from the level above it
+uniform sampler2D depth;
+layout(r32f, binding = 0) readonly uniform image2D source;
+layout(r32f, binding = 1) writeonly uniform image2D destination;
+
+uniform bool fromDepth;
+//reversed-Z keeps the farthest depth as the minimum instead of the maximum
+uniform bool reversedZ;
+uniform ivec2 depthSize;
+uniform ivec2 destinationSize;
+
+float farther(float a, float b)
+{
+	return reversedZ ? min(a, b) : max(a, b);
+}
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(texel, destinationSize))) {
+		return;
+	}
+	float farthest = reversedZ ? 1.0 : 0.0;
+	if (fromDepth) {
+		//level 0 is a power of two no larger than the depth buffer, so one texel covers
+		//between 1 and 2 depth texels per axis and has to take the max over all it touches
+		vec2 ratio = vec2(depthSize) / vec2(destinationSize);
+		ivec2 first = ivec2(floor(vec2(texel) * ratio));
+		ivec2 last = min(ivec2(ceil(vec2(texel + 1) * ratio)) - 1, depthSize - 1);
+		for (int y = first.y; y <= last.y; y++) {
+			for (int x = first.x; x <= last.x; x++) {
+				farthest = farther(farthest, texelFetch(depth, ivec2(x, y), 0).r);
+			}
+		}
+	}
+	else {
+		//a 1 texel wide level would read past its edge, clamp rather than rely on out of range loads
+		ivec2 base = texel * 2;
+		ivec2 edge = min(base + 1, imageSize(source) - 1);
+		farthest = farther(farther(imageLoad(source, base).r, imageLoad(source, ivec2(edge.x, base.y)).r),
+			farther(imageLoad(source, ivec2(base.x, edge.y)).r, imageLoad(source, edge).r));
+	}
+	imageStore(destination, texel, vec4(farthest));
+}
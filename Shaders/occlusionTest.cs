@@ -0,0 +1,69 @@
+#version 430 core
+
+layout(local_size_x = 64) in;
+
+//world space bounding sphere per object: xyz center, w radius
+layout(std430, binding = 0) readonly buffer Bounds {
+	vec4 bounds[];
+};
+//1 when the object may be visible, 0 when the pyramid proves it is hidden
+layout(std430, binding = 1) writeonly buffer Visibility {
+	uint visibility[];
+};
+
+uniform sampler2D hiZ;
+uniform mat4 viewProjection;
+uniform ivec2 hiZSize;
+uniform int hiZLevels;
+uniform uint objectCount;
+//reversed-Z: clip depth is already 0 to 1, nearer is larger, the pyramid holds minimums
+uniform bool reversedZ;
+
+void main()
+{
+	uint object = gl_GlobalInvocationID.x;
+	if (object >= objectCount) {
+		return;
+	}
+	vec4 sphere = bounds[object];
+
+	//screen rectangle and nearest depth of the sphere's bounding box
+	vec3 minimum = vec3(1.0);
+	vec3 maximum = vec3(0.0);
+	float nearest = reversedZ ? 0.0 : 1.0;
+	for (int i = 0; i < 8; i++) {
+		vec3 corner = sphere.xyz + sphere.w * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+		vec4 clip = viewProjection * vec4(corner, 1.0);
+		//crossing the near plane, the projection is unbounded so keep the object
+		if (clip.w <= 0.0) {
+			visibility[object] = 1u;
+			return;
+		}
+		vec3 window = clip.xyz / clip.w * 0.5 + 0.5;
+		float depth = reversedZ ? clip.z / clip.w : window.z;
+		nearest = reversedZ ? max(nearest, depth) : min(nearest, depth);
+		minimum = min(minimum, window);
+		maximum = max(maximum, window);
+	}
+	minimum.xy = clamp(minimum.xy, 0.0, 1.0);
+	maximum.xy = clamp(maximum.xy, 0.0, 1.0);
+
+	//coarsest level where the rectangle spans at most 2x2 texels
+	vec2 extent = (maximum.xy - minimum.xy) * vec2(hiZSize);
+	int level = int(ceil(log2(max(max(extent.x, extent.y), 1.0))));
+	level = clamp(level, 0, hiZLevels - 1);
+	ivec2 levelSize = max(hiZSize >> level, ivec2(1));
+	ivec2 first = min(ivec2(minimum.xy * vec2(levelSize)), levelSize - 1);
+	ivec2 last = min(ivec2(maximum.xy * vec2(levelSize)), levelSize - 1);
+
+	vec4 texels = vec4(texelFetch(hiZ, first, level).r, texelFetch(hiZ, ivec2(last.x, first.y), level).r,
+		texelFetch(hiZ, ivec2(first.x, last.y), level).r, texelFetch(hiZ, last, level).r);
+	bool hidden;
+	if (reversedZ) {
+		hidden = nearest < min(min(texels.x, texels.y), min(texels.z, texels.w));
+	}
+	else {
+		hidden = nearest > max(max(texels.x, texels.y), max(texels.z, texels.w));
+	}
+	visibility[object] = hidden ? 0u : 1u;
+}
@@ -0,0 +1,24 @@
+#version 430 core
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aColor;
+//instanced attribute over 0, 1, 2..., baseInstance makes it this draw's index
+layout(location = 2) in uint drawIndex;
+//atlas coordinates, the layer in z
+layout(location = 3) in vec3 aTexCoord;
+
+layout(std430, binding = 0) readonly buffer Models {
+	mat4 models[];
+};
+
+uniform mat4 viewProjection;
+
+out vec3 ourColor;
+out vec3 texCoord;
+
+void main()
+{
+	gl_Position = viewProjection * models[drawIndex] * vec4(aPos, 1.0);
+	ourColor = aColor;
+	texCoord = aTexCoord;
+}
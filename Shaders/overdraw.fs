@@ -0,0 +1,14 @@
+#version 330 core
+
+//every fragment that survives the depth test adds one step, blended additively so the
+//red channel ends up holding how many times each pixel was shaded. a step of 1/255 makes it
+//an exact count for readback, a larger one a heat map that is visible on screen
+out vec4 FragColor;
+
+uniform float layerStep = 1.0 / 255.0;
+
+in vec3 ourColor;
+void main()
+{
+    FragColor = vec4(layerStep, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+//the vertex color tinted by the face's image in the texture atlas
+out vec4 FragColor;
+
+uniform sampler2DArray atlas;
+
+in vec3 ourColor;
+in vec3 texCoord;
+void main()
+{
+    FragColor = vec4(ourColor, 1.0) * texture(atlas, texCoord);
+}
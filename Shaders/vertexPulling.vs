@@ -0,0 +1,42 @@
+#version 430 core
+
+//one interleaved vertex, matches PulledVertex in VertexPulling.h
+struct Vertex {
+	vec4 position;
+	vec4 color;
+};
+
+layout(std430, binding = 0) readonly buffer Vertices {
+	Vertex vertices[];
+};
+//per object translation
+layout(std430, binding = 1) readonly buffer Objects {
+	vec4 objectOffsets[];
+};
+//per drawn triangle: first vertex of the triangle's mesh triangle, object index
+layout(std430, binding = 2) readonly buffer Triangles {
+	uvec2 triangles[];
+};
+
+//instanced mode draws one mesh starting at firstVertex once per object
+uniform bool instanced;
+uniform int firstVertex;
+
+out vec3 ourColor;
+
+void main()
+{
+	Vertex v;
+	uint object;
+	if (instanced) {
+		v = vertices[firstVertex + gl_VertexID];
+		object = uint(gl_InstanceID);
+	}
+	else {
+		uvec2 triangle = triangles[gl_VertexID / 3];
+		v = vertices[triangle.x + uint(gl_VertexID % 3)];
+		object = triangle.y;
+	}
+	gl_Position = vec4(v.position.xyz + objectOffsets[object].xyz, 1.0);
+	ourColor = v.color.rgb;
+}
@@ -2,11 +2,17 @@
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aColor;
+//atlas coordinates, the layer in z
+layout(location = 3) in vec3 aTexCoord;
 
 out vec3 ourColor;
+out vec3 texCoord;
+
+uniform mat4 transform;
 
 void main()
 {
-	gl_Position = vec4(aPos, 1.0);
+	gl_Position = transform * vec4(aPos, 1.0);
 	ourColor=aColor;
+	texCoord = aTexCoord;
 };
\ No newline at end of file
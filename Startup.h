@@ -0,0 +1,121 @@
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+
+//where cold start goes, from static initialisation to the first presented frame. phases are
+//scoped, may run on other threads and may overlap: reading shader files runs while the
+//window and context are created. firstFrame() prints the phases once, in start order
+namespace Startup {
+
+	//initialised before main, the closest portable stand-in for process start
+	inline const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+	struct Record {
+		std::string name;
+		double startMs;
+		double endMs;
+		bool background;
+	};
+
+	inline std::mutex mutex;
+	inline std::vector<Record> records;
+	inline bool reported = false;
+
+	inline double sinceStart() {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - processStart).count();
+	}
+
+	//times from construction to end() or destruction, background phases are off the main thread
+	class Phase {
+	public:
+		explicit Phase(const std::string& name, bool background = false)
+			: name(name), background(background), startMs(sinceStart()) {}
+		~Phase() {
+			end();
+		}
+		Phase(const Phase&) = delete;
+		Phase& operator=(const Phase&) = delete;
+
+		void end() {
+			if (ended) return;
+			ended = true;
+			double endMs = sinceStart();
+			std::lock_guard<std::mutex> lock(mutex);
+			records.push_back({ name, startMs, endMs, background });
+		}
+
+	private:
+		std::string name;
+		bool background;
+		double startMs;
+		bool ended = false;
+	};
+
+	typedef std::vector<std::pair<double, double>> Intervals;
+
+	//sorted, non overlapping cover of the given intervals
+	inline Intervals merge(Intervals intervals) {
+		std::sort(intervals.begin(), intervals.end());
+		Intervals merged;
+		for (const auto& interval : intervals) {
+			if (!merged.empty() && interval.first <= merged.back().second) {
+				merged.back().second = std::max(merged.back().second, interval.second);
+			}
+			else {
+				merged.push_back(interval);
+			}
+		}
+		return merged;
+	}
+
+	inline double length(const Intervals& intervals) {
+		double total = 0.0;
+		for (const auto& interval : intervals) total += interval.second - interval.first;
+		return total;
+	}
+
+	//time covered by both, each a result of merge()
+	inline double intersection(const Intervals& a, const Intervals& b) {
+		double total = 0.0;
+		size_t i = 0, j = 0;
+		while (i < a.size() && j < b.size()) {
+			total += std::max(0.0, std::min(a[i].second, b[j].second) - std::max(a[i].first, b[j].first));
+			if (a[i].second < b[j].second) i++;
+			else j++;
+		}
+		return total;
+	}
+
+	//call right after the first swap. background work only shortens startup where it runs while
+	//the main thread is inside a phase of its own, so the overlap is the time covered by both
+	inline void firstFrame() {
+		if (reported) return;
+		reported = true;
+		double total = sinceStart();
+		std::lock_guard<std::mutex> lock(mutex);
+		std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) { return a.startMs < b.startMs; });
+		Intervals mainThread, background;
+		std::cout << "STARTUP time to first frame " << total << " ms" << std::endl;
+		for (const Record& r : records) {
+			(r.background ? background : mainThread).push_back({ r.startMs, r.endMs });
+			std::cout << "  " << r.name << " " << r.endMs - r.startMs << " ms, at " << r.startMs << " ms";
+			if (r.background) std::cout << " (background)";
+			std::cout << std::endl;
+		}
+		mainThread = merge(mainThread);
+		background = merge(background);
+		std::cout << "  " << total - length(mainThread) << " ms outside the main thread's phases, " << length(background)
+			<< " ms on other threads, " << intersection(mainThread, background) << " ms of it overlapped with main thread phases"
+			<< std::endl;
+	}
+}
+
+#endif
@@ -0,0 +1,585 @@
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include "GpuMemory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_USE_SSE2 1
+#endif
+
+
+//bytes used by one texel of a sized internal format
+inline size_t bytesPerTexel(GLenum internalFormat) {
+	switch (internalFormat) {
+	case GL_R8:                 return 1;
+	case GL_RG8:                return 2;
+	case GL_R16F:               return 2;
+	case GL_RGB8:               return 3;
+	case GL_RGBA8:              return 4;
+	case GL_SRGB8_ALPHA8:       return 4;
+	case GL_R32F:               return 4;
+	case GL_RG16F:              return 4;
+	case GL_R11F_G11F_B10F:     return 4;
+	case GL_DEPTH_COMPONENT24:  return 4;
+	case GL_DEPTH24_STENCIL8:   return 4;
+	case GL_DEPTH_COMPONENT32F: return 4;
+	case GL_RGBA16F:            return 8;
+	case GL_RG32F:              return 8;
+	case GL_RGBA32F:            return 16;
+	default:                    return 4;
+	}
+}
+
+//number of levels in a full mip chain down to 1x1
+inline int mipLevelCount(int width, int height) {
+	int levels = 1;
+	while (width > 1 || height > 1) {
+		width = std::max(1, width / 2);
+		height = std::max(1, height / 2);
+		levels++;
+	}
+	return levels;
+}
+
+//bytes needed for a texture with the given dimensions and level count
+inline size_t textureStorageBytes(int width, int height, int layers, int levels, GLenum internalFormat) {
+	size_t total = 0;
+	for (int level = 0; level < levels; level++) {
+		total += (size_t)width * height * layers * bytesPerTexel(internalFormat);
+		width = std::max(1, width / 2);
+		height = std::max(1, height / 2);
+	}
+	return total;
+}
+
+//one level of a CPU side RGBA8 mip chain
+struct MipLevel {
+	int width;
+	int height;
+	std::vector<uint8_t> pixels;
+};
+
+//scalar 2x2 box filter, clamps at the edges so odd sizes and 1xN levels work
+inline void downsampleRGBA8Scalar(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH) {
+	for (int y = 0; y < dstH; y++) {
+		int y0 = std::min(y * 2, srcH - 1);
+		int y1 = std::min(y * 2 + 1, srcH - 1);
+		for (int x = 0; x < dstW; x++) {
+			int x0 = std::min(x * 2, srcW - 1);
+			int x1 = std::min(x * 2 + 1, srcW - 1);
+			for (int c = 0; c < 4; c++) {
+				int sum = src[(y0 * srcW + x0) * 4 + c] + src[(y0 * srcW + x1) * 4 + c]
+					+ src[(y1 * srcW + x0) * 4 + c] + src[(y1 * srcW + x1) * 4 + c];
+				dst[(y * dstW + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+//2x2 box filter of one RGBA8 level into the next, 4 output pixels per iteration with SSE2.
+//sums are taken in 16 bit lanes and rounded as (sum + 2) / 4, so both paths give the same mips
+inline void downsampleRGBA8(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH) {
+#ifdef TEXTURE_USE_SSE2
+	//the vector path needs two full source rows and two source pixels per output pixel
+	if (srcW >= 2 && srcH >= 2) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i two = _mm_set1_epi16(2);
+		for (int y = 0; y < dstH; y++) {
+			const uint8_t* row0 = src + (size_t)(y * 2) * srcW * 4;
+			const uint8_t* row1 = row0 + (size_t)srcW * 4;
+			uint8_t* out = dst + (size_t)y * dstW * 4;
+			int x = 0;
+			for (; x + 4 <= dstW; x += 4) {
+				//each half is 4 source pixels per row and becomes 2 output pixels
+				__m128i halves[2];
+				for (int h = 0; h < 2; h++) {
+					__m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8 + h * 16));
+					__m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8 + h * 16));
+					//vertical sums of pixels 0,1 and 2,3
+					__m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+					__m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+					//horizontal sums land in the low 4 lanes of each
+					low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+					high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+					halves[h] = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), two), 2);
+				}
+				_mm_storeu_si128((__m128i*)(out + x * 4), _mm_packus_epi16(halves[0], halves[1]));
+			}
+			//leftover columns and the clamped edge of odd widths
+			for (; x < dstW; x++) {
+				int x0 = std::min(x * 2, srcW - 1);
+				int x1 = std::min(x * 2 + 1, srcW - 1);
+				for (int c = 0; c < 4; c++) {
+					int sum = row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] + row1[x1 * 4 + c];
+					out[x * 4 + c] = (uint8_t)((sum + 2) / 4);
+				}
+			}
+		}
+		return;
+	}
+#endif
+	downsampleRGBA8Scalar(src, srcW, srcH, dst, dstW, dstH);
+}
+
+//builds levels 1..n of an RGBA8 image on the CPU, level 0 is not copied
+inline std::vector<MipLevel> generateMipChainRGBA8(const uint8_t* pixels, int width, int height) {
+	std::vector<MipLevel> chain;
+	const uint8_t* src = pixels;
+	int srcW = width, srcH = height;
+	while (srcW > 1 || srcH > 1) {
+		MipLevel level;
+		level.width = std::max(1, srcW / 2);
+		level.height = std::max(1, srcH / 2);
+		level.pixels.resize((size_t)level.width * level.height * 4);
+		downsampleRGBA8(src, srcW, srcH, level.pixels.data(), level.width, level.height);
+		chain.push_back(std::move(level));
+		src = chain.back().pixels.data();
+		srcW = chain.back().width;
+		srcH = chain.back().height;
+	}
+	return chain;
+}
+
+//RGBA8 rectangle of one level of a 2D texture, or of one layer of a 2D array texture, from
+//pixels or from an offset into the bound pixel unpack buffer
+inline void texSubImageRGBA8(GLenum target, unsigned int texture, int level, int x, int y, int layer, int w, int h,
+	const void* pixels) {
+	glBindTexture(target, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	if (target == GL_TEXTURE_2D_ARRAY) {
+		glTexSubImage3D(target, level, x, y, layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
+	else {
+		glTexSubImage2D(target, level, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
+	//back to the GL default the rest of the code assumes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(target, 0);
+}
+
+class Texture2D {
+public:
+	//texture ID
+	unsigned int ID = 0;
+	int width = 0;
+	int height = 0;
+	int levels = 0;
+	GLenum internalFormat = GL_RGBA8;
+	//GPU memory held by all levels
+	size_t bytes = 0;
+
+	//allocates immutable storage, levels <= 0 means a full mip chain. tag groups the texture
+	//in GpuMemory's totals
+	Texture2D(int width, int height, int levels = 0, GLenum internalFormat = GL_RGBA8, const char* tag = "texture")
+		: width(width), height(height), internalFormat(internalFormat)
+	{
+		this->levels = levels > 0 ? levels : mipLevelCount(width, height);
+		glGenTextures(1, &ID);
+		glBindTexture(GL_TEXTURE_2D, ID);
+		if (glTexStorage2D) {
+			glTexStorage2D(GL_TEXTURE_2D, this->levels, internalFormat, width, height);
+		}
+		else {
+			//glTexStorage2D is 4.2, on older contexts specify every level up front instead
+			GLenum format = internalFormat == GL_DEPTH_COMPONENT32F || internalFormat == GL_DEPTH_COMPONENT24
+				? GL_DEPTH_COMPONENT : internalFormat == GL_DEPTH24_STENCIL8 ? GL_DEPTH_STENCIL : GL_RGBA;
+			GLenum type = internalFormat == GL_DEPTH_COMPONENT32F || internalFormat == GL_RGBA16F || internalFormat == GL_RGBA32F
+				? GL_FLOAT : internalFormat == GL_DEPTH24_STENCIL8 ? GL_UNSIGNED_INT_24_8 : GL_UNSIGNED_BYTE;
+			int w = width, h = height;
+			for (int level = 0; level < this->levels; level++) {
+				glTexImage2D(GL_TEXTURE_2D, level, internalFormat, w, h, 0, format, type, NULL);
+				w = std::max(1, w / 2);
+				h = std::max(1, h / 2);
+			}
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, this->levels - 1);
+		}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		bytes = textureStorageBytes(width, height, 1, this->levels, internalFormat);
+		GpuMemory::track(GpuMemory::TEXTURE, ID, bytes, tag);
+	}
+	~Texture2D() {
+		GpuMemory::destroy(GpuMemory::TEXTURE, ID);
+	}
+	Texture2D(const Texture2D&) = delete;
+	Texture2D& operator=(const Texture2D&) = delete;
+	Texture2D(Texture2D&& other) noexcept
+		: ID(other.ID), width(other.width), height(other.height), levels(other.levels),
+		internalFormat(other.internalFormat), bytes(other.bytes) {
+		other.ID = 0;
+	}
+
+	//bind to a texture unit, pair with Shader::setInt for the sampler
+	void bind(unsigned int unit) const {
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D, ID);
+	}
+	//synchronous upload of one RGBA8 level
+	void upload(int level, const void* pixels) {
+		texSubImageRGBA8(GL_TEXTURE_2D, ID, level, 0, 0, 0, levelWidth(level), levelHeight(level), pixels);
+	}
+	//let the driver build the mip chain from level 0
+	void generateMipmapsGPU() {
+		glBindTexture(GL_TEXTURE_2D, ID);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	int levelWidth(int level) const {
+		return std::max(1, width >> level);
+	}
+	int levelHeight(int level) const {
+		return std::max(1, height >> level);
+	}
+};
+
+
+//streams texture data through a ring of pixel unpack buffers so glTexSubImage2D
+//returns immediately and the copy happens on the GPU timeline
+class TextureUploader {
+public:
+	//upload statistics
+	size_t bytesUploaded = 0;
+	int asyncUploads = 0;
+	int directUploads = 0;
+	int stalls = 0;
+
+	TextureUploader(size_t slotBytes = 8 * 1024 * 1024, int slotCount = 3) : slotBytes(slotBytes) {
+		slots.resize(slotCount);
+		for (Slot& slot : slots) {
+			glGenBuffers(1, &slot.pbo);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, slotBytes, NULL, GL_STREAM_DRAW);
+			GpuMemory::track(GpuMemory::BUFFER, slot.pbo, slotBytes, "texture staging");
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	~TextureUploader() {
+		for (Slot& slot : slots) {
+			if (slot.fence) glDeleteSync(slot.fence);
+			GpuMemory::destroy(GpuMemory::BUFFER, slot.pbo);
+		}
+	}
+	TextureUploader(const TextureUploader&) = delete;
+	TextureUploader& operator=(const TextureUploader&) = delete;
+
+	//queue an RGBA8 upload of one level, the caller may free pixels as soon as this returns
+	void upload(Texture2D& texture, int level, const uint8_t* pixels) {
+		uploadRegion(GL_TEXTURE_2D, texture.ID, level, 0, 0, 0, texture.levelWidth(level), texture.levelHeight(level), pixels);
+	}
+	//queue an RGBA8 upload of a w x h rectangle into one layer of a 2D array texture
+	void uploadLayer(unsigned int arrayTexture, int x, int y, int layer, int w, int h, const uint8_t* pixels) {
+		uploadRegion(GL_TEXTURE_2D_ARRAY, arrayTexture, 0, x, y, layer, w, h, pixels);
+	}
+
+	//upload level 0 and fill the rest of the chain, on the CPU with SIMD or with glGenerateMipmap
+	void uploadWithMips(Texture2D& texture, const uint8_t* pixels, bool cpuMips) {
+		upload(texture, 0, pixels);
+		if (texture.levels <= 1) return;
+		if (!cpuMips) {
+			texture.generateMipmapsGPU();
+			return;
+		}
+		std::vector<MipLevel> chain = generateMipChainRGBA8(pixels, texture.width, texture.height);
+		for (int level = 1; level < texture.levels && level - 1 < (int)chain.size(); level++) {
+			upload(texture, level, chain[level - 1].pixels.data());
+		}
+	}
+
+	void report() const {
+		std::cout << "TEXTURE::UPLOADER " << bytesUploaded / 1024 << " KiB, " << asyncUploads << " async, "
+			<< directUploads << " direct, " << stalls << " stalls" << std::endl;
+	}
+
+private:
+	struct Slot {
+		unsigned int pbo = 0;
+		GLsync fence = 0;
+	};
+	std::vector<Slot> slots;
+	size_t slotBytes;
+	size_t next = 0;
+
+	void uploadRegion(GLenum target, unsigned int texture, int level, int x, int y, int layer, int w, int h,
+		const uint8_t* pixels) {
+		size_t size = (size_t)w * h * 4;
+		bytesUploaded += size;
+		if (size > slotBytes) {
+			//too big for a staging slot, go straight through the driver
+			texSubImageRGBA8(target, texture, level, x, y, layer, w, h, pixels);
+			directUploads++;
+			return;
+		}
+
+		Slot* acquired = acquireSlot();
+		if (acquired == NULL) {
+			//the slot may still be read by the GPU, the driver path synchronises itself
+			texSubImageRGBA8(target, texture, level, x, y, layer, w, h, pixels);
+			directUploads++;
+			return;
+		}
+		Slot& slot = *acquired;
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+		//the fence guarantees the GPU is done with this slot so no implicit sync is needed
+		void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (dst == NULL) {
+			std::cout << "ERROR::TEXTURE::PBO_MAP_FAILED" << std::endl;
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			texSubImageRGBA8(target, texture, level, x, y, layer, w, h, pixels);
+			directUploads++;
+			return;
+		}
+		memcpy(dst, pixels, size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		texSubImageRGBA8(target, texture, level, x, y, layer, w, h, (void*)0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		asyncUploads++;
+	}
+
+	//round robin over the ring, only blocks when every slot is still in flight. a slot is only
+	//handed out once its fence signalled, NULL when the wait failed
+	Slot* acquireSlot() {
+		Slot& slot = slots[next];
+		next = (next + 1) % slots.size();
+		if (slot.fence) {
+			GLenum result = glClientWaitSync(slot.fence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED) {
+				stalls++;
+				do {
+					result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+				} while (result == GL_TIMEOUT_EXPIRED);
+			}
+			if (result == GL_WAIT_FAILED) {
+				std::cout << "ERROR::TEXTURE::PBO_FENCE_WAIT_FAILED" << std::endl;
+				return NULL;
+			}
+			glDeleteSync(slot.fence);
+			slot.fence = 0;
+		}
+		return &slot;
+	}
+};
+
+
+//where an image ended up inside a TextureArrayAtlas
+struct AtlasRegion {
+	int layer;
+	//normalised texture coordinates of the image inside its layer
+	float u0, v0, u1, v1;
+};
+
+//packs many small RGBA8 images into the layers of one GL_TEXTURE_2D_ARRAY so draws
+//that use different images can share a single binding, images are shelf packed per layer
+class TextureArrayAtlas {
+public:
+	//texture ID
+	unsigned int ID = 0;
+	int layerSize;
+	int maxLayers;
+	int padding;
+	size_t bytes = 0;
+
+	TextureArrayAtlas(int layerSize = 1024, int maxLayers = 8, int padding = 1)
+		: layerSize(layerSize), maxLayers(maxLayers), padding(padding)
+	{
+		glGenTextures(1, &ID);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, ID);
+		if (glTexStorage3D) {
+			glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, layerSize, layerSize, maxLayers);
+		}
+		else {
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, layerSize, layerSize, maxLayers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+		}
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		bytes = textureStorageBytes(layerSize, layerSize, maxLayers, 1, GL_RGBA8);
+		GpuMemory::track(GpuMemory::TEXTURE, ID, bytes, "texture atlas");
+		layers.push_back(Layer());
+	}
+	~TextureArrayAtlas() {
+		GpuMemory::destroy(GpuMemory::TEXTURE, ID);
+	}
+	TextureArrayAtlas(const TextureArrayAtlas&) = delete;
+	TextureArrayAtlas& operator=(const TextureArrayAtlas&) = delete;
+
+	//copies an image into the first layer with room, through uploader's staging ring when one
+	//is given. returns false when the atlas is full
+	bool add(const uint8_t* pixels, int w, int h, AtlasRegion& region, TextureUploader* uploader = NULL) {
+		int paddedW = w + padding * 2;
+		int paddedH = h + padding * 2;
+		if (paddedW > layerSize || paddedH > layerSize) {
+			std::cout << "ERROR::TEXTURE::ATLAS_IMAGE_TOO_LARGE" << std::endl;
+			return false;
+		}
+		for (size_t i = 0; (int)i < maxLayers; i++) {
+			if (i == layers.size()) layers.push_back(Layer());
+			int x, y;
+			if (place(layers[i], paddedW, paddedH, x, y)) {
+				if (uploader != NULL) uploader->uploadLayer(ID, x + padding, y + padding, (int)i, w, h, pixels);
+				else texSubImageRGBA8(GL_TEXTURE_2D_ARRAY, ID, 0, x + padding, y + padding, (int)i, w, h, pixels);
+				region.layer = (int)i;
+				region.u0 = (float)(x + padding) / layerSize;
+				region.v0 = (float)(y + padding) / layerSize;
+				region.u1 = (float)(x + padding + w) / layerSize;
+				region.v1 = (float)(y + padding + h) / layerSize;
+				usedTexels += (size_t)paddedW * paddedH;
+				return true;
+			}
+		}
+		std::cout << "ERROR::TEXTURE::ATLAS_FULL" << std::endl;
+		return false;
+	}
+	void bind(unsigned int unit) const {
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, ID);
+	}
+	//fraction of allocated layer area holding images
+	float occupancy() const {
+		return (float)usedTexels / ((float)layerSize * layerSize * layers.size());
+	}
+
+private:
+	struct Shelf {
+		int y;
+		int height;
+		int cursorX;
+	};
+	struct Layer {
+		std::vector<Shelf> shelves;
+		int nextShelfY = 0;
+	};
+	std::vector<Layer> layers;
+	size_t usedTexels = 0;
+
+	//best fit shelf by height, opens a new shelf when nothing fits
+	bool place(Layer& layer, int w, int h, int& x, int& y) {
+		Shelf* best = NULL;
+		for (Shelf& shelf : layer.shelves) {
+			if (shelf.height >= h && shelf.cursorX + w <= layerSize && (best == NULL || shelf.height < best->height)) {
+				best = &shelf;
+			}
+		}
+		if (best == NULL) {
+			if (layer.nextShelfY + h > layerSize) return false;
+			layer.shelves.push_back({ layer.nextShelfY, h, 0 });
+			layer.nextShelfY += h;
+			best = &layer.shelves.back();
+		}
+		x = best->cursorX;
+		y = best->y;
+		best->cursorX += w;
+		return true;
+	}
+};
+
+//reads one level of an RGBA8 texture back, 2D or 2D array
+inline std::vector<uint8_t> readTextureRGBA8(GLenum target, unsigned int texture, int level, size_t bytes) {
+	std::vector<uint8_t> pixels(bytes);
+	glBindTexture(target, texture);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glGetTexImage(target, level, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glBindTexture(target, 0);
+	return pixels;
+}
+
+//the SSE2 downsample must match the scalar one bit for bit, the CPU mip chain must agree with
+//glGenerateMipmap, and uploads staged through the PBO ring must land where direct ones do
+inline bool selfTestTexture() {
+	bool passed = true;
+	auto check = [&passed](bool condition, const char* what) {
+		if (!condition) {
+			std::cout << "ERROR::TEXTURE::SELFTEST " << what << std::endl;
+			passed = false;
+		}
+	};
+	//deterministic noise, every channel value and rounding case shows up
+	uint32_t seed = 12345;
+	auto noise = [&seed](int w, int h) {
+		std::vector<uint8_t> pixels((size_t)w * h * 4);
+		for (uint8_t& p : pixels) {
+			seed = seed * 1664525u + 1013904223u;
+			p = (uint8_t)(seed >> 24);
+		}
+		return pixels;
+	};
+
+	//odd sizes take the clamped edge, widths under 8 never reach the vector loop
+	const int sizes[][2] = { { 2, 2 }, { 3, 3 }, { 7, 5 }, { 8, 8 }, { 9, 17 }, { 64, 1 }, { 1, 64 }, { 129, 67 }, { 256, 256 } };
+	for (const auto& size : sizes) {
+		int w = size[0], h = size[1];
+		int dw = std::max(1, w / 2), dh = std::max(1, h / 2);
+		std::vector<uint8_t> src = noise(w, h);
+		std::vector<uint8_t> scalar((size_t)dw * dh * 4), vector((size_t)dw * dh * 4);
+		downsampleRGBA8Scalar(src.data(), w, h, scalar.data(), dw, dh);
+		downsampleRGBA8(src.data(), w, h, vector.data(), dw, dh);
+		check(scalar == vector, "sse2 downsample differs from scalar");
+	}
+
+	//a full chain through the staging ring against the driver's own mips. both are box filters
+	//but the driver rounds in its own way, so allow one step per level
+	const int size = 256;
+	std::vector<uint8_t> image = noise(size, size);
+	TextureUploader uploader((size_t)size * size * 4, 3);
+	Texture2D cpu(size, size, 0, GL_RGBA8, "selftest");
+	Texture2D gpu(size, size, 0, GL_RGBA8, "selftest");
+	uploader.uploadWithMips(cpu, image.data(), true);
+	uploader.uploadWithMips(gpu, image.data(), false);
+	check(uploader.asyncUploads == cpu.levels + 1 && uploader.directUploads == 0, "uploads staged");
+	check(readTextureRGBA8(GL_TEXTURE_2D, cpu.ID, 0, image.size()) == image, "level 0 readback");
+	for (int level = 1; level < cpu.levels; level++) {
+		size_t bytes = (size_t)cpu.levelWidth(level) * cpu.levelHeight(level) * 4;
+		std::vector<uint8_t> a = readTextureRGBA8(GL_TEXTURE_2D, cpu.ID, level, bytes);
+		std::vector<uint8_t> b = readTextureRGBA8(GL_TEXTURE_2D, gpu.ID, level, bytes);
+		int worst = 0;
+		for (size_t i = 0; i < bytes; i++) worst = std::max(worst, std::abs((int)a[i] - (int)b[i]));
+		if (worst > level) {
+			std::cout << "ERROR::TEXTURE::SELFTEST level " << level << " differs by " << worst << std::endl;
+			passed = false;
+		}
+	}
+
+	//atlas images through the ring, read back out of the layer they were placed in
+	TextureArrayAtlas atlas(64, 2, 1);
+	std::vector<uint8_t> first = noise(40, 40), second = noise(40, 30);
+	AtlasRegion a, b;
+	check(atlas.add(first.data(), 40, 40, a, &uploader) && atlas.add(second.data(), 40, 30, b, &uploader), "atlas add");
+	check(a.layer == 0 && b.layer == 1, "second image opens a layer");
+	std::vector<uint8_t> layers = readTextureRGBA8(GL_TEXTURE_2D_ARRAY, atlas.ID, 0, (size_t)64 * 64 * 2 * 4);
+	//both sit one padding texel in from the layer's corner
+	bool matches = true;
+	for (int y = 0; y < 40; y++) {
+		matches = matches && memcmp(&layers[((size_t)(y + 1) * 64 + 1) * 4], &first[(size_t)y * 40 * 4], 40 * 4) == 0;
+	}
+	for (int y = 0; y < 30; y++) {
+		matches = matches && memcmp(&layers[((size_t)64 * 64 + (y + 1) * 64 + 1) * 4], &second[(size_t)y * 40 * 4], 40 * 4) == 0;
+	}
+	check(matches, "atlas readback");
+	check(a.u0 == 1.0f / 64 && a.u1 == 41.0f / 64 && b.v1 == 31.0f / 64, "atlas region");
+	check(!atlas.add(first.data(), 64, 64, a, &uploader), "oversized image rejected");
+
+	std::cout << "SELFTEST texture: " << (passed ? "passed" : "FAILED") << std::endl;
+	return passed;
+}
+
+#endif
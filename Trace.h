@@ -0,0 +1,349 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_set>
+#include <fstream>
+#include <iostream>
+
+
+//CPU scopes and GPU passes written as a Chrome trace, open it in chrome://tracing or
+//ui.perfetto.dev. every thread appends to its own fixed size buffer, so recording an event is
+//a clock read and a store with no lock. only one frame in sampleInterval is recorded and
+//the buffers never grow past the memory cap, events that do not fit are counted and dropped,
+//so it can stay on in production. GPU passes are GL_TIMESTAMP query pairs read back a few
+//frames later and moved onto the CPU clock, and show up as KHR_debug groups in GPU debuggers
+namespace Trace {
+
+	struct Event {
+		//interned or a literal, never freed while tracing
+		const char* name;
+		uint64_t nanoseconds;
+		//'B' begin, 'E' end, 'i' instant, 'X' complete (GPU passes, with duration)
+		char phase;
+		uint64_t duration;
+	};
+
+	//written only by its thread, count is published with release so write() on another
+	//thread sees complete events
+	struct ThreadBuffer {
+		std::unique_ptr<Event[]> events;
+		uint32_t capacity = 0;
+		std::atomic<uint32_t> count{ 0 };
+		//begins written whose end is still to come, each holds a slot back for it
+		uint32_t openScopes = 0;
+		uint32_t threadId = 0;
+		std::string threadName;
+	};
+
+	struct GpuPass {
+		const char* name;
+		unsigned int queries[2];
+		bool pending = false;
+	};
+
+	inline std::atomic<bool> enabled{ false };
+	//true while the current frame is one of the sampled ones
+	inline std::atomic<bool> recording{ false };
+	inline std::string outputPath;
+	inline int sampleInterval = 1;
+	inline uint64_t frame = 0;
+	inline size_t maxBytes = 64u << 20;
+	inline uint32_t eventsPerThread = 1u << 16;
+	inline std::atomic<uint64_t> dropped{ 0 };
+	inline std::chrono::steady_clock::time_point origin;
+
+	inline std::mutex registryMutex;
+	inline std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	inline size_t bytesReserved = 0;
+	inline std::unordered_set<std::string> names;
+
+	//GPU passes in flight, a ring that drops new passes while every slot waits on the GPU
+	static const int GPU_PASSES = 256;
+	inline GpuPass gpuPasses[GPU_PASSES];
+	inline int gpuNext = 0;
+	inline bool gpuTiming = false;
+	//GPU timestamp minus CPU nanoseconds since origin, measured once per sampled frame
+	inline int64_t gpuOffset = 0;
+	inline std::vector<Event> gpuEvents;
+	inline size_t maxGpuEvents = 0;
+
+	inline uint64_t now() {
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+	}
+
+	//stable pointer for a name built at runtime, such as a render graph pass name
+	inline const char* intern(const std::string& name) {
+		std::lock_guard<std::mutex> lock(registryMutex);
+		return names.insert(name).first->c_str();
+	}
+
+	//buffers of threads that have exited, culling workers come and go every frame and the next
+	//one carries on in the same buffer
+	inline std::vector<ThreadBuffer*> freeBuffers;
+
+	struct ThreadSlot {
+		ThreadBuffer* buffer = NULL;
+		bool refused = false;
+		~ThreadSlot() {
+			if (buffer == NULL) return;
+			std::lock_guard<std::mutex> lock(registryMutex);
+			freeBuffers.push_back(buffer);
+		}
+	};
+
+	//this thread's buffer, taken on its first event. NULL once the memory cap is reached
+	inline ThreadBuffer* threadBuffer() {
+		thread_local ThreadSlot slot;
+		if (slot.buffer != NULL || slot.refused) return slot.buffer;
+		std::lock_guard<std::mutex> lock(registryMutex);
+		if (!freeBuffers.empty()) {
+			slot.buffer = freeBuffers.back();
+			freeBuffers.pop_back();
+			return slot.buffer;
+		}
+		size_t remaining = (maxBytes - std::min(maxBytes, bytesReserved)) / sizeof(Event);
+		uint32_t capacity = (uint32_t)std::min<size_t>(eventsPerThread, remaining);
+		if (capacity < 64) {
+			slot.refused = true;
+			return NULL;
+		}
+		std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+		created->events.reset(new Event[capacity]);
+		created->capacity = capacity;
+		created->threadId = (uint32_t)buffers.size() + 1;
+		created->threadName = buffers.empty() ? "main" : "worker " + std::to_string(buffers.size());
+		bytesReserved += capacity * sizeof(Event);
+		slot.buffer = created.get();
+		buffers.push_back(std::move(created));
+		return slot.buffer;
+	}
+
+	//returns false when the event was dropped. a begin is only kept when there is room for its
+	//end as well, and every kept begin holds that slot back, so an end always fits and a full
+	//buffer never leaves a 'B' without its 'E'. an end must follow a begin that was kept
+	inline bool record(const char* name, char phase, uint64_t nanoseconds, uint64_t duration = 0) {
+		ThreadBuffer* buffer = threadBuffer();
+		if (buffer == NULL) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		uint32_t count = buffer->count.load(std::memory_order_relaxed);
+		if (phase == 'E') {
+			buffer->openScopes--;
+		}
+		else if (count + buffer->openScopes + (phase == 'B' ? 2 : 1) > buffer->capacity) {
+			dropped.fetch_add(phase == 'B' ? 2 : 1, std::memory_order_relaxed);
+			return false;
+		}
+		else if (phase == 'B') {
+			buffer->openScopes++;
+		}
+		buffer->events[count] = { name, nanoseconds, phase, duration };
+		buffer->count.store(count + 1, std::memory_order_release);
+		return true;
+	}
+
+	//the first thread to record is named main, call this on the main thread before workers start
+	inline void setThreadName(const std::string& name) {
+		ThreadBuffer* buffer = threadBuffer();
+		if (buffer == NULL) return;
+		std::lock_guard<std::mutex> lock(registryMutex);
+		buffer->threadName = name;
+	}
+
+	//a CPU scope, the end is only written when the begin was, so neither a scope that spans the
+	//start or end of a sampled frame nor one that finds its buffer full leaves half a pair
+	struct Scope {
+		const char* name;
+		bool recorded;
+		explicit Scope(const char* name)
+			: name(name), recorded(recording.load(std::memory_order_relaxed) && record(name, 'B', now())) {
+		}
+		~Scope() {
+			if (recorded) record(name, 'E', now());
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	inline void instant(const char* name) {
+		if (recording.load(std::memory_order_relaxed)) record(name, 'i', now());
+	}
+
+	//collects finished GPU passes in issue order, the first one still running stops the scan
+	inline void pollGpu() {
+		for (int i = 0; i < GPU_PASSES; i++) {
+			GpuPass& pass = gpuPasses[(gpuNext + i) % GPU_PASSES];
+			if (!pass.pending) continue;
+			GLint available = 0;
+			glGetQueryObjectiv(pass.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available) return;
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(pass.queries[0], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(pass.queries[1], GL_QUERY_RESULT, &end);
+			pass.pending = false;
+			if (gpuEvents.size() < maxGpuEvents) {
+				gpuEvents.push_back({ pass.name, (uint64_t)((int64_t)begin - gpuOffset), 'X', end - begin });
+			}
+			else {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	//a GPU pass on the thread that owns the context, nested passes are fine
+	struct GpuScope {
+		Scope cpu;
+		GpuPass* pass = NULL;
+		bool group = false;
+		explicit GpuScope(const char* name) : cpu(name) {
+			if (!cpu.recorded) return;
+			if (glPushDebugGroup != NULL) {
+				glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+				group = true;
+			}
+			GpuPass& slot = gpuPasses[gpuNext];
+			if (!gpuTiming || slot.pending) {
+				if (gpuTiming) dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			gpuNext = (gpuNext + 1) % GPU_PASSES;
+			pass = &slot;
+			pass->name = name;
+			glQueryCounter(pass->queries[0], GL_TIMESTAMP);
+		}
+		~GpuScope() {
+			if (pass != NULL) {
+				glQueryCounter(pass->queries[1], GL_TIMESTAMP);
+				pass->pending = true;
+			}
+			if (group) glPopDebugGroup();
+		}
+		GpuScope(const GpuScope&) = delete;
+		GpuScope& operator=(const GpuScope&) = delete;
+	};
+
+	//path is written by finish(). memoryMegabytes caps all buffers together, GPU events included
+	inline void start(const std::string& path, int everyNthFrame = 1, size_t memoryMegabytes = 64) {
+		outputPath = path;
+		sampleInterval = std::max(1, everyNthFrame);
+		maxBytes = memoryMegabytes << 20;
+		//an eighth of the budget is set aside for GPU passes
+		maxGpuEvents = maxBytes / 8 / sizeof(Event);
+		bytesReserved = maxGpuEvents * sizeof(Event);
+		//the rest split between the hardware threads and the main thread
+		size_t threads = std::max(1u, std::thread::hardware_concurrency()) + 1;
+		eventsPerThread = (uint32_t)std::max<size_t>(1024, (maxBytes - bytesReserved) / sizeof(Event) / threads);
+		gpuEvents.clear();
+		origin = std::chrono::steady_clock::now();
+		gpuTiming = glQueryCounter != NULL && glGetInteger64v != NULL;
+		if (gpuTiming) {
+			for (GpuPass& pass : gpuPasses) {
+				glGenQueries(2, pass.queries);
+				pass.pending = false;
+			}
+		}
+		frame = 0;
+		enabled = true;
+		recording = true;
+		setThreadName("main");
+	}
+
+	//once per frame on the GL thread: picks up GPU results and decides whether the next frame
+	//is recorded. GPU and CPU clocks drift, so they are lined up again at every sampled frame
+	inline void endFrame() {
+		if (!enabled) return;
+		if (gpuTiming) pollGpu();
+		frame++;
+		bool sample = frame % sampleInterval == 0;
+		if (sample && gpuTiming) {
+			GLint64 gpuNow = 0;
+			glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+			gpuOffset = gpuNow - (int64_t)now();
+		}
+		recording.store(sample, std::memory_order_relaxed);
+	}
+
+	//a JSON string literal, names come from pass and thread names and may hold anything
+	inline void writeString(std::ofstream& out, const char* text) {
+		out << '"';
+		for (const char* c = text; *c != 0; c++) {
+			unsigned char ch = (unsigned char)*c;
+			if (ch == '"' || ch == '\\') out << '\\' << *c;
+			else if (ch < 0x20) {
+				const char* hex = "0123456789abcdef";
+				out << "\\u00" << hex[ch >> 4] << hex[ch & 15];
+			}
+			else out << *c;
+		}
+		out << '"';
+	}
+
+	inline void writeEvent(std::ofstream& out, bool& first, const Event& e, uint32_t threadId) {
+		out << (first ? "\n" : ",\n") << "{\"name\":";
+		writeString(out, e.name);
+		out << ",\"ph\":\"" << e.phase
+			<< "\",\"ts\":" << e.nanoseconds / 1000.0 << ",\"pid\":1,\"tid\":" << threadId;
+		if (e.phase == 'X') out << ",\"dur\":" << e.duration / 1000.0;
+		if (e.phase == 'i') out << ",\"s\":\"t\"";
+		out << "}";
+		first = false;
+	}
+
+	//stops recording, waits for the GPU passes still in flight and writes the file
+	inline bool finish() {
+		if (!enabled) return true;
+		recording = false;
+		enabled = false;
+		if (gpuTiming) {
+			glFinish();
+			pollGpu();
+			for (GpuPass& pass : gpuPasses) glDeleteQueries(2, pass.queries);
+		}
+
+		std::ofstream out(outputPath);
+		if (!out) {
+			std::cout << "ERROR::TRACE::OPEN_FAILED " << outputPath << std::endl;
+			return false;
+		}
+		out.precision(15);
+		bool first = true;
+		size_t events = gpuEvents.size();
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		std::lock_guard<std::mutex> lock(registryMutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+			out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+				<< ",\"args\":{\"name\":";
+			writeString(out, buffer->threadName.c_str());
+			out << "}}";
+			first = false;
+			uint32_t count = buffer->count.load(std::memory_order_acquire);
+			for (uint32_t i = 0; i < count; i++) writeEvent(out, first, buffer->events[i], buffer->threadId);
+			events += count;
+		}
+		out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+		for (const Event& e : gpuEvents) writeEvent(out, first, e, 0);
+		out << "\n]}\n";
+		std::cout << "TRACE " << events << " events written to " << outputPath << ", " << dropped << " dropped" << std::endl;
+		return (bool)out;
+	}
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+//TRACE_SCOPE("culling") records from here to the end of the enclosing block
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_GPU_SCOPE(name) Trace::GpuScope TRACE_CONCAT(traceGpuScope, __LINE__)(name)
+
+#endif
@@ -0,0 +1,354 @@
+#ifndef VECTOR_MATH_H
+#define VECTOR_MATH_H
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VECTOR_MATH_AVX 1
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VECTOR_MATH_SSE 1
+#endif
+
+
+//small vector/matrix/quaternion library. everything that does not need sqrt or trig is
+//constexpr; Mat4 products and the batch kernels use SSE, and AVX where the compiler targets
+//it (/arch:AVX2, set for Release builds). the choice is made at compile time, there is no
+//runtime dispatch, so a binary built for AVX2 needs a CPU that has it.
+//matrices are column major like GLSL so they upload with glUniformMatrix4fv unchanged
+
+struct Vec3 {
+	float x = 0.0f, y = 0.0f, z = 0.0f;
+
+	constexpr Vec3() = default;
+	constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+	constexpr Vec3 operator+(const Vec3& o) const { return Vec3(x + o.x, y + o.y, z + o.z); }
+	constexpr Vec3 operator-(const Vec3& o) const { return Vec3(x - o.x, y - o.y, z - o.z); }
+	constexpr Vec3 operator-() const { return Vec3(-x, -y, -z); }
+	constexpr Vec3 operator*(float s) const { return Vec3(x * s, y * s, z * s); }
+	constexpr Vec3 operator*(const Vec3& o) const { return Vec3(x * o.x, y * o.y, z * o.z); }
+	constexpr Vec3 operator/(float s) const { return Vec3(x / s, y / s, z / s); }
+	Vec3& operator+=(const Vec3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+	Vec3& operator-=(const Vec3& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+	constexpr bool operator==(const Vec3& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+constexpr float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+constexpr Vec3 cross(const Vec3& a, const Vec3& b) {
+	return Vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+inline float length(const Vec3& v) { return std::sqrt(dot(v, v)); }
+inline Vec3 normalize(const Vec3& v) {
+	float len = length(v);
+	return len > 0.0f ? v / len : v;
+}
+
+struct alignas(16) Vec4 {
+	float x = 0.0f, y = 0.0f, z = 0.0f, w = 0.0f;
+
+	constexpr Vec4() = default;
+	constexpr Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+	constexpr Vec4(const Vec3& v, float w) : x(v.x), y(v.y), z(v.z), w(w) {}
+
+	constexpr Vec4 operator+(const Vec4& o) const { return Vec4(x + o.x, y + o.y, z + o.z, w + o.w); }
+	constexpr Vec4 operator-(const Vec4& o) const { return Vec4(x - o.x, y - o.y, z - o.z, w - o.w); }
+	constexpr Vec4 operator*(float s) const { return Vec4(x * s, y * s, z * s, w * s); }
+	constexpr Vec3 xyz() const { return Vec3(x, y, z); }
+};
+
+constexpr float dot(const Vec4& a, const Vec4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+
+struct Quat {
+	float x = 0.0f, y = 0.0f, z = 0.0f, w = 1.0f;
+
+	constexpr Quat() = default;
+	constexpr Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+	static Quat fromAxisAngle(const Vec3& axis, float radians) {
+		Vec3 n = normalize(axis);
+		float s = std::sin(radians * 0.5f);
+		return Quat(n.x * s, n.y * s, n.z * s, std::cos(radians * 0.5f));
+	}
+
+	//Hamilton product, applies o first then this
+	constexpr Quat operator*(const Quat& o) const {
+		return Quat(
+			w * o.x + x * o.w + y * o.z - z * o.y,
+			w * o.y - x * o.z + y * o.w + z * o.x,
+			w * o.z + x * o.y - y * o.x + z * o.w,
+			w * o.w - x * o.x - y * o.y - z * o.z);
+	}
+	constexpr Quat conjugate() const { return Quat(-x, -y, -z, w); }
+
+	//rotates v, assumes a unit quaternion
+	constexpr Vec3 rotate(const Vec3& v) const {
+		Vec3 q(x, y, z);
+		Vec3 t = cross(q, v) * 2.0f;
+		return v + t * w + cross(q, t);
+	}
+};
+
+inline Quat normalize(const Quat& q) {
+	float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+	return len > 0.0f ? Quat(q.x / len, q.y / len, q.z / len, q.w / len) : Quat();
+}
+
+//normalised linear interpolation along the shortest arc
+inline Quat nlerp(const Quat& a, const Quat& b, float t) {
+	float d = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+	float s = d < 0.0f ? -1.0f : 1.0f;
+	return normalize(Quat(
+		a.x + (b.x * s - a.x) * t, a.y + (b.y * s - a.y) * t,
+		a.z + (b.z * s - a.z) * t, a.w + (b.w * s - a.w) * t));
+}
+
+
+struct alignas(16) Mat4 {
+	//column major, m[column * 4 + row]
+	float m[16] = {};
+
+	static constexpr Mat4 identity() {
+		Mat4 r;
+		r.m[0] = r.m[5] = r.m[10] = r.m[15] = 1.0f;
+		return r;
+	}
+	static constexpr Mat4 translation(const Vec3& t) {
+		Mat4 r = identity();
+		r.m[12] = t.x;
+		r.m[13] = t.y;
+		r.m[14] = t.z;
+		return r;
+	}
+	static constexpr Mat4 scale(const Vec3& s) {
+		Mat4 r;
+		r.m[0] = s.x;
+		r.m[5] = s.y;
+		r.m[10] = s.z;
+		r.m[15] = 1.0f;
+		return r;
+	}
+	static constexpr Mat4 rotation(const Quat& q) {
+		Mat4 r;
+		float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+		float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+		float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+		r.m[0] = 1.0f - 2.0f * (yy + zz); r.m[1] = 2.0f * (xy + wz);        r.m[2] = 2.0f * (xz - wy);
+		r.m[4] = 2.0f * (xy - wz);        r.m[5] = 1.0f - 2.0f * (xx + zz); r.m[6] = 2.0f * (yz + wx);
+		r.m[8] = 2.0f * (xz + wy);        r.m[9] = 2.0f * (yz - wx);        r.m[10] = 1.0f - 2.0f * (xx + yy);
+		r.m[15] = 1.0f;
+		return r;
+	}
+	//translation * rotation * scale in one go, the usual object to world transform
+	static constexpr Mat4 trs(const Vec3& t, const Quat& q, const Vec3& s) {
+		Mat4 r = rotation(q);
+		r.m[0] *= s.x; r.m[1] *= s.x; r.m[2] *= s.x;
+		r.m[4] *= s.y; r.m[5] *= s.y; r.m[6] *= s.y;
+		r.m[8] *= s.z; r.m[9] *= s.z; r.m[10] *= s.z;
+		r.m[12] = t.x; r.m[13] = t.y; r.m[14] = t.z;
+		return r;
+	}
+	//OpenGL style perspective, depth mapped to [-1, 1]
+	static Mat4 perspective(float fovyRadians, float aspect, float zNear, float zFar) {
+		Mat4 r;
+		float f = 1.0f / std::tan(fovyRadians * 0.5f);
+		r.m[0] = f / aspect;
+		r.m[5] = f;
+		r.m[10] = (zFar + zNear) / (zNear - zFar);
+		r.m[11] = -1.0f;
+		r.m[14] = 2.0f * zFar * zNear / (zNear - zFar);
+		return r;
+	}
+	//reversed-Z with an infinite far plane for glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE):
+	//depth is 1 at zNear and falls towards 0 at infinity, which spreads float precision evenly
+	static Mat4 perspectiveReversedZ(float fovyRadians, float aspect, float zNear) {
+		Mat4 r;
+		float f = 1.0f / std::tan(fovyRadians * 0.5f);
+		r.m[0] = f / aspect;
+		r.m[5] = f;
+		r.m[11] = -1.0f;
+		r.m[14] = zNear;
+		return r;
+	}
+	static Mat4 orthographic(float left, float right, float bottom, float top, float zNear, float zFar) {
+		Mat4 r = identity();
+		r.m[0] = 2.0f / (right - left);
+		r.m[5] = 2.0f / (top - bottom);
+		r.m[10] = -2.0f / (zFar - zNear);
+		r.m[12] = -(right + left) / (right - left);
+		r.m[13] = -(top + bottom) / (top - bottom);
+		r.m[14] = -(zFar + zNear) / (zFar - zNear);
+		return r;
+	}
+	static Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) {
+		Vec3 f = normalize(target - eye);
+		Vec3 s = normalize(cross(f, up));
+		Vec3 u = cross(s, f);
+		Mat4 r = identity();
+		r.m[0] = s.x; r.m[4] = s.y; r.m[8] = s.z;
+		r.m[1] = u.x; r.m[5] = u.y; r.m[9] = u.z;
+		r.m[2] = -f.x; r.m[6] = -f.y; r.m[10] = -f.z;
+		r.m[12] = -dot(s, eye);
+		r.m[13] = -dot(u, eye);
+		r.m[14] = dot(f, eye);
+		return r;
+	}
+
+	constexpr Vec4 column(int c) const { return Vec4(m[c * 4], m[c * 4 + 1], m[c * 4 + 2], m[c * 4 + 3]); }
+
+	constexpr Vec4 operator*(const Vec4& v) const {
+		return Vec4(
+			m[0] * v.x + m[4] * v.y + m[8] * v.z + m[12] * v.w,
+			m[1] * v.x + m[5] * v.y + m[9] * v.z + m[13] * v.w,
+			m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14] * v.w,
+			m[3] * v.x + m[7] * v.y + m[11] * v.z + m[15] * v.w);
+	}
+	constexpr Vec3 transformPoint(const Vec3& p) const {
+		return Vec3(
+			m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+			m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+			m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+	}
+
+	Mat4 operator*(const Mat4& o) const;
+
+	constexpr Mat4 transposed() const {
+		Mat4 r;
+		for (int c = 0; c < 4; c++)
+			for (int row = 0; row < 4; row++) r.m[row * 4 + c] = m[c * 4 + row];
+		return r;
+	}
+};
+
+//scalar reference product, usable in constant expressions
+constexpr Mat4 multiplyScalar(const Mat4& a, const Mat4& b) {
+	Mat4 r;
+	for (int c = 0; c < 4; c++) {
+		for (int row = 0; row < 4; row++) {
+			r.m[c * 4 + row] = a.m[row] * b.m[c * 4] + a.m[4 + row] * b.m[c * 4 + 1]
+				+ a.m[8 + row] * b.m[c * 4 + 2] + a.m[12 + row] * b.m[c * 4 + 3];
+		}
+	}
+	return r;
+}
+
+//each result column is a's columns weighted by one column of b
+inline void multiplyInto(const Mat4& a, const Mat4& b, Mat4& r) {
+#ifdef VECTOR_MATH_SSE
+	__m128 a0 = _mm_load_ps(a.m);
+	__m128 a1 = _mm_load_ps(a.m + 4);
+	__m128 a2 = _mm_load_ps(a.m + 8);
+	__m128 a3 = _mm_load_ps(a.m + 12);
+	for (int c = 0; c < 4; c++) {
+		const float* bc = b.m + c * 4;
+		__m128 col = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+		col = _mm_add_ps(col, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+		col = _mm_add_ps(col, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+		col = _mm_add_ps(col, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+		_mm_store_ps(r.m + c * 4, col);
+	}
+#else
+	r = multiplyScalar(a, b);
+#endif
+}
+
+inline Mat4 Mat4::operator*(const Mat4& o) const {
+	Mat4 r;
+	multiplyInto(*this, o, r);
+	return r;
+}
+
+//general inverse by cofactors, returns identity for singular matrices
+inline Mat4 inverse(const Mat4& a) {
+	const float* m = a.m;
+	Mat4 r;
+	float* inv = r.m;
+	inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+	inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+	inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+	inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+	inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+	inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+	inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+	inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+	inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+	inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+	inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+	inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+	inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+	inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+	inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+	inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+	float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+	if (det == 0.0f) return Mat4::identity();
+	float invDet = 1.0f / det;
+	for (int i = 0; i < 16; i++) inv[i] *= invDet;
+	return r;
+}
+
+
+//scalar reference for transformMany
+inline void transformManyScalar(const Mat4& mat, const float* xs, const float* ys, const float* zs,
+	float* outX, float* outY, float* outZ, size_t count) {
+	const float* m = mat.m;
+	for (size_t i = 0; i < count; i++) {
+		float x = xs[i], y = ys[i], z = zs[i];
+		outX[i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+		outY[i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+		outZ[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+	}
+}
+
+//affine transform of count points stored as separate x/y/z arrays, 8 lanes with AVX,
+//4 with SSE, the tail goes through the scalar loop. outputs may alias the inputs
+inline void transformMany(const Mat4& mat, const float* xs, const float* ys, const float* zs,
+	float* outX, float* outY, float* outZ, size_t count) {
+	size_t i = 0;
+	const float* m = mat.m;
+#if defined(VECTOR_MATH_AVX)
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+	__m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+	__m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+	for (; i + 8 <= count; i += 8) {
+		__m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i), z = _mm256_loadu_ps(zs + i);
+		__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m4, y)), _mm256_add_ps(_mm256_mul_ps(m8, z), m12));
+		__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, x), _mm256_mul_ps(m5, y)), _mm256_add_ps(_mm256_mul_ps(m9, z), m13));
+		__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, x), _mm256_mul_ps(m6, y)), _mm256_add_ps(_mm256_mul_ps(m10, z), m14));
+		_mm256_storeu_ps(outX + i, rx);
+		_mm256_storeu_ps(outY + i, ry);
+		_mm256_storeu_ps(outZ + i, rz);
+	}
+#elif defined(VECTOR_MATH_SSE)
+	__m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	__m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+	__m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+	__m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]), m14 = _mm_set1_ps(m[14]);
+	for (; i + 4 <= count; i += 4) {
+		__m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i), z = _mm_loadu_ps(zs + i);
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8, z), m12));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9, z), m13));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_add_ps(_mm_mul_ps(m10, z), m14));
+		_mm_storeu_ps(outX + i, rx);
+		_mm_storeu_ps(outY + i, ry);
+		_mm_storeu_ps(outZ + i, rz);
+	}
+#endif
+	transformManyScalar(mat, xs + i, ys + i, zs + i, outX + i, outY + i, outZ + i, count - i);
+}
+
+//multiplies every matrix in models by viewProjection, the per object MVP build
+inline void multiplyMany(const Mat4& viewProjection, const Mat4* models, Mat4* out, size_t count) {
+	for (size_t i = 0; i < count; i++) multiplyInto(viewProjection, models[i], out[i]);
+}
+
+//compile time checks that the constexpr subset really is usable as such
+static_assert(Mat4::identity().m[15] == 1.0f, "identity must be constexpr");
+static_assert(multiplyScalar(Mat4::translation(Vec3(1, 2, 3)), Mat4::identity()).m[13] == 2.0f, "product must be constexpr");
+static_assert(Quat().rotate(Vec3(1, 0, 0)) == Vec3(1, 0, 0), "quaternion rotate must be constexpr");
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <glad/glad.h>
+
+#include <vector>
+
+
+//layout of one interleaved vertex
+struct VertexFormat {
+	struct Attribute {
+		unsigned int index;
+		int size;
+		GLenum type;
+		bool normalized;
+		unsigned int offset;
+	};
+	std::vector<Attribute> attributes;
+	int stride = 0;
+
+	VertexFormat(int stride = 0) : stride(stride) {}
+
+	VertexFormat& add(unsigned int index, int size, GLenum type, unsigned int offset, bool normalized = false) {
+		attributes.push_back({ index, size, type, normalized, offset });
+		return *this;
+	}
+};
+
+#endif
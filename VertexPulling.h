@@ -0,0 +1,143 @@
+#ifndef VERTEX_PULLING_H
+#define VERTEX_PULLING_H
+
+#include <glad/glad.h>
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "Shader.h"
+
+
+//one vertex as stored in the vertex SSBO, std430 pads vec3 to vec4
+struct PulledVertex {
+	float position[4];
+	float color[4];
+};
+
+//geometry lives in shader storage buffers and Shaders/vertexPulling.vs fetches it by
+//gl_VertexID, so there is no per mesh VAO state and any mix of meshes draws in one call.
+//needs GL 4.3 for shader storage buffers
+class VertexPullingBatch {
+public:
+	struct Mesh {
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+	};
+
+	static bool available() {
+		return GLAD_GL_VERSION_4_3 != 0;
+	}
+
+	VertexPullingBatch() {
+		glGenBuffers(3, buffers);
+		glGenVertexArrays(1, &emptyVAO);
+	}
+	~VertexPullingBatch() {
+		glDeleteBuffers(3, buffers);
+		glDeleteVertexArrays(1, &emptyVAO);
+	}
+	VertexPullingBatch(const VertexPullingBatch&) = delete;
+	VertexPullingBatch& operator=(const VertexPullingBatch&) = delete;
+
+	//adds a triangle list laid out like the app's vertices: 3 floats position, 3 floats color
+	uint32_t addMesh(const float* positionColor, uint32_t vertexCount) {
+		Mesh mesh = { (uint32_t)vertices.size(), vertexCount };
+		for (uint32_t i = 0; i < vertexCount; i++) {
+			const float* v = positionColor + i * 6;
+			PulledVertex pulled = { { v[0], v[1], v[2], 1.0f }, { v[3], v[4], v[5], 1.0f } };
+			vertices.push_back(pulled);
+		}
+		meshes.push_back(mesh);
+		dirty = true;
+		return (uint32_t)meshes.size() - 1;
+	}
+
+	//places one instance of a mesh, every triangle of it is appended to the draw stream
+	uint32_t addObject(uint32_t mesh, float x, float y, float z) {
+		uint32_t object = (uint32_t)(objectOffsets.size() / 4);
+		objectOffsets.insert(objectOffsets.end(), { x, y, z, 0.0f });
+		const Mesh& m = meshes[mesh];
+		for (uint32_t t = 0; t < m.vertexCount / 3; t++) {
+			triangles.push_back(m.firstVertex + t * 3);
+			triangles.push_back(object);
+		}
+		dirty = true;
+		return object;
+	}
+
+	void clearObjects() {
+		objectOffsets.clear();
+		triangles.clear();
+		dirty = true;
+	}
+
+	//draws every object of every mesh with one glDrawArrays
+	void draw(Shader& shader) {
+		if (dirty) upload();
+		shader.use();
+		shader.setBool("instanced", false);
+		bindBuffers();
+		glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(triangles.size() / 2) * 3);
+	}
+
+	//draws one mesh once per object with gl_InstanceID picking the object
+	void drawInstanced(Shader& shader, uint32_t mesh, int instances) {
+		if (dirty) upload();
+		shader.use();
+		shader.setBool("instanced", true);
+		shader.setInt("firstVertex", (int)meshes[mesh].firstVertex);
+		bindBuffers();
+		glDrawArraysInstanced(GL_TRIANGLES, 0, meshes[mesh].vertexCount, instances);
+	}
+
+	size_t objectCount() const { return objectOffsets.size() / 4; }
+	size_t triangleCount() const { return triangles.size() / 2; }
+
+private:
+	enum { VERTEX_SSBO, OBJECT_SSBO, TRIANGLE_SSBO };
+	unsigned int buffers[3];
+	//core profile refuses to draw without a VAO bound, even when it has no attributes
+	unsigned int emptyVAO;
+	std::vector<PulledVertex> vertices;
+	std::vector<Mesh> meshes;
+	std::vector<float> objectOffsets;
+	std::vector<uint32_t> triangles;
+	bool dirty = true;
+
+	void upload() {
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[VERTEX_SSBO]);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, vertices.size() * sizeof(PulledVertex), vertices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[OBJECT_SSBO]);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, objectOffsets.size() * sizeof(float), objectOffsets.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[TRIANGLE_SSBO]);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, triangles.size() * sizeof(uint32_t), triangles.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		dirty = false;
+	}
+	void bindBuffers() {
+		glBindVertexArray(emptyVAO);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffers[VERTEX_SSBO]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, buffers[OBJECT_SSBO]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, buffers[TRIANGLE_SSBO]);
+	}
+};
+
+
+//small random triangle list of 1 to 4 triangles, 6 floats per vertex
+inline std::vector<float> makeRandomMesh() {
+	std::vector<float> mesh;
+	int triangleCount = 1 + rand() % 4;
+	for (int i = 0; i < triangleCount * 3; i++) {
+		float v[6] = {
+			(rand() % 100) / 2000.0f, (rand() % 100) / 2000.0f, 0.0f,
+			(rand() % 100) / 100.0f, (rand() % 100) / 100.0f, (rand() % 100) / 100.0f
+		};
+		mesh.insert(mesh.end(), v, v + 6);
+	}
+	return mesh;
+}
+
+#endif